@@ -0,0 +1,496 @@
+/**
+ * @file bench_main.cpp
+ *
+ * Contains the entry point of the microbenchmark suite, which times the procedural generation,
+ * simulation and asset loading kernels in isolation. The suite only links the space_cowboy_core
+ * library, so none of the benchmarks need an OpenGL context. Must be run from the project root so
+ * that the shipped assets are found.
+ */
+#include "harness.hpp"
+
+#include "core/asset_cook.hpp"
+#include "core/body.hpp"
+#include "core/camera.hpp"
+#include "core/image.hpp"
+#include "core/mesh_lod.hpp"
+#include "core/noise.hpp"
+#include "core/objloader.hpp"
+#include "core/occlusion_buffer.hpp"
+#include "core/radix_sort.hpp"
+#include "core/sphere.hpp"
+#include "core/utility.hpp"
+#include "core/vertex_format.hpp"
+#include "core/world.hpp"
+#include "core/world_random.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+/** Seed used by every benchmark so that runs generate the same data. */
+constexpr std::uint32_t SEED = 12345;
+
+/** Sphere resolutions (lines of latitude and longitude), powers of two plus one as diamond-square
+ *  requires. */
+constexpr unsigned int SPHERE_RESOLUTIONS[] = { 33, 65, 129, 257 };
+/** Terrain smoothness used by the planets. */
+constexpr float        TERRAIN_SMOOTHNESS   = 1.1f;
+
+/** Number of random floats drawn per generator run. */
+constexpr std::size_t N_RANDOM_VALUES = 1 << 16;
+
+/** Turbulence size used by the planet and moon textures. */
+constexpr double TURBULENCE_SIZE = 32.0;
+
+/** Number of bodies advanced per orbit update. */
+constexpr unsigned int N_ORBITING_BODIES = 1000;
+/** Time step of an orbit update in seconds. */
+constexpr float        ORBIT_TIME_STEP   = 1.0f / 60.0f;
+
+/** Numbers of draw items sorted per frame. */
+constexpr std::size_t N_SORT_ENTRIES[] = { 100, 1000, 10000, 100000 };
+/** Number of distinct values of the high key bits (pass, program and texture) of the draw items. */
+constexpr std::uint64_t N_STATE_KEYS   = 8;
+
+/** Numbers of asteroids in the stress scenes culled on the CPU. */
+constexpr std::size_t N_ASTEROIDS[] = { 1000, 10000, 100000 };
+
+/** Models loaded by the game. */
+constexpr const char *MODELS[] = { "assets/dark_fighter_6/dark_fighter_6.obj",
+                                   "assets/Deadpool/DeadPool.obj" };
+/** Text files read by the game: a shader and the largest model. */
+constexpr const char *FILES[]  = { "shaders/planet_vertex.shader",
+                                   "assets/Deadpool/DeadPool.obj" };
+
+/** Width and height of the texture cooked, as large as the game's largest textures. */
+constexpr std::uint32_t TEXTURE_SIZE = 1024;
+
+/**
+ * Returns a resolution as a parameter string.
+ */
+std::string resolution(unsigned int n) {
+	return std::to_string(n) + "x" + std::to_string(n);
+}
+
+/**
+ * Times both Sphere constructors and the diamond-square height map generation.
+ */
+void benchSpheres(bench::Runner& runner) {
+	for (unsigned int n : SPHERE_RESOLUTIONS) {
+		runner.run("Sphere::Sphere", resolution(n), [n] {
+			Sphere sphere(1.0f, n, n);
+			bench::doNotOptimize(sphere.vertices.data());
+		});
+	}
+
+	for (unsigned int n : SPHERE_RESOLUTIONS) {
+		worldRandom::setSeed(SEED);
+		runner.run("Sphere::Sphere (terrain)", resolution(n), [n] {
+			Sphere sphere(1.0f, n, n, TERRAIN_SMOOTHNESS, true);
+			bench::doNotOptimize(sphere.vertices.data());
+		});
+	}
+
+	// diamondSquare is a member function but only uses the height map it is given.
+	Sphere sphere(1.0f, 3, 4);
+	for (unsigned int n : SPHERE_RESOLUTIONS) {
+		worldRandom::setSeed(SEED);
+		std::vector<std::vector<float>> heightMap(n, std::vector<float>(n));
+		runner.run("Sphere::diamondSquare", resolution(n), [&] {
+			sphere.diamondSquare(heightMap, 0, 0, static_cast<int>(n / 2), 0, TERRAIN_SMOOTHNESS);
+			bench::doNotOptimize(heightMap[n / 2][n / 2]);
+		});
+	}
+}
+
+/**
+ * Times drawing random floats in [0, 1) from the world generator, in bulk and one at a time, and
+ * from the std::mt19937 it replaced.
+ */
+void benchRandom(bench::Runner& runner) {
+	std::vector<float> values(N_RANDOM_VALUES);
+	std::string count = std::to_string(N_RANDOM_VALUES) + " floats";
+
+	worldRandom::Generator generator(SEED);
+	runner.run("Generator::fill", count, [&] {
+		generator.fill(values.data(), values.size());
+		bench::doNotOptimize(values.data());
+	});
+	runner.run("Generator::uniform", count, [&] {
+		for (float& value : values) {
+			value = generator.uniform();
+		}
+		bench::doNotOptimize(values.data());
+	});
+
+	std::mt19937 engine(SEED);
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+	runner.run("std::mt19937", count, [&] {
+		for (float& value : values) {
+			value = distribution(engine);
+		}
+		bench::doNotOptimize(values.data());
+	});
+}
+
+/**
+ * Times the noise functions used to colour the planets and moons.
+ */
+void benchNoise(bench::Runner& runner) {
+	worldRandom::setSeed(SEED);
+	runner.run("generateNoiseMatrix", resolution(NOISE_SIZE), [] {
+		std::vector<std::vector<float>> noise = generateNoiseMatrix();
+		bench::doNotOptimize(noise[0][0]);
+	});
+
+	const std::vector<std::vector<float>> noise = generateNoiseMatrix();
+
+	runner.run("smoothNoise", resolution(NOISE_SIZE) + " samples", [&noise] {
+		float sum = 0.0f;
+		for (int i = 0; i < NOISE_SIZE; ++i) {
+			for (int j = 0; j < NOISE_SIZE; ++j) {
+				sum += smoothNoise(i / 3.7f, j / 3.7f, noise);
+			}
+		}
+		bench::doNotOptimize(sum);
+	});
+
+	runner.run("turbulence", resolution(NOISE_SIZE) + " samples, size 32", [&noise] {
+		double sum = 0.0;
+		for (int i = 0; i < NOISE_SIZE; ++i) {
+			for (int j = 0; j < NOISE_SIZE; ++j) {
+				sum += turbulence(i, j, TURBULENCE_SIZE, noise);
+			}
+		}
+		bench::doNotOptimize(sum);
+	});
+}
+
+/**
+ * Times the loading of the shipped models and text files.
+ */
+void benchLoading(bench::Runner& runner) {
+	for (const char *model : MODELS) {
+		runner.run("loadOBJ", model, [model] {
+			std::vector<glm::vec3> vertices;
+			std::vector<glm::vec3> normals;
+			std::vector<glm::vec2> uvs;
+			if (not loadOBJ(model, vertices, normals, uvs)) {
+				throw std::runtime_error(std::string("Could not load ") + model + ".");
+			}
+			bench::doNotOptimize(vertices.data());
+		});
+	}
+
+	// Map each file and read it through once, counting its lines.
+	for (const char *file : FILES) {
+		runner.run("utility::MappedFile", file, [file] {
+			utility::MappedFile mappedFile(file);
+			bench::doNotOptimize(std::count(mappedFile.begin(), mappedFile.end(), '\n'));
+		});
+	}
+}
+
+/**
+ * Times the per-frame orbit update of many bodies.
+ */
+void benchOrbits(bench::Runner& runner) {
+	// Bodies spread over a disc, spinning and orbiting like the generated planets.
+	std::vector<glm::mat4> rotations(N_ORBITING_BODIES);
+	std::vector<glm::mat4> translations(N_ORBITING_BODIES);
+	std::vector<glm::vec3> angularVelocities(N_ORBITING_BODIES);
+	std::vector<glm::vec3> orbitalAngularVelocities(N_ORBITING_BODIES);
+	for (unsigned int i = 0; i < N_ORBITING_BODIES; ++i) {
+		float distance = 2000.0f + 10.0f * i;
+		translations[i]             = glm::translate(glm::mat4(), glm::vec3(distance, 0.0f, 0.0f));
+		angularVelocities[i]        = glm::vec3(0.0f, 0.5f, 0.0f);
+		orbitalAngularVelocities[i] = glm::vec3(0.0f, 100.0f / distance, 0.0f);
+	}
+
+	runner.run("advanceOrbit", std::to_string(N_ORBITING_BODIES) + " bodies", [&] {
+		for (unsigned int i = 0; i < N_ORBITING_BODIES; ++i) {
+			advanceOrbit(rotations[i], translations[i], angularVelocities[i],
+			             orbitalAngularVelocities[i], ORBIT_TIME_STEP);
+		}
+		bench::doNotOptimize(translations[0]);
+	});
+}
+
+/**
+ * Times the radix sort of render queue keys against std::sort. The keys mimic the render queue's:
+ * a few distinct high bits for the pass, program and texture, and a 24-bit depth in the low bits.
+ */
+void benchSort(bench::Runner& runner) {
+	std::mt19937_64 generator(SEED);
+	for (std::size_t n : N_SORT_ENTRIES) {
+		std::vector<SortEntry> entries(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			std::uint64_t state = generator() % N_STATE_KEYS;
+			entries[i] = { (state << 34) | (generator() & 0xFFFFFF), static_cast<std::uint32_t>(i) };
+		}
+
+		std::vector<SortEntry> sorted;
+		std::vector<SortEntry> scratch;
+		runner.run("radixSort", std::to_string(n) + " keys", [&] {
+			sorted = entries;
+			radixSort(sorted, scratch);
+			bench::doNotOptimize(sorted.data());
+		});
+
+		runner.run("std::sort", std::to_string(n) + " keys", [&] {
+			sorted = entries;
+			std::sort(sorted.begin(), sorted.end(), [](const SortEntry& a, const SortEntry& b) {
+				return a.key < b.key;
+			});
+			bench::doNotOptimize(sorted.data());
+		});
+	}
+}
+
+/**
+ * Times the generation of a whole world and the per-frame world update and collision test.
+ */
+void benchWorld(bench::Runner& runner) {
+	runner.run("generateWorld", "seed " + std::to_string(SEED), [] {
+		worldRandom::setSeed(SEED);
+		World world = generateWorld();
+		bench::doNotOptimize(world.planets.data());
+	});
+
+	worldRandom::setSeed(SEED);
+	World world = generateWorld();
+	std::string bodies = std::to_string(world.planets.size()) + " planets, " +
+	                     std::to_string(world.moons.size()) + " moons";
+
+	runner.run("updateWorld", bodies, [&world] {
+		updateWorld(world, ORBIT_TIME_STEP);
+		bench::doNotOptimize(world.moons.data());
+	});
+
+	runner.run("worldCollision", bodies, [&world] {
+		glm::vec3 bounce;
+		bool      hit = worldCollision(world, glm::vec3(0.0f, 0.0f, 1300.0f),
+		                               glm::vec3(0.0f, 0.0f, -1.0f), bounce);
+		bench::doNotOptimize(hit);
+	});
+}
+
+/**
+ * Times packing a planet mesh and the models loaded by the game into the compact vertex layout.
+ */
+void benchVertexFormats(bench::Runner& runner) {
+	worldRandom::setSeed(SEED);
+	World           world     = generateWorld();
+	const BodyMesh& mesh      = world.planetMeshes.front();
+	std::string     nVertices = std::to_string(mesh.vertices.size() / 6) + " vertices";
+	runner.run("vertexFormat::packBodyMesh", nVertices, [&mesh] {
+		vertexFormat::PackedBodyMesh packed = vertexFormat::packBodyMesh(mesh);
+		bench::doNotOptimize(packed.vertices.data());
+	});
+
+	for (const char *model : MODELS) {
+		std::vector<glm::vec3> vertices;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> uvs;
+		if (not loadOBJ(model, vertices, normals, uvs)) {
+			throw std::runtime_error(std::string("Could not load ") + model + ".");
+		}
+		runner.run("vertexFormat::packModel", model, [&vertices, &normals, &uvs] {
+			vertexFormat::PackedModel packed = vertexFormat::packModel(vertices, normals, uvs);
+			bench::doNotOptimize(packed.vertices.data());
+		});
+	}
+}
+
+/**
+ * Times generating the levels of detail of the spaceship and spacecowboy models, welding included.
+ */
+void benchLods(bench::Runner& runner) {
+	for (const char *model : MODELS) {
+		std::vector<glm::vec3> vertices;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> uvs;
+		if (not loadOBJ(model, vertices, normals, uvs)) {
+			throw std::runtime_error(std::string("Could not load ") + model + ".");
+		}
+		runner.run("generateLods", model, [&vertices, &normals, &uvs] {
+			LodMesh lods = generateLods(vertices, normals, uvs, 4);
+			bench::doNotOptimize(lods.levels.data());
+		});
+	}
+}
+
+/**
+ * Times the asset cooker's kernels: cooking each model, reading the cooked model in place and
+ * validating it as the game does when it loads the asset pack, and mipmapping and compressing a
+ * texture to BC1.
+ */
+void benchCooking(bench::Runner& runner) {
+	for (const char *model : MODELS) {
+		std::vector<glm::vec3> vertices;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> uvs;
+		if (not loadOBJ(model, vertices, normals, uvs)) {
+			throw std::runtime_error(std::string("Could not load ") + model + ".");
+		}
+		runner.run("cookModel", model, [&vertices, &normals, &uvs] {
+			assetCook::CookedModel cooked = assetCook::cookModel(vertices, normals, uvs,
+			                                                     assetCook::MODEL_LEVELS);
+			bench::doNotOptimize(cooked.indices.data());
+		});
+
+		std::vector<std::uint8_t> payload = assetCook::serialize(
+				assetCook::cookModel(vertices, normals, uvs, assetCook::MODEL_LEVELS));
+		runner.run("viewModel", model, [&payload] {
+			assetCook::ModelView view = assetCook::viewModel(payload.data(), payload.size());
+			bench::doNotOptimize(view.indices.data);
+		});
+	}
+
+	// Fill a texture with smooth gradients and noise, as in a photograph.
+	std::mt19937 engine(SEED);
+	image::Image texture;
+	texture.width    = TEXTURE_SIZE;
+	texture.height   = TEXTURE_SIZE;
+	texture.channels = 3;
+	for (std::uint32_t y = 0; y < TEXTURE_SIZE; ++y) {
+		for (std::uint32_t x = 0; x < TEXTURE_SIZE; ++x) {
+			texture.pixels.push_back(static_cast<std::uint8_t>(x / 4 + engine() % 16));
+			texture.pixels.push_back(static_cast<std::uint8_t>(y / 4 + engine() % 16));
+			texture.pixels.push_back(static_cast<std::uint8_t>((x + y) / 8 + engine() % 16));
+		}
+	}
+	std::string size = std::to_string(TEXTURE_SIZE) + "x" + std::to_string(TEXTURE_SIZE);
+	runner.run("cookTexture", size + " RGB8", [&texture] {
+		assetCook::CookedTexture cooked = assetCook::cookTexture(texture, false);
+		bench::doNotOptimize(cooked.levels.data());
+	});
+	runner.run("cookTexture", size + " BC1", [&texture] {
+		assetCook::CookedTexture cooked = assetCook::cookTexture(texture, true);
+		bench::doNotOptimize(cooked.levels.data());
+	});
+}
+
+/**
+ * Times the CPU culling of asteroid belts as seen from the game's initial camera: frustum culling,
+ * the fallback of GPU culling, and testing against the software occlusion buffer after rasterizing
+ * the sun, planets and moons into it.
+ */
+void benchCulling(bench::Runner& runner) {
+	Camera camera(1.2f, 1.6f, 0.1f, 1000000.0f, glm::vec3(0.0f, 0.0f, 1300.0f),
+	              glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const CameraBlock& block = camera.block();
+
+	for (std::size_t n : N_ASTEROIDS) {
+		worldRandom::setSeed(SEED);
+		World world = generateWorld();
+		generateAsteroids(world, n);
+
+		runner.run("frustumCull", std::to_string(n) + " asteroids", [&] {
+			std::size_t nVisible = 0;
+			for (const Body& asteroid : world.asteroids) {
+				nVisible += block.sphereVisible(asteroid.position(), asteroid.size());
+			}
+			bench::doNotOptimize(nVisible);
+		});
+
+		OcclusionBuffer occlusionBuffer;
+		runner.run("occlusionCull", std::to_string(n) + " asteroids", [&] {
+			occlusionBuffer.clear(block);
+			occlusionBuffer.addOccluder(world.sun.position(), world.sun.size());
+			for (const Body& planet : world.planets) {
+				occlusionBuffer.addOccluder(planet.position(), MIN_TERRAIN_RADIUS * planet.size());
+			}
+			for (const Body& moon : world.moons) {
+				occlusionBuffer.addOccluder(moon.position(), MIN_TERRAIN_RADIUS * moon.size());
+			}
+			occlusionBuffer.buildHierarchy();
+
+			std::size_t nVisible = 0;
+			for (const Body& asteroid : world.asteroids) {
+				nVisible += occlusionBuffer.sphereVisible(asteroid.position(),
+				                                          MAX_TERRAIN_RADIUS * asteroid.size());
+			}
+			bench::doNotOptimize(nVisible);
+		});
+
+		runner.run("updateWorld", std::to_string(n) + " asteroids", [&world] {
+			updateWorld(world, ORBIT_TIME_STEP);
+			bench::doNotOptimize(world.asteroids.data());
+		});
+	}
+}
+}
+
+/**
+ * Entry point of the microbenchmark suite. Prints progress to stderr and the results as JSON to
+ * stdout or to a file.
+ *
+ * Supported command line options:
+ *   --filter S           Only run benchmarks whose name contains S.
+ *   --min-time T         Time each benchmark for at least T seconds (default 0.5).
+ *   --min-iterations N   Time at least N iterations of each benchmark (default 5).
+ *   --output F           Write the JSON results to F instead of stdout.
+ */
+int main(int argc, char *argv[]) {
+	std::string  filter;
+	double       minSeconds    = 0.5;
+	unsigned int minIterations = 5;
+	std::string  outputPath;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--filter") == 0 and i + 1 < argc) {
+			filter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--min-time") == 0 and i + 1 < argc) {
+			minSeconds = std::strtod(argv[++i], nullptr);
+		}
+		else if (std::strcmp(argv[i], "--min-iterations") == 0 and i + 1 < argc) {
+			minIterations = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--output") == 0 and i + 1 < argc) {
+			outputPath = argv[++i];
+		}
+		else {
+			std::cerr << "Warning: Ignoring unknown option " << argv[i] << "." << std::endl;
+		}
+	}
+
+	try {
+		bench::Runner runner(filter, minSeconds, minIterations);
+		benchSpheres(runner);
+		benchRandom(runner);
+		benchNoise(runner);
+		benchLoading(runner);
+		benchOrbits(runner);
+		benchSort(runner);
+		benchWorld(runner);
+		benchVertexFormats(runner);
+		benchLods(runner);
+		benchCooking(runner);
+		benchCulling(runner);
+
+		if (outputPath.empty()) {
+			runner.writeJson(std::cout);
+		}
+		else {
+			std::ofstream out(outputPath);
+			if (not out) {
+				throw std::runtime_error("Could not write " + outputPath + ".");
+			}
+			runner.writeJson(out);
+		}
+	}
+	catch (const std::exception& e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+}
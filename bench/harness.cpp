@@ -0,0 +1,60 @@
+/**
+ * @file harness.cpp
+ *
+ * Implementation file for the microbenchmark harness.
+ */
+#include "harness.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+namespace bench {
+// Constructors.
+Runner::Runner(const std::string& filter, double minSeconds, unsigned int minIterations) :
+		mFilter(filter),
+		mMinNs(minSeconds * 1e9),
+		mMinIterations(std::max(minIterations, 1u)) { }
+
+// Accessor functions.
+const std::vector<Result>& Runner::results() const {
+	return mResults;
+}
+
+void Runner::writeJson(std::ostream& out) const {
+	out << std::fixed << std::setprecision(1);
+	out << "{\n\"benchmarks\": [\n";
+	for (std::size_t i = 0; i < mResults.size(); ++i) {
+		const Result& result = mResults[i];
+		out << "{ \"name\": \"" << result.name << "\", \"parameters\": \"" << result.parameters
+		    << "\", \"iterations\": " << result.iterations << ", \"minNs\": " << result.minNs
+		    << ", \"medianNs\": " << result.medianNs << ", \"meanNs\": " << result.meanNs
+		    << (i + 1 < mResults.size() ? " },\n" : " }\n");
+	}
+	out << "]\n}\n";
+}
+
+// Helper functions.
+bool Runner::selected(const std::string& name) const {
+	return mFilter.empty() or name.find(mFilter) != std::string::npos;
+}
+
+void Runner::addResult(const std::string& name, const std::string& parameters,
+                       std::vector<double>& samplesNs) {
+	std::sort(samplesNs.begin(), samplesNs.end());
+
+	Result result;
+	result.name       = name;
+	result.parameters = parameters;
+	result.iterations = samplesNs.size();
+	result.minNs      = samplesNs.front();
+	result.medianNs   = samplesNs[samplesNs.size() / 2];
+	result.meanNs     = std::accumulate(samplesNs.begin(), samplesNs.end(), 0.0) / samplesNs.size();
+	mResults.push_back(result);
+
+	std::cerr << std::left << std::setw(28) << name << std::setw(44) << parameters << std::right
+	          << std::fixed << std::setprecision(3) << std::setw(14) << result.medianNs / 1e6
+	          << " ms median (" << result.iterations << " iterations)" << std::endl;
+}
+}
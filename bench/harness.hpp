@@ -0,0 +1,139 @@
+/**
+ * @file harness.hpp
+ *
+ * Interface file for the microbenchmark harness, in the "bench" namespace.
+ */
+#ifndef SPACE_COWBOY_BENCH_HARNESS_HPP
+#define SPACE_COWBOY_BENCH_HARNESS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+/**
+ * Prevents the compiler from optimizing away the computation of a value.
+ *
+ * @param value Value that must be computed.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	volatile const void *sink = &value;
+	(void) sink;
+#endif
+}
+
+/** Timing of one benchmark. */
+struct Result {
+	/** Name of the benchmarked kernel. */
+	std::string   name;
+	/** Parameters of the run, e.g. the resolution. */
+	std::string   parameters;
+	/** Number of timed iterations. */
+	std::uint64_t iterations;
+	/** Fastest iteration in nanoseconds. */
+	double        minNs;
+	/** Median iteration in nanoseconds. */
+	double        medianNs;
+	/** Mean iteration in nanoseconds. */
+	double        meanNs;
+};
+
+/**
+ * Runs benchmarks and collects their results. Each benchmark body is run once to warm up and then
+ * repeatedly until both a minimum number of iterations and a minimum total time are reached.
+ */
+class Runner {
+public:
+	// Constructors.
+	/**
+	 * Creates a runner.
+	 *
+	 * @param filter Only benchmarks whose name contains this string are run. Empty runs all.
+	 * @param minSeconds Minimum total time spent timing each benchmark.
+	 * @param minIterations Minimum number of timed iterations of each benchmark.
+	 */
+	Runner(const std::string& filter, double minSeconds, unsigned int minIterations);
+
+	// Accessor functions.
+	/**
+	 * Returns the results of the benchmarks run so far.
+	 */
+	const std::vector<Result>& results() const;
+
+	/**
+	 * Writes the results as a JSON document.
+	 *
+	 * @param out Output stream.
+	 */
+	void writeJson(std::ostream& out) const;
+
+	// Mutator functions.
+	/**
+	 * Times a benchmark body, unless it is excluded by the filter. Prints a line to stderr once done.
+	 *
+	 * @param name Name of the benchmarked kernel.
+	 * @param parameters Parameters of the run.
+	 * @param body Function to time. Called without arguments.
+	 */
+	template <typename Body>
+	void run(const std::string& name, const std::string& parameters, Body body);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	// Data members.
+	/** Benchmark name filter. */
+	std::string         mFilter;
+	/** Minimum total time per benchmark in nanoseconds. */
+	double              mMinNs;
+	/** Minimum number of iterations per benchmark. */
+	unsigned int        mMinIterations;
+	/** Results so far. */
+	std::vector<Result> mResults;
+
+	// Helper functions.
+	/**
+	 * Returns true iff the named benchmark should be run.
+	 */
+	bool selected(const std::string& name) const;
+
+	/**
+	 * Summarizes the iteration times of a benchmark, stores the result and reports it.
+	 */
+	void addResult(const std::string& name, const std::string& parameters,
+	               std::vector<double>& samplesNs);
+};
+
+// Template implementations.
+template <typename Body>
+void Runner::run(const std::string& name, const std::string& parameters, Body body) {
+	if (not selected(name)) {
+		return;
+	}
+
+	// Warm up caches and the allocator.
+	body();
+
+	std::vector<double> samplesNs;
+	double              totalNs = 0.0;
+	while (samplesNs.size() < mMinIterations or totalNs < mMinNs) {
+		Clock::time_point start = Clock::now();
+		body();
+		Clock::time_point end = Clock::now();
+
+		double ns = std::chrono::duration<double, std::nano>(end - start).count();
+		samplesNs.push_back(ns);
+		totalNs += ns;
+	}
+
+	addResult(name, parameters, samplesNs);
+}
+}
+
+#endif
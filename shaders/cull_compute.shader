@@ -0,0 +1,123 @@
+#version 430 core
+
+// Tests one body per invocation against the viewing frustum and the depth pyramid of the previous
+// frame, and writes an indirect draw command and model matrix for each body that survives.
+layout (local_size_x = 64) in;
+
+struct Body {
+	mat4  model;
+	// Centre and radius of the bounding sphere.
+	vec4  sphere;
+	// Index of the body's mesh in x.
+	uvec4 mesh;
+};
+
+struct DrawCommand {
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int  baseVertex;
+	uint baseInstance;
+};
+
+layout (std430, binding = 0) readonly buffer Bodies {
+	Body bodies[];
+};
+layout (std430, binding = 1) readonly buffer Meshes {
+	DrawCommand meshes[];
+};
+layout (std430, binding = 2) writeonly buffer Commands {
+	DrawCommand commands[];
+};
+layout (std430, binding = 3) writeonly buffer Models {
+	mat4 models[];
+};
+layout (std430, binding = 4) buffer DrawCount {
+	uint drawCount;
+};
+
+uniform uint      nBodies;
+// Frustum planes as (normal, distance), normals pointing inwards.
+uniform vec4      frustumPlanes[6];
+// Whether surviving commands are packed at the front of the buffer and counted in drawCount, or
+// written at their body's index with culled commands drawing no instances.
+uniform bool      compact;
+
+uniform bool      occlusion;
+uniform mat4      previousViewProjection;
+uniform sampler2D depthPyramid;
+uniform int       pyramidLevels;
+uniform ivec2     pyramidSize;
+
+bool insideFrustum(vec3 centre, float radius) {
+	for (int i = 0; i < 6; ++i) {
+		if (dot(frustumPlanes[i].xyz, centre) + frustumPlanes[i].w < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool occluded(vec3 centre, float radius) {
+	// Bound the sphere's box on the screen of the previous frame. Give up if any corner is behind
+	// the camera.
+	vec3 minimum = vec3(1.0);
+	vec3 maximum = vec3(-1.0);
+	for (int i = 0; i < 8; ++i) {
+		vec3 corner  = centre + radius * vec3((i & 1) != 0 ? 1.0 : -1.0,
+		                                      (i & 2) != 0 ? 1.0 : -1.0,
+		                                      (i & 4) != 0 ? 1.0 : -1.0);
+		vec4 clipped = previousViewProjection * vec4(corner, 1.0);
+		if (clipped.w <= 0.0) {
+			return false;
+		}
+		vec3 ndc = clipped.xyz / clipped.w;
+		minimum  = min(minimum, ndc);
+		maximum  = max(maximum, ndc);
+	}
+	vec2 uvMinimum = clamp(minimum.xy * 0.5 + 0.5, 0.0, 1.0);
+	vec2 uvMaximum = clamp(maximum.xy * 0.5 + 0.5, 0.0, 1.0);
+
+	// Pick the level at which the box spans at most two texels in each direction, and compare the
+	// box's nearest depth with the farthest depth of those texels.
+	vec2  extent = (uvMaximum - uvMinimum) * vec2(pyramidSize);
+	int   level  = clamp(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), 0,
+	                     pyramidLevels - 1);
+	ivec2 levelSize = max(pyramidSize >> level, ivec2(1));
+	ivec2 first     = min(ivec2(uvMinimum * vec2(levelSize)), levelSize - 1);
+	ivec2 last      = min(ivec2(uvMaximum * vec2(levelSize)), levelSize - 1);
+
+	float farthest = max(max(texelFetch(depthPyramid, first, level).r,
+	                         texelFetch(depthPyramid, ivec2(last.x, first.y), level).r),
+	                     max(texelFetch(depthPyramid, ivec2(first.x, last.y), level).r,
+	                         texelFetch(depthPyramid, last, level).r));
+	return minimum.z * 0.5 + 0.5 > farthest;
+}
+
+void main() {
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= nBodies) {
+		return;
+	}
+
+	Body  body    = bodies[index];
+	vec3  centre  = body.sphere.xyz;
+	float radius  = body.sphere.w;
+	bool  visible = insideFrustum(centre, radius) && !(occlusion && occluded(centre, radius));
+
+	uint slot = index;
+	if (compact) {
+		if (!visible) {
+			return;
+		}
+		slot = atomicAdd(drawCount, 1u);
+	}
+
+	DrawCommand command = meshes[body.mesh.x];
+	command.instanceCount = visible ? 1u : 0u;
+	command.baseInstance  = slot;
+	commands[slot] = command;
+	if (visible) {
+		models[slot] = body.model;
+	}
+}
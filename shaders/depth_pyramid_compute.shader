@@ -0,0 +1,33 @@
+#version 430 core
+
+// Reduces one level of the depth pyramid into the next, keeping the farthest depth of the source
+// texels each destination texel covers.
+layout (local_size_x = 8, local_size_y = 8) in;
+
+layout (r32f, binding = 0) uniform writeonly image2D destination;
+
+uniform sampler2D source;
+uniform int       sourceLevel;
+uniform ivec2     sourceSize;
+uniform ivec2     destinationSize;
+
+void main() {
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(texel, destinationSize))) {
+		return;
+	}
+
+	// Source texels covered by this texel, rounded outwards so that none is missed when the sizes
+	// are not an exact multiple of each other.
+	ivec2 first = (texel * sourceSize) / destinationSize;
+	ivec2 last  = min(((texel + 1) * sourceSize + destinationSize - 1) / destinationSize,
+	                  sourceSize) - 1;
+
+	float depth = 0.0;
+	for (int y = first.y; y <= last.y; ++y) {
+		for (int x = first.x; x <= last.x; ++x) {
+			depth = max(depth, texelFetch(source, ivec2(x, y), sourceLevel).r);
+		}
+	}
+	imageStore(destination, texel, vec4(depth));
+}
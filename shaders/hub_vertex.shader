@@ -5,10 +5,16 @@ layout(location = 1) in vec2 uvs;
 
 out vec2 outUV;
 
-uniform mat4 MVP;
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
 
 void main() {
 
-	gl_Position = MVP * vec4(position, 1.0f);
+	gl_Position = viewProjection * vec4(position, 1.0f);
 	outUV = uvs;
 }
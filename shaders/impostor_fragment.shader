@@ -0,0 +1,58 @@
+#version 330 core
+
+in vec3 viewPosition;
+flat in vec3  viewCentre;
+flat in float radius;
+flat in vec3  viewLightPosition;
+flat in vec3  vColor;
+
+out vec4 color;
+
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
+
+// Lighting, as in the planet shader.
+vec3 lightColour = vec3(1.0f);
+float K_c = 0.4f;
+float K_l = 0.0001f;
+float K_q = 0.0f;
+
+float ambientStrength = 0.4f;
+
+void main() {
+    // Intersect the view ray through the fragment with the sphere, and drop the fragments of the
+    // quad the sphere does not cover.
+    vec3  ray = normalize(viewPosition);
+    float b   = dot(ray, viewCentre);
+    float h   = b * b - dot(viewCentre, viewCentre) + radius * radius;
+    if (h < 0.0f) {
+        discard;
+    }
+    vec3 fragmentPosition = ray * (b - sqrt(h));
+    vec3 normal           = (fragmentPosition - viewCentre) / radius;
+
+    // Ambient lighting.
+    vec3 ambientLight = ambientStrength * lightColour;
+
+    // Attenuation.
+    float d = length(fragmentPosition - viewLightPosition);
+    float attenuation = 1.0f / (K_c + K_l * d + K_q * d * d);
+
+    // Diffuse lighting.
+    vec3 lightDir = normalize(viewLightPosition - fragmentPosition);
+
+    float diffStrength = max(dot(normal, lightDir), 0.0f);
+    vec3 diffuseLight  = attenuation * diffStrength * lightColour;
+
+    color = vec4((ambientLight + diffuseLight) * vColor, 1.0f);
+
+    // Write the depth of the sphere rather than of the quad, so that impostors and meshes
+    // intersect correctly.
+    vec4 clipPosition = projection * vec4(fragmentPosition, 1.0f);
+    gl_FragDepth      = 0.5f * clipPosition.z / clipPosition.w + 0.5f;
+}
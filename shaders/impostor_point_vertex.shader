@@ -0,0 +1,44 @@
+#version 330 core
+
+// Centre and radius of the body, and its colour with the fraction of the pixel it covers.
+layout (location = 1) in vec4 sphere;
+layout (location = 2) in vec4 bodyColour;
+
+out vec3 vColor;
+
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
+
+// Lighting, as in the planet shader.
+vec3 lightColour = vec3(1.0f);
+float K_c = 0.4f;
+float K_l = 0.0001f;
+float K_q = 0.0f;
+
+float ambientStrength = 0.4f;
+
+void main() {
+    // Light the point of the body nearest the camera. The sun, at the origin, lights the bodies.
+    vec3 viewCentre        = vec3(view * vec4(sphere.xyz, 1.0f));
+    vec3 viewLightPosition = vec3(view * vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    vec3 normal            = -normalize(viewCentre);
+    vec3 fragmentPosition  = viewCentre + sphere.w * normal;
+
+    vec3 ambientLight = ambientStrength * lightColour;
+
+    float d = length(fragmentPosition - viewLightPosition);
+    float attenuation = 1.0f / (K_c + K_l * d + K_q * d * d);
+
+    vec3 lightDir = normalize(viewLightPosition - fragmentPosition);
+
+    float diffStrength = max(dot(normal, lightDir), 0.0f);
+    vec3 diffuseLight  = attenuation * diffStrength * lightColour;
+
+    vColor      = bodyColour.a * (ambientLight + diffuseLight) * bodyColour.rgb;
+    gl_Position = viewProjection * vec4(sphere.xyz, 1.0f);
+}
@@ -0,0 +1,41 @@
+#version 330 core
+
+// Corner of the quad, from (-1, -1) to (1, 1).
+layout (location = 0) in vec2 corner;
+// Per-instance centre and radius of the body, and its colour.
+layout (location = 1) in vec4 sphere;
+layout (location = 2) in vec4 bodyColour;
+
+out vec3 viewPosition;
+flat out vec3  viewCentre;
+flat out float radius;
+flat out vec3  viewLightPosition;
+flat out vec3  vColor;
+
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
+
+void main() {
+    // Shade in view space. The sun, at the origin, lights the bodies.
+    viewCentre        = vec3(view * vec4(sphere.xyz, 1.0f));
+    radius            = sphere.w;
+    viewLightPosition = vec3(view * vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    vColor            = bodyColour.rgb;
+
+    // Face the quad towards the camera, through the body's centre, and size it to the cone of rays
+    // touching the sphere so that it covers the whole silhouette.
+    float distance   = length(viewCentre);
+    vec3  direction  = viewCentre / distance;
+    vec3  up         = abs(direction.y) > 0.99f ? vec3(1.0f, 0.0f, 0.0f) : vec3(0.0f, 1.0f, 0.0f);
+    vec3  right      = normalize(cross(direction, up));
+    up               = cross(right, direction);
+    float quadRadius = radius * distance / sqrt(max(distance * distance - radius * radius, 1e-6f));
+
+    viewPosition = viewCentre + quadRadius * (corner.x * right + corner.y * up);
+    gl_Position  = projection * vec4(viewPosition, 1.0f);
+}
@@ -0,0 +1,9 @@
+#version 330 core
+
+in vec3 vColour;
+
+out vec4 colour;
+
+void main() {
+	colour = vec4(vColour, 1.0f);
+}
@@ -0,0 +1,40 @@
+#version 330 core
+
+// Compact vertex layout: the position is quantized to the mesh's bounding box, which the model
+// matrix undoes, and the normal is octahedral-encoded.
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 octahedralNormal;
+layout (location = 2) in vec3 color;
+// Per-instance model matrix, one per body, occupying locations 3 to 6.
+layout (location = 3) in mat4 model;
+
+out vec3 fragmentPosition;
+out vec3 fragmentNormal;
+out vec3 vColor;
+
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
+
+// Unfolds an octahedral-encoded unit vector.
+vec3 decodeOctahedral(vec2 encoded) {
+    vec3  n = vec3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = max(-n.z, 0.0f);
+    n.xy   += vec2(n.x >= 0.0f ? -t : t, n.y >= 0.0f ? -t : t);
+    return n;
+}
+
+void main() {
+    vec4 worldPosition = model * vec4(position, 1.0f);
+
+    // Models are scaled uniformly, so the model matrix maps normals to the right direction; the
+    // fragment shader normalizes them.
+    fragmentPosition = vec3(worldPosition);
+    fragmentNormal   = mat3(model) * decodeOctahedral(octahedralNormal);
+    gl_Position      = viewProjection * worldPosition;
+    vColor           = color;
+}
@@ -3,18 +3,28 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 normal;
 layout (location = 2) in vec3 color;
+// Per-instance model matrix, one per body, occupying locations 3 to 6.
+layout (location = 3) in mat4 model;
 
 out vec3 fragmentPosition;
 out vec3 fragmentNormal;
 out vec3 vColor;
 
-uniform mat4 model;
-uniform mat4 MVP;
-uniform mat4 normalMatrix;
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
 
 void main() {
-    fragmentPosition = vec3(model * vec4(position, 1.0f));
-    fragmentNormal   = vec3(normalMatrix * vec4(normal, 0));
-	gl_Position      = MVP * vec4(position, 1.0f);
+    vec4 worldPosition = model * vec4(position, 1.0f);
+
+    // Models are scaled uniformly, so the model matrix maps normals to the right direction; the
+    // fragment shader normalizes them.
+    fragmentPosition = vec3(worldPosition);
+    fragmentNormal   = mat3(model) * normal;
+	gl_Position      = viewProjection * worldPosition;
 	vColor = color;
 }
@@ -8,13 +8,23 @@ out vec3 fragmentPosition;
 out vec3 fragmentNormal;
 out vec2 outUV;
 
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
+
 uniform mat4 model;
-uniform mat4 MVP;
-uniform mat4 normalMatrix;
 
 void main() {
-    fragmentPosition = vec3(model * vec4(position, 1.0f));
-    fragmentNormal   = vec3(normalMatrix * vec4(normal, 0.0f));
-	gl_Position      = MVP * vec4(position, 1.0f);
+    vec4 worldPosition = model * vec4(position, 1.0f);
+
+    // Models are scaled uniformly, so the model matrix maps normals to the right direction; the
+    // fragment shader normalizes them.
+    fragmentPosition = vec3(worldPosition);
+    fragmentNormal   = mat3(model) * normal;
+	gl_Position      = viewProjection * worldPosition;
 	outUV = UV;
 }
@@ -4,10 +4,18 @@ layout (location = 0) in vec3 position;
 
 out vec3 texCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
 
 void main() {
-    gl_Position = projection * view * vec4(position, 1.0f);
+    // Drop the view's translation so that the skybox stays centred on the camera, and set the depth
+    // to the far plane so that the skybox is only drawn where no geometry is.
+    vec4 clipPosition = projection * mat4(mat3(view)) * vec4(position, 1.0f);
+    gl_Position = clipPosition.xyww;
     texCoords = position;
 }
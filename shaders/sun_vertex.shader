@@ -3,10 +3,19 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 uvs;
 
-uniform mat4 MVP;
+layout (std140) uniform Camera {
+	mat4  view;
+	mat4  projection;
+	mat4  viewProjection;
+	vec4  cameraPosition;
+	float time;
+};
+
+uniform mat4 model;
+
 out vec2 outUV;
 
 void main() {
-	gl_Position = MVP * vec4(position, 1.0);
+	gl_Position = viewProjection * model * vec4(position, 1.0);
 	outUV = uvs;
 }
@@ -0,0 +1,75 @@
+/**
+ * @file asset_registry.cpp
+ *
+ * Implementation file for the AssetRegistry class.
+ */
+#include "asset_registry.hpp"
+
+#include "texture.hpp"
+#include "core/profiler.hpp"
+
+// Accessor functions.
+std::size_t AssetRegistry::bytes() const {
+	std::size_t total = 0;
+	for (const std::pair<const std::string, Slot>& entry : mSlots) {
+		total += entry.second.bytes;
+	}
+	return total;
+}
+
+void AssetRegistry::report(std::ostream& out) const {
+	std::size_t nReferences = 0;
+	for (const std::pair<const std::string, Slot>& entry : mSlots) {
+		const Slot& slot = entry.second;
+		out << "  " << slot.kind << " " << slot.name << ": " << slot.references
+		    << (slot.references == 1 ? " reference, " : " references, ") << slot.bytes / 1024
+		    << " KiB" << std::endl;
+		nReferences += slot.references;
+	}
+	out << "Assets: " << mSlots.size() << " loaded, " << nReferences
+	    << (nReferences == 1 ? " reference, " : " references, ") << bytes() / 1024 << " KiB"
+	    << std::endl;
+}
+
+// Mutator functions.
+MeshHandle AssetRegistry::mesh(const std::string& path, bool compactVertices,
+                               const AssetPack *pack) {
+	std::string name = path + (compactVertices ? " (compact)" : " (float)");
+	return acquire<ModelMesh>("mesh", name, [&](std::size_t& bytes) {
+		std::unique_ptr<ModelMesh> mesh(new ModelMesh(path.c_str(), compactVertices, pack));
+		bytes = mesh->meshBytes();
+		return mesh;
+	});
+}
+
+TextureHandle AssetRegistry::texture2D(const std::string& path, TextureLoader& loader) {
+	return texture(path, [&](std::size_t& bytes) {
+		GlTexture loaded;
+		bytes = texture::loadTexture2D(path.c_str(), loaded, loader);
+		return loaded;
+	});
+}
+
+ProgramHandle AssetRegistry::program(const std::string& vertexShaderPath,
+                                     const std::string& fragmentShaderPath) {
+	return acquire<Program>("program", vertexShaderPath + " + " + fragmentShaderPath,
+	                        [&](std::size_t&) {
+		return std::unique_ptr<Program>(new Program(vertexShaderPath, fragmentShaderPath));
+	});
+}
+
+std::size_t AssetRegistry::collect() {
+	PROFILE_SCOPE("AssetRegistry::collect");
+
+	std::size_t nDeleted = 0;
+	for (std::map<std::string, Slot>::iterator it = mSlots.begin(); it != mSlots.end();) {
+		if (it->second.references == 0) {
+			it = mSlots.erase(it);
+			++nDeleted;
+		}
+		else {
+			++it;
+		}
+	}
+	return nDeleted;
+}
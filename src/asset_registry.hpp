@@ -0,0 +1,281 @@
+/**
+ * @file asset_registry.hpp
+ *
+ * Interface file for the AssetRegistry class.
+ */
+#ifndef SPACE_COWBOY_ASSET_REGISTRY_HPP
+#define SPACE_COWBOY_ASSET_REGISTRY_HPP
+
+#include "core/asset_pack.hpp"
+#include "gl_object.hpp"
+#include "model_mesh.hpp"
+#include "program.hpp"
+#include "texture_loader.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <GL/glew.h>
+
+/**
+ * Owns the meshes, textures and shader programs loaded from files, deduplicated by path and
+ * parameters: acquiring an asset already loaded shares it rather than loading it again. Each asset
+ * counts the handles referencing it. An asset no longer referenced is only deleted by the next
+ * collect(), so that draws already submitted keep valid objects and an asset released and acquired
+ * again in between is reused. An AssetRegistry should only be constructed after OpenGL has
+ * initialized, only be used from the OpenGL thread, and must outlive its handles.
+ */
+class AssetRegistry {
+public:
+	/**
+	 * Reference to an asset of the registry. Handles are move-only: each one holds one reference,
+	 * released when it is destroyed, reset or assigned over.
+	 */
+	template <typename T>
+	class Handle {
+	public:
+		/**
+		 * Creates an empty handle.
+		 */
+		Handle() :
+				mReferences(nullptr),
+				mAsset(nullptr) { }
+
+		/**
+		 * Takes the reference of another handle, leaving it empty.
+		 */
+		Handle(Handle&& other) noexcept :
+				mReferences(other.mReferences),
+				mAsset(other.mAsset) {
+			other.mReferences = nullptr;
+			other.mAsset      = nullptr;
+		}
+
+		/**
+		 * Releases the reference held, then takes the reference of another handle, leaving it
+		 * empty.
+		 */
+		Handle& operator=(Handle&& other) noexcept {
+			if (this != &other) {
+				reset();
+				std::swap(mReferences, other.mReferences);
+				std::swap(mAsset, other.mAsset);
+			}
+			return *this;
+		}
+
+		/**
+		 * Copy constructor is disabled as each handle holds one reference.
+		 */
+		Handle(const Handle&) = delete;
+
+		/**
+		 * Copy assignment operator is disabled as each handle holds one reference.
+		 */
+		void operator=(const Handle&) = delete;
+
+		/**
+		 * Releases the reference held, if any.
+		 */
+		~Handle() {
+			reset();
+		}
+
+		/**
+		 * Returns the asset. The handle must not be empty.
+		 */
+		const T& operator*() const {
+			return *mAsset;
+		}
+
+		/**
+		 * Accesses the asset. The handle must not be empty.
+		 */
+		const T *operator->() const {
+			return mAsset;
+		}
+
+		/**
+		 * Returns true if the handle references an asset.
+		 */
+		explicit operator bool() const {
+			return mAsset != nullptr;
+		}
+
+		/**
+		 * Releases the reference held, if any, leaving the handle empty.
+		 */
+		void reset() {
+			if (mReferences != nullptr) {
+				--*mReferences;
+			}
+			mReferences = nullptr;
+			mAsset      = nullptr;
+		}
+
+	private:
+		friend class AssetRegistry;
+
+		/**
+		 * Creates a handle holding a reference already counted.
+		 */
+		Handle(std::size_t *references, const T *asset) :
+				mReferences(references),
+				mAsset(asset) { }
+
+		/** Reference count of the asset, or nullptr if the handle is empty. */
+		std::size_t *mReferences;
+		/** Asset, or nullptr if the handle is empty. */
+		const T     *mAsset;
+	};
+
+	/** Handle to a model mesh. */
+	typedef Handle<ModelMesh> MeshHandle;
+	/** Handle to a texture. */
+	typedef Handle<GlTexture> TextureHandle;
+	/** Handle to a shader program. */
+	typedef Handle<Program>   ProgramHandle;
+
+	// Constructors.
+	/**
+	 * Creates an empty registry.
+	 */
+	AssetRegistry() = default;
+
+	/**
+	 * Copy constructor is disabled as the registry owns its assets.
+	 */
+	AssetRegistry(const AssetRegistry&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as the registry owns its assets.
+	 */
+	void operator=(const AssetRegistry&) = delete;
+
+	// Accessor functions.
+	/**
+	 * Returns the total size of the assets' GPU data, as far as known.
+	 *
+	 * @return Size in bytes.
+	 */
+	std::size_t bytes() const;
+
+	/**
+	 * Lists the assets, with their references and the size of their GPU data, followed by the
+	 * totals.
+	 *
+	 * @param out Stream to write the list to.
+	 */
+	void report(std::ostream& out) const;
+
+	// Mutator functions.
+	/**
+	 * Acquires a model mesh, loading it unless already loaded with the same parameters.
+	 *
+	 * @param path Path to the OBJ file, which names the cooked model.
+	 * @param compactVertices True to upload the model in the compact vertex layout.
+	 * @param pack Asset pack to load the cooked model from, or nullptr to cook the OBJ file.
+	 * @return Handle to the mesh.
+	 * @throws std::runtime_error if the model cannot be loaded.
+	 */
+	MeshHandle mesh(const std::string& path, bool compactVertices, const AssetPack *pack);
+
+	/**
+	 * Acquires a 2D texture, loading it unless already loaded.
+	 *
+	 * @param path Path of the image file.
+	 * @param loader Texture loader decoding and uploading the image.
+	 * @return Handle to the texture.
+	 * @throws std::runtime_error if the image cannot be loaded.
+	 */
+	TextureHandle texture2D(const std::string& path, TextureLoader& loader);
+
+	/**
+	 * Acquires a texture created by a function, unless already created under the same name.
+	 *
+	 * @param name Name of the texture, such as the paths of its images.
+	 * @param create Function creating the texture, called as create(bytes) to return it and set
+	 *               bytes to the size of its levels.
+	 * @return Handle to the texture.
+	 */
+	template <typename Create>
+	TextureHandle texture(const std::string& name, Create create) {
+		return acquire<GlTexture>("texture", name, [&create](std::size_t& bytes) {
+			return std::unique_ptr<GlTexture>(new GlTexture(create(bytes)));
+		});
+	}
+
+	/**
+	 * Acquires a shader program, building it unless already built from the same shaders.
+	 *
+	 * @param vertexShaderPath Path to vertex shader source code.
+	 * @param fragmentShaderPath Path to fragment shader source code.
+	 * @return Handle to the program.
+	 * @throws std::runtime_error if the program cannot be built.
+	 */
+	ProgramHandle program(const std::string& vertexShaderPath,
+	                      const std::string& fragmentShaderPath);
+
+	/**
+	 * Deletes the assets no longer referenced. Should be called once per frame, once its draws are
+	 * executed.
+	 *
+	 * @return Number of assets deleted.
+	 */
+	std::size_t collect();
+
+private:
+	/** Asset and its references. */
+	struct Slot {
+		/** Kind of asset. */
+		const char            *kind;
+		/** Name of the asset, from its paths and parameters. */
+		std::string           name;
+		/** Number of handles referencing the asset. */
+		std::size_t           references;
+		/** Size of the asset's GPU data in bytes, or 0 if unknown. */
+		std::size_t           bytes;
+		/** Asset, deleted with the slot. */
+		std::shared_ptr<void> asset;
+	};
+
+	// Helper functions.
+	/**
+	 * Acquires an asset, creating it unless a slot already holds it.
+	 *
+	 * @param kind Kind of asset.
+	 * @param name Name of the asset.
+	 * @param create Function creating the asset, called as create(bytes) to return it and set
+	 *               bytes to the size of its GPU data.
+	 * @return Handle to the asset.
+	 */
+	template <typename T, typename Create>
+	Handle<T> acquire(const char *kind, const std::string& name, Create create) {
+		std::string                           key   = std::string(kind) + ":" + name;
+		std::map<std::string, Slot>::iterator found = mSlots.find(key);
+		if (found == mSlots.end()) {
+			Slot slot = { kind, name, 0, 0, nullptr };
+			slot.asset = std::shared_ptr<T>(create(slot.bytes));
+			found = mSlots.emplace(std::move(key), std::move(slot)).first;
+		}
+		Slot& slot = found->second;
+		++slot.references;
+		return Handle<T>(&slot.references, static_cast<const T *>(slot.asset.get()));
+	}
+
+	// Data members.
+	/** Slots of the assets, by kind and name. */
+	std::map<std::string, Slot> mSlots;
+};
+
+/** Handle to a model mesh of an asset registry. */
+typedef AssetRegistry::MeshHandle    MeshHandle;
+/** Handle to a texture of an asset registry. */
+typedef AssetRegistry::TextureHandle TextureHandle;
+/** Handle to a shader program of an asset registry. */
+typedef AssetRegistry::ProgramHandle ProgramHandle;
+
+#endif
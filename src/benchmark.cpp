@@ -0,0 +1,130 @@
+/**
+ * @file benchmark.cpp
+ *
+ * Implementation file for the Benchmark class.
+ */
+#include "benchmark.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// Redeclare constant static data members.
+constexpr char Benchmark::DEFAULT_OUTPUT_PATH[];
+
+namespace {
+/**
+ * Writes render statistics as JSON members, without the enclosing braces. Templated so that both the
+ * integer counters of a frame and their floating point means can be written.
+ *
+ * @param out Output stream.
+ */
+template <typename T>
+void writeStats(std::ostream& out, const T& drawCalls, const T& dispatches,
+                const T& programSwitches, const T& vaoBinds, const T& textureBinds,
+                const T& bufferBinds, const T& skippedCalls, const T& occludedObjects,
+                const T& uniformUploads, const T& triangles, const T& bytesUploaded) {
+	out << "\"drawCalls\": " << drawCalls
+	    << ", \"dispatches\": " << dispatches
+	    << ", \"programSwitches\": " << programSwitches
+	    << ", \"vaoBinds\": " << vaoBinds
+	    << ", \"textureBinds\": " << textureBinds
+	    << ", \"bufferBinds\": " << bufferBinds
+	    << ", \"skippedCalls\": " << skippedCalls
+	    << ", \"occludedObjects\": " << occludedObjects
+	    << ", \"uniformUploads\": " << uniformUploads
+	    << ", \"triangles\": " << triangles
+	    << ", \"bytesUploaded\": " << bytesUploaded;
+}
+}
+
+// Constructors.
+Benchmark::Benchmark(unsigned int nFrames, const std::string& outputPath) :
+		mNFrames(nFrames),
+		mOutputPath(outputPath),
+		mMeshBytes(0) {
+	mFrames.reserve(nFrames);
+}
+
+// Accessor functions.
+bool Benchmark::active() const {
+	return mFrames.size() < mNFrames;
+}
+
+bool Benchmark::finished() const {
+	return mNFrames > 0 and mFrames.size() == mNFrames;
+}
+
+// Mutator functions.
+void Benchmark::recordFrame(double frameMilliseconds, double gpuMilliseconds,
+                            const renderStats::FrameStats& stats) {
+	if (not active()) {
+		return;
+	}
+
+	mFrames.push_back({ frameMilliseconds, gpuMilliseconds, stats });
+	if (finished()) {
+		write();
+	}
+}
+
+void Benchmark::setMeshBytes(std::size_t meshBytes) {
+	mMeshBytes = meshBytes;
+}
+
+// Helper functions.
+void Benchmark::write() const {
+	std::ofstream out(mOutputPath);
+	if (not out) {
+		std::cerr << "Warning: Could not write benchmark to " << mOutputPath << "." << std::endl;
+		return;
+	}
+
+	// Means over all frames.
+	double frameMs = 0, gpuMs = 0, drawCalls = 0, dispatches = 0, programSwitches = 0;
+	double vaoBinds = 0, textureBinds = 0, bufferBinds = 0, skippedCalls = 0, occludedObjects = 0;
+	double uniformUploads = 0, triangles = 0, bytesUploaded = 0;
+	for (const Frame& frame : mFrames) {
+		frameMs         += frame.frameMilliseconds;
+		gpuMs           += frame.gpuMilliseconds;
+		drawCalls       += frame.stats.drawCalls;
+		dispatches      += frame.stats.dispatches;
+		programSwitches += frame.stats.programSwitches;
+		vaoBinds        += frame.stats.vaoBinds;
+		textureBinds    += frame.stats.textureBinds;
+		bufferBinds     += frame.stats.bufferBinds;
+		skippedCalls    += frame.stats.skippedCalls;
+		occludedObjects += frame.stats.occludedObjects;
+		uniformUploads  += frame.stats.uniformUploads;
+		triangles       += frame.stats.triangles;
+		bytesUploaded   += frame.stats.bytesUploaded;
+	}
+	double n = static_cast<double>(mFrames.size());
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\n\"frames\": " << mFrames.size() << ",\n\"meshBytes\": " << mMeshBytes
+	    << ",\n\"mean\": { \"frameMs\": " << frameMs / n
+	    << ", \"gpuMs\": " << gpuMs / n << ", ";
+	writeStats(out, drawCalls / n, dispatches / n, programSwitches / n, vaoBinds / n,
+	           textureBinds / n, bufferBinds / n, skippedCalls / n, occludedObjects / n,
+	           uniformUploads / n, triangles / n, bytesUploaded / n);
+	out << " },\n\"perFrame\": [\n";
+
+	for (std::size_t i = 0; i < mFrames.size(); ++i) {
+		const Frame& frame = mFrames[i];
+		out << "{ \"frame\": " << i << ", \"frameMs\": " << frame.frameMilliseconds
+		    << ", \"gpuMs\": " << frame.gpuMilliseconds << ", ";
+		writeStats<std::uint64_t>(out, frame.stats.drawCalls, frame.stats.dispatches,
+		                          frame.stats.programSwitches,
+		                          frame.stats.vaoBinds, frame.stats.textureBinds,
+		                          frame.stats.bufferBinds, frame.stats.skippedCalls,
+		                          frame.stats.occludedObjects,
+		                          frame.stats.uniformUploads, frame.stats.triangles,
+		                          frame.stats.bytesUploaded);
+		out << (i + 1 < mFrames.size() ? " },\n" : " }\n");
+	}
+	out << "]\n}\n";
+
+	std::cout << "Benchmark of " << mFrames.size() << " frames written to " << mOutputPath << "."
+	          << std::endl;
+}
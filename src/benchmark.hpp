@@ -0,0 +1,96 @@
+/**
+ * @file benchmark.hpp
+ *
+ * Interface file for the Benchmark class.
+ */
+#ifndef SPACE_COWBOY_BENCHMARK_HPP
+#define SPACE_COWBOY_BENCHMARK_HPP
+
+#include "render_stats.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Records the frame time and render statistics of a fixed number of frames and writes them to a JSON
+ * file once the last frame is recorded. The file holds the per-frame numbers along with their means,
+ * so that runs can be compared and frame cost attributed to submission overhead or geometry.
+ */
+class Benchmark {
+public:
+	// Constants.
+	/** Default path of the benchmark output. */
+	static constexpr char DEFAULT_OUTPUT_PATH[] = "benchmark.json";
+
+	// Constructors.
+	/**
+	 * Creates a benchmark of the given number of frames. A benchmark of zero frames is inactive and
+	 * records nothing.
+	 *
+	 * @param nFrames Number of frames to record.
+	 * @param outputPath Path of the JSON file written after the last frame.
+	 */
+	Benchmark(unsigned int nFrames, const std::string& outputPath);
+
+	// Accessor functions.
+	/**
+	 * Returns whether the benchmark is recording frames.
+	 *
+	 * @return True if frames remain to be recorded, false otherwise.
+	 */
+	bool active() const;
+
+	/**
+	 * Returns whether all frames of the benchmark were recorded and written.
+	 *
+	 * @return True if the benchmark is complete, false otherwise.
+	 */
+	bool finished() const;
+
+	// Mutator functions.
+	/**
+	 * Records one frame. Writes the output file when this is the last frame of the benchmark. Does
+	 * nothing if the benchmark is inactive.
+	 *
+	 * @param frameMilliseconds CPU time of the frame in milliseconds.
+	 * @param gpuMilliseconds Average GPU time of the render passes in milliseconds.
+	 * @param stats Render statistics of the frame.
+	 */
+	void recordFrame(double frameMilliseconds, double gpuMilliseconds,
+	                 const renderStats::FrameStats& stats);
+
+	/**
+	 * Sets the size of the mesh data uploaded by the renderers, written with the frames so that runs
+	 * with different vertex layouts can be compared.
+	 *
+	 * @param meshBytes Size of the vertex and index data in bytes.
+	 */
+	void setMeshBytes(std::size_t meshBytes);
+
+private:
+	/** Numbers recorded for one frame. */
+	struct Frame {
+		double                  frameMilliseconds;
+		double                  gpuMilliseconds;
+		renderStats::FrameStats stats;
+	};
+
+	// Data members.
+	/** Number of frames to record. */
+	unsigned int       mNFrames;
+	/** Path of the JSON output. */
+	std::string        mOutputPath;
+	/** Frames recorded so far. */
+	std::vector<Frame> mFrames;
+	/** Size of the uploaded vertex and index data in bytes. */
+	std::size_t        mMeshBytes;
+
+	// Helper functions.
+	/**
+	 * Writes the recorded frames to the output file.
+	 */
+	void write() const;
+};
+
+#endif
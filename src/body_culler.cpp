@@ -0,0 +1,148 @@
+/**
+ * @file body_culler.cpp
+ *
+ * Implementation file for the BodyCuller class.
+ */
+#include "body_culler.hpp"
+
+#include "core/world.hpp"
+
+#include <algorithm>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+/** Path to compute shader source code. */
+constexpr char   COMPUTE_SHADER_PATH[] = "shaders/cull_compute.shader";
+/** Number of bodies culled by each work group. */
+constexpr GLuint WORK_GROUP_SIZE       = 64;
+
+// Shader storage buffer binding points.
+constexpr GLuint BODIES_BINDING     = 0;
+constexpr GLuint MESHES_BINDING     = 1;
+constexpr GLuint COMMANDS_BINDING   = 2;
+constexpr GLuint MODELS_BINDING     = 3;
+constexpr GLuint DRAW_COUNT_BINDING = 4;
+}
+
+// Constructors.
+BodyCuller::BodyCuller(const std::vector<gl::DrawElementsIndirectCommand>& meshes,
+                       std::size_t nBodies, GLenum indexType) :
+		mProgram(COMPUTE_SHADER_PATH),
+		mNBodies(static_cast<GLsizei>(nBodies)),
+		mCompact(GLEW_ARB_indirect_parameters),
+		mIndexType(indexType) {
+	std::size_t nSlots = std::max<std::size_t>(nBodies, 1);
+
+	mMeshBuffer = GlBuffer::generate();
+	gl::bindBuffer(GL_SHADER_STORAGE_BUFFER, mMeshBuffer.id());
+	gl::bufferData(GL_SHADER_STORAGE_BUFFER,
+	               static_cast<GLsizeiptr>(meshes.size() * sizeof(gl::DrawElementsIndirectCommand)),
+	               meshes.data(), GL_STATIC_DRAW);
+
+	mCommandBuffer = GlBuffer::generate();
+	gl::bindBuffer(GL_SHADER_STORAGE_BUFFER, mCommandBuffer.id());
+	gl::bufferData(GL_SHADER_STORAGE_BUFFER,
+	               static_cast<GLsizeiptr>(nSlots * sizeof(gl::DrawElementsIndirectCommand)),
+	               nullptr, GL_DYNAMIC_COPY);
+
+	mModelBuffer = GlBuffer::generate();
+	gl::bindBuffer(GL_SHADER_STORAGE_BUFFER, mModelBuffer.id());
+	gl::bufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(nSlots * sizeof(glm::mat4)),
+	               nullptr, GL_DYNAMIC_COPY);
+
+	mDrawCountBuffer = GlBuffer::generate();
+	gl::bindBuffer(GL_SHADER_STORAGE_BUFFER, mDrawCountBuffer.id());
+	gl::bufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+
+	// Each frame's bodies are bound as a range of the stream buffer, so regions must start at a
+	// multiple of the storage buffer offset alignment.
+	GLint alignment = 1;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	GLsizeiptr regionSize = static_cast<GLsizeiptr>(nSlots * sizeof(CullBody));
+	regionSize = (regionSize + alignment - 1) / alignment * alignment;
+	mBodies.reset(new StreamBuffer(GL_SHADER_STORAGE_BUFFER, regionSize));
+}
+
+// Accessor functions.
+bool BodyCuller::supported() {
+	return GLEW_VERSION_4_3;
+}
+
+GLuint BodyCuller::modelBuffer() const {
+	return mModelBuffer.id();
+}
+
+// OpenGL modifier functions.
+void BodyCuller::cull(const std::vector<Body>& bodies, const std::vector<std::uint32_t>& bodyMeshes,
+                      const std::vector<glm::mat4>& meshMatrices, const CameraBlock& camera,
+                      const DepthPyramid *depthPyramid) {
+	PROFILE_SCOPE("BodyCuller::cull");
+
+	// Stream the bodies' model matrices and the bounding spheres of their terrain.
+	CullBody *cullBodies = static_cast<CullBody *>(mBodies->beginRegion());
+	for (std::size_t i = 0; i < bodies.size(); ++i) {
+		const Body& body  = bodies[i];
+		glm::mat4   model = body.modelMatrix();
+		if (not meshMatrices.empty()) {
+			model = model * meshMatrices[bodyMeshes[i]];
+		}
+		cullBodies[i] = { model, glm::vec4(body.position(), MAX_TERRAIN_RADIUS * body.size()),
+		                  { bodyMeshes[i], 0, 0, 0 } };
+	}
+	GLsizeiptr size = mNBodies * static_cast<GLsizeiptr>(sizeof(CullBody));
+	mBodies->endRegion(size);
+
+	if (mCompact) {
+		GLuint zero = 0;
+		gl::bindBuffer(GL_SHADER_STORAGE_BUFFER, mDrawCountBuffer.id());
+		gl::bufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zero), &zero);
+	}
+
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, BODIES_BINDING, mBodies->id(),
+	                  mBodies->regionOffset(), size);
+	gl::bindBufferBase(GL_SHADER_STORAGE_BUFFER, MESHES_BINDING, mMeshBuffer.id());
+	gl::bindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMANDS_BINDING, mCommandBuffer.id());
+	gl::bindBufferBase(GL_SHADER_STORAGE_BUFFER, MODELS_BINDING, mModelBuffer.id());
+	gl::bindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_COUNT_BINDING, mDrawCountBuffer.id());
+
+	mProgram.enable();
+	gl::uniform1ui(mProgram.getUniformLocation("nBodies"), static_cast<GLuint>(mNBodies));
+	gl::uniform4fv(mProgram.getUniformLocation("frustumPlanes"), 6,
+	               glm::value_ptr(camera.frustumPlanes[0]));
+	gl::uniform1i(mProgram.getUniformLocation("compact"), mCompact);
+
+	// Test against the depth pyramid only once it holds a frame.
+	bool occlusion = depthPyramid != nullptr and depthPyramid->valid();
+	gl::uniform1i(mProgram.getUniformLocation("occlusion"), occlusion);
+	if (occlusion) {
+		gl::uniformMatrix4fv(mProgram.getUniformLocation("previousViewProjection"), 1, GL_FALSE,
+		                     glm::value_ptr(depthPyramid->viewProjection()));
+		gl::uniform1i(mProgram.getUniformLocation("depthPyramid"),
+		              static_cast<GLint>(DepthPyramid::TEXTURE_UNIT - GL_TEXTURE0));
+		gl::uniform1i(mProgram.getUniformLocation("pyramidLevels"), depthPyramid->levels());
+		gl::uniform2i(mProgram.getUniformLocation("pyramidSize"), depthPyramid->size().x,
+		              depthPyramid->size().y);
+		gl::activeTexture(DepthPyramid::TEXTURE_UNIT);
+		gl::bindTexture(GL_TEXTURE_2D, depthPyramid->texture());
+		gl::activeTexture(GL_TEXTURE0);
+	}
+
+	gl::dispatchCompute((static_cast<GLuint>(mNBodies) + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE,
+	                    1, 1);
+	mBodies->fenceRegion();
+
+	// Make the commands, count and model matrices visible to the draw.
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+}
+
+void BodyCuller::draw() const {
+	gl::bindBuffer(GL_DRAW_INDIRECT_BUFFER, mCommandBuffer.id());
+	if (mCompact) {
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, mDrawCountBuffer.id());
+		gl::multiDrawElementsIndirectCount(GL_TRIANGLES, mIndexType, nullptr, 0, mNBodies, 0);
+	}
+	else {
+		// Which bodies are drawn is only known on the GPU, so no triangles are counted.
+		gl::multiDrawElementsIndirect(GL_TRIANGLES, mIndexType, nullptr, mNBodies, 0, 0);
+	}
+}
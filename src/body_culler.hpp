@@ -0,0 +1,138 @@
+/**
+ * @file body_culler.hpp
+ *
+ * Interface file for the BodyCuller class.
+ */
+#ifndef SPACE_COWBOY_BODY_CULLER_HPP
+#define SPACE_COWBOY_BODY_CULLER_HPP
+
+#include "core/body.hpp"
+#include "core/camera.hpp"
+#include "depth_pyramid.hpp"
+#include "gl_calls.hpp"
+#include "gl_object.hpp"
+#include "program.hpp"
+#include "stream_buffer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+ * Culls a group of bodies on the GPU. Each frame the bodies' bounding spheres and model matrices
+ * are streamed into a shader storage buffer, and a compute shader tests every body against the
+ * viewing frustum and, once available, the depth pyramid of the previous frame. The survivors'
+ * indirect draw commands and model matrices are written to GPU buffers which the group is then
+ * drawn from, so the result is never read back. With ARB_indirect_parameters the survivors are
+ * packed and drawn with glMultiDrawElementsIndirectCountARB; otherwise every body keeps its command
+ * and culled bodies draw no instances. Requires OpenGL 4.3. A BodyCuller should only be constructed
+ * after OpenGL has initialized.
+ */
+class BodyCuller {
+public:
+	// Constructors.
+	/**
+	 * Creates the culling program and buffers for a group of bodies.
+	 *
+	 * @param meshes Draw command of each mesh of the group, with one instance.
+	 * @param nBodies Number of bodies in the group.
+	 * @param indexType Type of the group's indices, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+	 */
+	BodyCuller(const std::vector<gl::DrawElementsIndirectCommand>& meshes, std::size_t nBodies,
+	           GLenum indexType);
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	BodyCuller(const BodyCuller&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const BodyCuller&) = delete;
+
+	/**
+	 * Move constructor, taking the buffers of another culler and leaving it empty.
+	 */
+	BodyCuller(BodyCuller&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the buffers of the culler and taking those of another.
+	 */
+	BodyCuller& operator=(BodyCuller&&) noexcept = default;
+
+	// Accessor functions.
+	/**
+	 * Returns whether OpenGL supports culling on the GPU.
+	 *
+	 * @return True iff compute shaders, shader storage buffers and multi-draw indirect are
+	 *         supported.
+	 */
+	static bool supported();
+
+	/**
+	 * Returns the buffer the survivors' model matrices are written to. The group's per-instance
+	 * model matrix attribute should point at its start.
+	 *
+	 * @return Reference ID of the model matrix buffer.
+	 */
+	GLuint modelBuffer() const;
+
+	// OpenGL modifier functions.
+	/**
+	 * Culls the bodies of the current frame.
+	 *
+	 * @param bodies Simulation state of the bodies.
+	 * @param bodyMeshes Index of each body's mesh.
+	 * @param meshMatrices Matrix post-multiplied into the model matrix of each mesh's bodies, or
+	 *                     empty if there is none.
+	 * @param camera Camera block of the frame.
+	 * @param depthPyramid Depth pyramid of the previous frame, or null to only cull against the
+	 *                     viewing frustum.
+	 */
+	void cull(const std::vector<Body>& bodies, const std::vector<std::uint32_t>& bodyMeshes,
+	          const std::vector<glm::mat4>& meshMatrices, const CameraBlock& camera,
+	          const DepthPyramid *depthPyramid);
+
+	/**
+	 * Draws the bodies that survived the last culling, with the group's vertex array bound.
+	 */
+	void draw() const;
+
+private:
+	/** Body as the compute shader reads it. */
+	struct CullBody {
+		/** Model matrix. */
+		glm::mat4 model;
+		/** Centre and radius of the bounding sphere. */
+		glm::vec4 sphere;
+		/** Index of the body's mesh, padded to 16 bytes. */
+		GLuint    mesh[4];
+	};
+
+	// Data members.
+	/** Compute shader program. */
+	Program  mProgram;
+	/** Number of bodies in the group. */
+	GLsizei  mNBodies;
+	/** True iff the survivors are packed and counted on the GPU. */
+	bool     mCompact;
+	/** Type of the group's indices. */
+	GLenum   mIndexType;
+	/** Buffer holding the draw command of each mesh. */
+	GlBuffer mMeshBuffer;
+	/** Buffer the survivors' draw commands are written to. */
+	GlBuffer mCommandBuffer;
+	/** Buffer the survivors' model matrices are written to. */
+	GlBuffer mModelBuffer;
+	/** Buffer counting the packed survivors. */
+	GlBuffer mDrawCountBuffer;
+
+	/** Per-frame bodies to cull. */
+	std::unique_ptr<StreamBuffer> mBodies;
+};
+
+#endif
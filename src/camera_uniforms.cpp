@@ -0,0 +1,37 @@
+/**
+ * @file camera_uniforms.cpp
+ *
+ * Implementation file for the CameraUniforms class.
+ */
+#include "camera_uniforms.hpp"
+
+#include "gl_calls.hpp"
+
+// Redeclare constant static data members.
+constexpr GLuint CameraUniforms::BINDING;
+constexpr char   CameraUniforms::BLOCK_NAME[];
+
+// Constructors.
+CameraUniforms::CameraUniforms() {
+	static_assert(sizeof(Data) == 3 * 64 + 16 + 16, "Camera block does not match std140 layout.");
+
+	mUBO = GlBuffer::generate();
+	gl::bindBuffer(GL_UNIFORM_BUFFER, mUBO.id());
+	gl::bufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+	gl::bindBuffer(GL_UNIFORM_BUFFER, 0);
+	gl::bindBufferBase(GL_UNIFORM_BUFFER, BINDING, mUBO.id());
+}
+
+// OpenGL modifier functions.
+void CameraUniforms::update(const CameraBlock& camera, double time) {
+	Data data;
+	data.view           = camera.view;
+	data.projection     = camera.projection;
+	data.viewProjection = camera.viewProjection;
+	data.cameraPosition = glm::vec4(camera.position, 1.0f);
+	data.time           = static_cast<float>(time);
+
+	++renderStats::current().uniformUploads;
+	gl::bindBuffer(GL_UNIFORM_BUFFER, mUBO.id());
+	gl::bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data);
+}
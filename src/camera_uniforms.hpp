@@ -0,0 +1,90 @@
+/**
+ * @file camera_uniforms.hpp
+ *
+ * Interface file for the CameraUniforms class.
+ */
+#ifndef SPACE_COWBOY_CAMERA_UNIFORMS_HPP
+#define SPACE_COWBOY_CAMERA_UNIFORMS_HPP
+
+#include "core/camera.hpp"
+#include "gl_object.hpp"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+ * Uniform buffer holding the camera state of the current frame, shared by every shader program.
+ * The buffer is bound to the fixed binding point BINDING, to which Program binds the "Camera"
+ * uniform block of every program it links. Shaders declare the block as
+ *
+ *     layout (std140) uniform Camera {
+ *         mat4  view;
+ *         mat4  projection;
+ *         mat4  viewProjection;
+ *         vec4  cameraPosition;
+ *         float time;
+ *     };
+ *
+ * A CameraUniforms object should only be constructed after OpenGL has initialized.
+ */
+class CameraUniforms {
+public:
+	// Constants.
+	/** Uniform buffer binding point of the camera block. */
+	static constexpr GLuint BINDING      = 0;
+	/** Name of the uniform block in the shaders. */
+	static constexpr char   BLOCK_NAME[] = "Camera";
+
+	// Constructors.
+	/**
+	 * Creates the uniform buffer and binds it to the camera binding point.
+	 */
+	CameraUniforms();
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	CameraUniforms(const CameraUniforms&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const CameraUniforms&) = delete;
+
+	/**
+	 * Move constructor, taking the buffer of another instance and leaving it empty.
+	 */
+	CameraUniforms(CameraUniforms&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the buffer and taking that of another instance.
+	 */
+	CameraUniforms& operator=(CameraUniforms&&) noexcept = default;
+
+	// OpenGL modifier functions.
+	/**
+	 * Uploads the camera state of a frame. Should be called once per frame, before drawing.
+	 *
+	 * @param camera Camera block of the frame.
+	 * @param time Simulation time in seconds.
+	 */
+	void update(const CameraBlock& camera, double time);
+
+private:
+	/** Contents of the uniform buffer, laid out according to the std140 rules. */
+	struct Data {
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::mat4 viewProjection;
+		glm::vec4 cameraPosition;
+		float     time;
+		float     padding[3];
+	};
+
+	// Data members.
+	/** Uniform buffer. */
+	GlBuffer mUBO;
+};
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * @file asset_cook.cpp
+ *
+ * Defines the cooked asset formats in the "assetCook" namespace.
+ */
+#include "asset_cook.hpp"
+
+#include "asset_pack.hpp"
+#include "mesh_lod.hpp"
+#include "mesh_optimize.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace assetCook {
+namespace {
+/** Alignment of the arrays in payloads. */
+constexpr std::size_t ARRAY_ALIGNMENT = 4;
+
+/**
+ * Appends values to a payload in native byte order.
+ */
+template <typename T>
+void append(std::vector<std::uint8_t>& payload, const T *values, std::size_t count) {
+	const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(values);
+	payload.insert(payload.end(), bytes, bytes + sizeof(T) * count);
+}
+
+/**
+ * Appends a value to a payload in native byte order.
+ */
+template <typename T>
+void append(std::vector<std::uint8_t>& payload, T value) {
+	append(payload, &value, 1);
+}
+
+/**
+ * Appends an array to a payload, preceded by its size and padded to the array alignment.
+ */
+template <typename T>
+void appendArray(std::vector<std::uint8_t>& payload, const std::vector<T>& values) {
+	append<std::uint32_t>(payload, static_cast<std::uint32_t>(values.size()));
+	append(payload, values.data(), values.size());
+	payload.resize((payload.size() + ARRAY_ALIGNMENT - 1) / ARRAY_ALIGNMENT * ARRAY_ALIGNMENT, 0);
+}
+
+/** Reads values from a payload in place. */
+class PayloadReader {
+public:
+	PayloadReader(const std::uint8_t *payload, std::size_t size) :
+			mPayload(payload),
+			mSize(size),
+			mOffset(0) { }
+
+	/**
+	 * Reads a value.
+	 *
+	 * @throws std::runtime_error if the payload ended.
+	 */
+	template <typename T>
+	T read() {
+		T value;
+		std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	/**
+	 * Reads an array preceded by its size in place, and skips its padding.
+	 *
+	 * @throws std::runtime_error if the payload ended.
+	 */
+	template <typename T>
+	ArrayView<T> viewArray() {
+		ArrayView<T> values;
+		values.size = read<std::uint32_t>();
+		if (values.size > (mSize - mOffset) / sizeof(T)) {
+			throw std::runtime_error("Cooked asset is truncated.");
+		}
+		values.data = reinterpret_cast<const T *>(skip(sizeof(T) * values.size));
+		skip(std::min(mSize - mOffset, (ARRAY_ALIGNMENT - mOffset % ARRAY_ALIGNMENT) %
+		                               ARRAY_ALIGNMENT));
+		return values;
+	}
+
+private:
+	/**
+	 * Moves past bytes and returns their start.
+	 *
+	 * @throws std::runtime_error if the payload ended.
+	 */
+	const std::uint8_t *skip(std::size_t size) {
+		if (mSize - mOffset < size) {
+			throw std::runtime_error("Cooked asset is truncated.");
+		}
+		const std::uint8_t *start = mPayload + mOffset;
+		mOffset += size;
+		return start;
+	}
+
+	/** Payload being read. */
+	const std::uint8_t *mPayload;
+	/** Size of the payload in bytes. */
+	std::size_t         mSize;
+	/** Offset of the next value. */
+	std::size_t         mOffset;
+};
+}
+
+std::size_t ModelView::nIndices() const {
+	return indices.size / indexSize;
+}
+
+std::uint32_t ModelView::index(std::size_t i) const {
+	if (indexSize == sizeof(std::uint16_t)) {
+		std::uint16_t value;
+		std::memcpy(&value, indices.data + sizeof(value) * i, sizeof(value));
+		return value;
+	}
+	std::uint32_t value;
+	std::memcpy(&value, indices.data + sizeof(value) * i, sizeof(value));
+	return value;
+}
+
+std::uint64_t sourceHash(const void *source, std::size_t size, std::uint32_t type,
+                         std::uint32_t setting) {
+	std::uint32_t settings[] = { COOK_VERSION, type, setting };
+	return AssetPack::hash(source, size, AssetPack::hash(settings, sizeof(settings)));
+}
+
+CookedTexture cookTexture(const image::Image& source, bool compress) {
+	PROFILE_SCOPE("assetCook::cookTexture");
+
+	CookedTexture texture;
+	texture.width  = source.width;
+	texture.height = source.height;
+	texture.format = compress ? CookedTexture::BC1 :
+	                 source.channels == 4 ? CookedTexture::RGBA8 : CookedTexture::RGB8;
+	for (image::Image& level : image::mipChain(source)) {
+		texture.levels.push_back(compress ? image::encodeBC1(level) : std::move(level.pixels));
+	}
+	return texture;
+}
+
+CookedModel cookModel(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                      const std::vector<glm::vec2>& uvs, std::size_t maxLevels) {
+	PROFILE_SCOPE("assetCook::cookModel");
+
+	// Reorder each level's triangles for the vertex cache and lay the levels out one after the
+	// other.
+	LodMesh     lods      = generateLods(vertices, normals, uvs, maxLevels);
+	std::size_t nVertices = lods.positions.size();
+	CookedModel model;
+	for (const std::vector<std::uint32_t>& level : lods.levels) {
+		std::vector<std::uint32_t> optimized = optimizeVertexCache(level, nVertices);
+		model.levelOffsets.push_back(static_cast<std::uint32_t>(model.indices.size()));
+		model.levelCounts.push_back(static_cast<std::uint32_t>(optimized.size()));
+		model.indices.insert(model.indices.end(), optimized.begin(), optimized.end());
+	}
+
+	// Order the vertices as the triangles first use them, then pack them. Packing keeps the first
+	// of the vertices it merges, so the order holds.
+	std::vector<std::uint32_t> order = optimizeVertexFetch(model.indices, nVertices);
+	std::vector<glm::vec3>     orderedPositions;
+	std::vector<glm::vec3>     orderedNormals;
+	std::vector<glm::vec2>     orderedUVs;
+	for (std::uint32_t v : order) {
+		orderedPositions.push_back(lods.positions[v]);
+		orderedNormals.push_back(lods.normals[v]);
+		orderedUVs.push_back(lods.uvs[v]);
+	}
+	vertexFormat::PackedModel packed =
+			vertexFormat::packModel(orderedPositions, orderedNormals, orderedUVs);
+	for (std::uint32_t& index : model.indices) {
+		index = packed.indices[index];
+	}
+	model.vertices     = std::move(packed.vertices);
+	model.quantization = packed.quantization;
+
+	// Bound the model with the sphere around its bounding box's centre.
+	glm::vec3 minimum = orderedPositions.empty() ? glm::vec3(0.0f) : orderedPositions.front();
+	glm::vec3 maximum = minimum;
+	for (const glm::vec3& position : orderedPositions) {
+		minimum = glm::vec3(std::min(minimum.x, position.x), std::min(minimum.y, position.y),
+		                    std::min(minimum.z, position.z));
+		maximum = glm::vec3(std::max(maximum.x, position.x), std::max(maximum.y, position.y),
+		                    std::max(maximum.z, position.z));
+	}
+	model.boundsCentre = 0.5f * (minimum + maximum);
+	model.boundsRadius = 0.0f;
+	for (const glm::vec3& position : orderedPositions) {
+		model.boundsRadius = std::max(model.boundsRadius,
+		                              glm::length(position - model.boundsCentre));
+	}
+	return model;
+}
+
+std::vector<std::uint8_t> serialize(const CookedTexture& texture) {
+	std::vector<std::uint8_t> payload;
+	append<std::uint32_t>(payload, texture.format);
+	append<std::uint32_t>(payload, texture.width);
+	append<std::uint32_t>(payload, texture.height);
+	append<std::uint32_t>(payload, static_cast<std::uint32_t>(texture.levels.size()));
+	for (const std::vector<std::uint8_t>& level : texture.levels) {
+		appendArray(payload, level);
+	}
+	return payload;
+}
+
+std::vector<std::uint8_t> serialize(const CookedModel& model) {
+	std::vector<std::uint8_t> payload;
+	appendArray(payload, model.vertices);
+	append(payload, model.quantization);
+	if (model.vertices.size() <= vertexFormat::MAX_SHORT_INDEXED_VERTICES) {
+		append<std::uint32_t>(payload, sizeof(std::uint16_t));
+		appendArray(payload, vertexFormat::narrowIndices(model.indices));
+	}
+	else {
+		append<std::uint32_t>(payload, sizeof(std::uint32_t));
+		appendArray(payload, model.indices);
+	}
+	appendArray(payload, model.levelOffsets);
+	appendArray(payload, model.levelCounts);
+	append(payload, model.boundsCentre);
+	append(payload, model.boundsRadius);
+	return payload;
+}
+
+TextureView viewTexture(const std::uint8_t *payload, std::size_t size) {
+	PayloadReader reader(payload, size);
+	TextureView   texture;
+	texture.format = static_cast<CookedTexture::Format>(reader.read<std::uint32_t>());
+	texture.width  = reader.read<std::uint32_t>();
+	texture.height = reader.read<std::uint32_t>();
+	std::uint32_t nLevels = reader.read<std::uint32_t>();
+	if (texture.format > CookedTexture::BC1) {
+		throw std::runtime_error("Cooked texture has an invalid format.");
+	}
+	if (nLevels == 0 or nLevels > 32) {
+		throw std::runtime_error("Cooked texture has an invalid number of levels.");
+	}
+	for (std::uint32_t level = 0; level < nLevels; ++level) {
+		texture.levels.push_back(reader.viewArray<std::uint8_t>());
+
+		// Check the level holds all its pixels, so that uploading it reads no further.
+		std::size_t width  = std::max<std::uint32_t>(texture.width >> level, 1);
+		std::size_t height = std::max<std::uint32_t>(texture.height >> level, 1);
+		std::size_t expectedSize =
+				texture.format == CookedTexture::BC1 ?
+				(width + 3) / 4 * ((height + 3) / 4) * image::BC1_BLOCK_BYTES :
+				width * height * (texture.format == CookedTexture::RGBA8 ? 4 : 3);
+		if (texture.levels.back().size != expectedSize) {
+			throw std::runtime_error("Cooked texture has a level of the wrong size.");
+		}
+	}
+	return texture;
+}
+
+ModelView viewModel(const std::uint8_t *payload, std::size_t size) {
+	PayloadReader reader(payload, size);
+	ModelView     model;
+	model.vertices     = reader.viewArray<vertexFormat::ModelVertex>();
+	model.quantization = reader.read<vertexFormat::Quantization>();
+	model.indexSize    = reader.read<std::uint32_t>();
+	if (model.indexSize == sizeof(std::uint16_t)) {
+		ArrayView<std::uint16_t> indices = reader.viewArray<std::uint16_t>();
+		model.indices.data = reinterpret_cast<const std::uint8_t *>(indices.data);
+		model.indices.size = sizeof(std::uint16_t) * indices.size;
+	}
+	else if (model.indexSize == sizeof(std::uint32_t)) {
+		ArrayView<std::uint32_t> indices = reader.viewArray<std::uint32_t>();
+		model.indices.data = reinterpret_cast<const std::uint8_t *>(indices.data);
+		model.indices.size = sizeof(std::uint32_t) * indices.size;
+	}
+	else {
+		throw std::runtime_error("Cooked model has an invalid index size.");
+	}
+	model.levelOffsets = reader.viewArray<std::uint32_t>();
+	model.levelCounts  = reader.viewArray<std::uint32_t>();
+	model.boundsCentre = reader.read<glm::vec3>();
+	model.boundsRadius = reader.read<float>();
+
+	if (model.levelCounts.size == 0 or model.levelOffsets.size != model.levelCounts.size) {
+		throw std::runtime_error("Cooked model has invalid levels.");
+	}
+	for (std::size_t i = 0; i < model.levelOffsets.size; ++i) {
+		std::size_t end = static_cast<std::size_t>(model.levelOffsets.data[i]) +
+		                  model.levelCounts.data[i];
+		if (end > model.nIndices()) {
+			throw std::runtime_error("Cooked model has a level past its indices.");
+		}
+	}
+	for (std::size_t i = 0; i < model.nIndices(); ++i) {
+		if (model.index(i) >= model.vertices.size) {
+			throw std::runtime_error("Cooked model has an index past its vertices.");
+		}
+	}
+	return model;
+}
+}
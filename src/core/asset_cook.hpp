@@ -0,0 +1,207 @@
+/**
+ * @file asset_cook.hpp
+ *
+ * Interface file for the cooked asset formats, in the "assetCook" namespace.
+ */
+#ifndef SPACE_COWBOY_ASSET_COOK_HPP
+#define SPACE_COWBOY_ASSET_COOK_HPP
+
+#include "image.hpp"
+#include "vertex_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * Cooks textures and models into the forms the renderers upload as they are, and serializes them
+ * for asset packs. The game cooks models the same way when it loads them from their sources, so
+ * both paths draw the same data.
+ */
+namespace assetCook {
+/** Version of the cooking, part of every source hash so that changing it cooks everything again. */
+constexpr std::uint32_t COOK_VERSION = 1;
+/** Largest number of levels of detail of a cooked model, including the full detail one. */
+constexpr std::size_t   MODEL_LEVELS = 4;
+
+/** Texture with its mip chain. */
+struct CookedTexture {
+	/** Pixel formats of cooked textures. */
+	enum Format : std::uint32_t {
+		RGB8  = 0,
+		RGBA8 = 1,
+		BC1   = 2
+	};
+
+	/** Format of the levels. */
+	Format                                 format;
+	/** Width of the first level in pixels. */
+	std::uint32_t                          width;
+	/** Height of the first level in pixels. */
+	std::uint32_t                          height;
+	/** Data of each level, down to 1x1. */
+	std::vector<std::vector<std::uint8_t>> levels;
+};
+
+/** Indexed model in the compact vertex layout, with its levels of detail. */
+struct CookedModel {
+	/** Vertices, in the order the triangles first use them. */
+	std::vector<vertexFormat::ModelVertex> vertices;
+	/** Position quantization of the vertices. */
+	vertexFormat::Quantization             quantization;
+	/** Triangles of every level, one level after the other. */
+	std::vector<std::uint32_t>             indices;
+	/** First index of each level. */
+	std::vector<std::uint32_t>             levelOffsets;
+	/** Number of indices of each level. */
+	std::vector<std::uint32_t>             levelCounts;
+	/** Centre of the model's bounding sphere. */
+	glm::vec3                              boundsCentre;
+	/** Radius of the model's bounding sphere. */
+	float                                  boundsRadius;
+};
+
+/** Array read in place from a payload. */
+template <typename T>
+struct ArrayView {
+	/** First element. */
+	const T    *data;
+	/** Number of elements. */
+	std::size_t size;
+
+	/** Returns the first element, to iterate over the array. */
+	const T *begin() const {
+		return data;
+	}
+
+	/** Returns the end of the array, to iterate over it. */
+	const T *end() const {
+		return data + size;
+	}
+};
+
+/** Cooked texture read in place from a payload. */
+struct TextureView {
+	/** Format of the levels. */
+	CookedTexture::Format                format;
+	/** Width of the first level in pixels. */
+	std::uint32_t                        width;
+	/** Height of the first level in pixels. */
+	std::uint32_t                        height;
+	/** Data of each level, down to 1x1. */
+	std::vector<ArrayView<std::uint8_t>> levels;
+};
+
+/**
+ * Cooked model read in place from a payload. Its indices are 16-bit if it has at most
+ * vertexFormat::MAX_SHORT_INDEXED_VERTICES vertices and 32-bit otherwise, ready to upload.
+ */
+struct ModelView {
+	/** Vertices, in the order the triangles first use them. */
+	ArrayView<vertexFormat::ModelVertex> vertices;
+	/** Position quantization of the vertices. */
+	vertexFormat::Quantization           quantization;
+	/** Size of an index in bytes. */
+	std::uint32_t                        indexSize;
+	/** Triangles of every level, one level after the other, as bytes. */
+	ArrayView<std::uint8_t>              indices;
+	/** First index of each level. */
+	ArrayView<std::uint32_t>             levelOffsets;
+	/** Number of indices of each level. */
+	ArrayView<std::uint32_t>             levelCounts;
+	/** Centre of the model's bounding sphere. */
+	glm::vec3                            boundsCentre;
+	/** Radius of the model's bounding sphere. */
+	float                                boundsRadius;
+
+	/**
+	 * Returns the number of indices.
+	 */
+	std::size_t nIndices() const;
+
+	/**
+	 * Returns an index, whatever its size.
+	 *
+	 * @param i Position of the index.
+	 * @return Index.
+	 */
+	std::uint32_t index(std::size_t i) const;
+};
+
+/**
+ * Hashes a source together with the settings it is cooked with, to identify its cooked copy.
+ *
+ * @param source Contents of the source file.
+ * @param size Size of the source in bytes.
+ * @param type Type of the cooked asset, an AssetPack::Type.
+ * @param setting Cooking setting, such as whether textures are compressed.
+ * @return Hash.
+ */
+std::uint64_t sourceHash(const void *source, std::size_t size, std::uint32_t type,
+                         std::uint32_t setting);
+
+/**
+ * Cooks a texture: builds its mip chain and compresses each level to BC1 if requested.
+ *
+ * @param source Full resolution image.
+ * @param compress True to compress to BC1, dropping any alpha channel.
+ * @return Cooked texture.
+ */
+CookedTexture cookTexture(const image::Image& source, bool compress);
+
+/**
+ * Cooks a model loaded from an OBJ file: merges its identical vertices, generates its levels of
+ * detail, reorders each level's triangles for the vertex cache and the vertices for fetching, and
+ * packs the vertices into the compact layout.
+ *
+ * @param vertices Position of each vertex of the triangles.
+ * @param normals Normal of each vertex.
+ * @param uvs Texture coordinates of each vertex.
+ * @param maxLevels Largest number of levels of detail, including the full detail one.
+ * @return Cooked model.
+ */
+CookedModel cookModel(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                      const std::vector<glm::vec2>& uvs, std::size_t maxLevels);
+
+/**
+ * Serializes a cooked texture for an asset pack. Its arrays are aligned to 4 bytes, provided the
+ * payload is, so that they can be read in place.
+ *
+ * @param texture Cooked texture.
+ * @return Payload.
+ */
+std::vector<std::uint8_t> serialize(const CookedTexture& texture);
+
+/**
+ * Serializes a cooked model for an asset pack, narrowing its indices to 16 bits if it has few
+ * enough vertices. Its arrays are aligned to 4 bytes, provided the payload is, so that they can be
+ * read in place.
+ *
+ * @param model Cooked model.
+ * @return Payload.
+ */
+std::vector<std::uint8_t> serialize(const CookedModel& model);
+
+/**
+ * Reads a cooked texture in place.
+ *
+ * @param payload Payload, as serialize returns it, aligned to 4 bytes.
+ * @param size Size of the payload in bytes.
+ * @return View of the texture into the payload.
+ * @throws std::runtime_error if the payload is truncated or its levels are invalid.
+ */
+TextureView viewTexture(const std::uint8_t *payload, std::size_t size);
+
+/**
+ * Reads a cooked model in place.
+ *
+ * @param payload Payload, as serialize returns it, aligned to 4 bytes.
+ * @param size Size of the payload in bytes.
+ * @return View of the model into the payload.
+ * @throws std::runtime_error if the payload is truncated or its levels or indices are invalid.
+ */
+ModelView viewModel(const std::uint8_t *payload, std::size_t size);
+}
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file asset_pack.cpp
+ *
+ * Implementation file for the AssetPack class.
+ */
+#include "asset_pack.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+/** Magic number at the start of a pack. */
+constexpr char        MAGIC[4]       = { 'S', 'C', 'P', 'K' };
+/** Size of the header in bytes. */
+constexpr std::size_t HEADER_SIZE    = sizeof(MAGIC) + 3 * sizeof(std::uint32_t) +
+                                       sizeof(std::uint64_t);
+/** Size of an entry of the table of contents with an empty name, in bytes. */
+constexpr std::size_t MIN_ENTRY_SIZE = 2 * sizeof(std::uint32_t) + 4 * sizeof(std::uint64_t);
+
+/**
+ * Writes a value to a binary stream in native byte order.
+ */
+template <typename T>
+void writeValue(std::ostream& out, T value) {
+	out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Reads a value from a mapped pack in native byte order and moves past it.
+ *
+ * @throws std::runtime_error if the pack ended.
+ */
+template <typename T>
+T readValue(const std::uint8_t *data, std::size_t size, std::size_t& offset,
+            const std::string& path) {
+	T value;
+	if (offset > size or size - offset < sizeof(T)) {
+		throw std::runtime_error("Asset pack " + path + " is truncated.");
+	}
+	std::memcpy(&value, data + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+
+/**
+ * Pads a binary stream with zeros up to a multiple of the payload alignment.
+ */
+void align(std::ostream& out) {
+	std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+	for (; position % AssetPack::PAYLOAD_ALIGNMENT != 0; ++position) {
+		out.put('\0');
+	}
+}
+}
+
+// Redeclare constant static data members.
+constexpr char          AssetPack::DEFAULT_PATH[];
+constexpr std::uint32_t AssetPack::VERSION;
+constexpr std::size_t   AssetPack::PAYLOAD_ALIGNMENT;
+
+// Constructors.
+AssetPack::AssetPack(const std::string& path) :
+		mPath(path),
+		mFile(path),
+		mData(reinterpret_cast<const std::uint8_t *>(mFile.data())),
+		mSize(mFile.size()) {
+	PROFILE_SCOPE("AssetPack::AssetPack");
+
+	// Check the header, then read the table of contents it points to.
+	if (mSize < HEADER_SIZE or not std::equal(MAGIC, MAGIC + 4, mData)) {
+		throw std::runtime_error(path + " is not an asset pack.");
+	}
+	std::size_t offset = sizeof(MAGIC);
+	if (readValue<std::uint32_t>(mData, mSize, offset, path) != VERSION) {
+		throw std::runtime_error("Unsupported asset pack version in " + path + ".");
+	}
+	std::uint32_t nEntries = readValue<std::uint32_t>(mData, mSize, offset, path);
+	readValue<std::uint32_t>(mData, mSize, offset, path);
+	offset = static_cast<std::size_t>(readValue<std::uint64_t>(mData, mSize, offset, path));
+
+	// Bound the number of entries by the table's size before allocating them.
+	if (offset > mSize or (mSize - offset) / MIN_ENTRY_SIZE < nEntries) {
+		throw std::runtime_error("Asset pack " + path + " is truncated.");
+	}
+	mEntries.resize(nEntries);
+	for (Entry& entry : mEntries) {
+		entry.type = static_cast<Type>(readValue<std::uint32_t>(mData, mSize, offset, path));
+		std::uint32_t nameSize = readValue<std::uint32_t>(mData, mSize, offset, path);
+		entry.offset      = readValue<std::uint64_t>(mData, mSize, offset, path);
+		entry.size        = readValue<std::uint64_t>(mData, mSize, offset, path);
+		entry.sourceHash  = readValue<std::uint64_t>(mData, mSize, offset, path);
+		entry.contentHash = readValue<std::uint64_t>(mData, mSize, offset, path);
+		if (mSize - offset < nameSize or entry.offset > mSize or
+		    mSize - entry.offset < entry.size) {
+			throw std::runtime_error("Asset pack " + path + " is truncated.");
+		}
+		entry.name.assign(reinterpret_cast<const char *>(mData + offset), nameSize);
+		offset += nameSize;
+	}
+}
+
+// Accessor functions.
+const std::string& AssetPack::path() const {
+	return mPath;
+}
+
+const std::vector<AssetPack::Entry>& AssetPack::entries() const {
+	return mEntries;
+}
+
+const AssetPack::Entry *AssetPack::find(const std::string& name, Type type) const {
+	for (const Entry& entry : mEntries) {
+		if (entry.type == type and entry.name == name) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+const std::uint8_t *AssetPack::payload(const Entry& entry) const {
+	PROFILE_SCOPE("AssetPack::payload");
+
+	const std::uint8_t *data = mData + entry.offset;
+	mFile.advise(entry.offset, entry.size, utility::MappedFile::WILL_NEED);
+	if (hash(data, entry.size) != entry.contentHash) {
+		throw std::runtime_error(entry.name + " is corrupt in " + mPath + ".");
+	}
+	return data;
+}
+
+void AssetPack::release(const Entry& entry) const {
+	mFile.advise(entry.offset, entry.size, utility::MappedFile::DONT_NEED);
+}
+
+// Helper functions.
+std::uint64_t AssetPack::hash(const void *data, std::size_t size, std::uint64_t seed) {
+	const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+	std::uint64_t       value = seed;
+	for (std::size_t i = 0; i < size; ++i) {
+		value = (value ^ bytes[i]) * 0x100000001b3ULL;
+	}
+	return value;
+}
+
+void AssetPack::write(const std::string& path, const std::vector<Item>& items) {
+	PROFILE_SCOPE("AssetPack::write");
+
+	std::string   temporaryPath = path + ".tmp";
+	std::ofstream out(temporaryPath, std::ios::binary);
+	if (not out) {
+		throw std::runtime_error("Could not write asset pack " + path + ".");
+	}
+
+	// Write a placeholder header, then the payloads, recording their offsets.
+	out.write(MAGIC, sizeof(MAGIC));
+	writeValue<std::uint32_t>(out, VERSION);
+	writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(items.size()));
+	writeValue<std::uint32_t>(out, 0);
+	writeValue<std::uint64_t>(out, 0);
+	std::vector<std::uint64_t> offsets;
+	for (const Item& item : items) {
+		align(out);
+		offsets.push_back(static_cast<std::uint64_t>(out.tellp()));
+		out.write(reinterpret_cast<const char *>(item.payload.data()),
+		          static_cast<std::streamsize>(item.payload.size()));
+	}
+
+	// Append the table of contents and point the header to it.
+	align(out);
+	std::uint64_t tocOffset = static_cast<std::uint64_t>(out.tellp());
+	for (std::size_t i = 0; i < items.size(); ++i) {
+		const Item& item = items[i];
+		writeValue<std::uint32_t>(out, item.type);
+		writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(item.name.size()));
+		writeValue<std::uint64_t>(out, offsets[i]);
+		writeValue<std::uint64_t>(out, item.payload.size());
+		writeValue<std::uint64_t>(out, item.sourceHash);
+		writeValue<std::uint64_t>(out, hash(item.payload.data(), item.payload.size()));
+		out.write(item.name.data(), static_cast<std::streamsize>(item.name.size()));
+	}
+	out.seekp(sizeof(MAGIC) + 3 * sizeof(std::uint32_t));
+	writeValue<std::uint64_t>(out, tocOffset);
+	out.close();
+	if (not out) {
+		throw std::runtime_error("Could not write asset pack " + path + ".");
+	}
+
+	// Replace the previous pack. Windows does not rename over existing files, so remove it first
+	// there.
+	if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+		std::remove(path.c_str());
+		if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+			throw std::runtime_error("Could not replace asset pack " + path + ".");
+		}
+	}
+}
@@ -0,0 +1,171 @@
+/**
+ * @file asset_pack.hpp
+ *
+ * Interface file for the AssetPack class.
+ */
+#ifndef SPACE_COWBOY_ASSET_PACK_HPP
+#define SPACE_COWBOY_ASSET_PACK_HPP
+
+#include "utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Reads a pack of cooked assets, as the sc_cook tool writes it. Each asset is named after the path
+ * of the source it was cooked from, so that the game can look it up by the path it would otherwise
+ * load, and falls back on the source when the pack does not hold it.
+ *
+ * Packs are stored in native byte order:
+ *   header:  magic "SCPK", uint32 version, uint32 number of entries, uint32 zero, uint64 offset of
+ *            the table of contents
+ *   payload: the cooked data of each entry, aligned to PAYLOAD_ALIGNMENT bytes
+ *   entry:   uint32 type, uint32 name length, uint64 offset, uint64 size, uint64 source hash,
+ *            uint64 content hash, name
+ * The source hash identifies the source and cooking settings an entry was cooked from, so that
+ * the cooker only cooks changed sources again. The content hash is checked on every read.
+ *
+ * The pack is memory-mapped once, and payloads are read in place from the mapped pages so that
+ * they can be uploaded to the GPU without copies. Once uploaded, a payload is released to let the
+ * OS drop its pages.
+ */
+class AssetPack {
+public:
+	// Constants.
+	/** Default path of the pack, which the game loads if it exists. */
+	static constexpr char          DEFAULT_PATH[]    = "assets.pack";
+	/** Version of the pack format, and of the cooked payload formats it holds. */
+	static constexpr std::uint32_t VERSION           = 2;
+	/** Alignment of the payloads in the file. */
+	static constexpr std::size_t   PAYLOAD_ALIGNMENT = 16;
+
+	/** Types of cooked assets. */
+	enum Type : std::uint32_t {
+		TEXTURE = 1,
+		MODEL   = 2
+	};
+
+	/** Table of contents entry of a cooked asset. */
+	struct Entry {
+		/** Path of the source the asset was cooked from. */
+		std::string   name;
+		/** Type of the asset. */
+		Type          type;
+		/** Offset of the payload in the file. */
+		std::uint64_t offset;
+		/** Size of the payload in bytes. */
+		std::uint64_t size;
+		/** Hash of the source and the cooking settings. */
+		std::uint64_t sourceHash;
+		/** Hash of the payload. */
+		std::uint64_t contentHash;
+	};
+
+	/** Cooked asset to write into a pack. */
+	struct Item {
+		/** Path of the source the asset was cooked from. */
+		std::string               name;
+		/** Type of the asset. */
+		Type                      type;
+		/** Hash of the source and the cooking settings. */
+		std::uint64_t             sourceHash;
+		/** Cooked data. */
+		std::vector<std::uint8_t> payload;
+	};
+
+	// Constructors.
+	/**
+	 * Maps a pack and reads its table of contents.
+	 *
+	 * @param path Path of the pack.
+	 * @throws std::runtime_error if the pack cannot be opened, is invalid or has another version.
+	 */
+	explicit AssetPack(const std::string& path);
+
+	/**
+	 * Copy constructor is disabled as the pack holds its mapping.
+	 */
+	AssetPack(const AssetPack&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as the pack holds its mapping.
+	 */
+	void operator=(const AssetPack&) = delete;
+
+	// Accessor functions.
+	/**
+	 * Returns the path of the pack.
+	 */
+	const std::string& path() const;
+
+	/**
+	 * Returns the table of contents.
+	 */
+	const std::vector<Entry>& entries() const;
+
+	/**
+	 * Looks up an asset by the path of its source.
+	 *
+	 * @param name Path of the source.
+	 * @param type Type of the asset.
+	 * @return Entry of the asset, or nullptr if the pack does not hold it.
+	 */
+	const Entry *find(const std::string& name, Type type) const;
+
+	/**
+	 * Returns the payload of an asset in the mapped pack, advising the OS to read its pages ahead,
+	 * and checks it against its content hash.
+	 *
+	 * @param entry Entry of the asset.
+	 * @return Start of the cooked data, valid as long as the pack.
+	 * @throws std::runtime_error if the payload is corrupt.
+	 */
+	const std::uint8_t *payload(const Entry& entry) const;
+
+	/**
+	 * Advises the OS that the payload of an asset is no longer needed, once uploaded, so that its
+	 * pages are dropped rather than kept in memory. The payload stays readable, from the file.
+	 *
+	 * @param entry Entry of the asset.
+	 */
+	void release(const Entry& entry) const;
+
+	// Helper functions.
+	/**
+	 * Hashes bytes with 64-bit FNV-1a.
+	 *
+	 * @param data Bytes to hash.
+	 * @param size Number of bytes.
+	 * @param seed Hash to continue from, to hash several buffers as one.
+	 * @return Hash.
+	 */
+	static std::uint64_t hash(const void *data, std::size_t size,
+	                          std::uint64_t seed = 0xcbf29ce484222325ULL);
+
+	/**
+	 * Writes a pack. The pack is written next to its path and renamed over it once complete, so
+	 * that an interrupted write leaves any previous pack intact.
+	 *
+	 * @param path Path of the pack.
+	 * @param items Cooked assets.
+	 * @throws std::runtime_error if the pack cannot be written.
+	 */
+	static void write(const std::string& path, const std::vector<Item>& items);
+
+private:
+	// Data members.
+	/** Path of the pack. */
+	std::string          mPath;
+	/** Mapped pack. */
+	utility::MappedFile  mFile;
+	/** Start of the mapped pack. */
+	const std::uint8_t  *mData;
+	/** Size of the pack in bytes. */
+	std::size_t          mSize;
+	/** Table of contents. */
+	std::vector<Entry>   mEntries;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file body.cpp
+ *
+ * Implementation file for the Body struct.
+ */
+#include "body.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+// Collision properties.
+/** Distance of the spaceship in front of the camera. */
+constexpr float SHIP_DISTANCE    = 25.0f;
+/** Height of the camera above the spaceship. */
+constexpr float SHIP_DROP        = 4.0f;
+/** Collision radius of a body relative to its size. */
+constexpr float COLLISION_MARGIN = 1.1f;
+
+/**
+ * Moves a translation matrix along a rotation about a point.
+ *
+ * @param translation Translation matrix to move.
+ * @param point Point to rotate around.
+ * @param angle Angle to rotate by in radians.
+ * @param rotationAxis Axis to rotate around.
+ */
+void rotateAroundPoint(glm::mat4& translation, const glm::vec3& point, float angle,
+                       const glm::vec3& rotationAxis) {
+	glm::mat4 orbitalRotation = glm::rotate(glm::mat4(), angle, rotationAxis);
+	glm::vec3 oldPosition     = glm::vec3(translation[3]) - point;
+
+	// Translate back to the point, rotate the old position vector, and translate back to the new
+	// position.
+	glm::vec3 newPosition = glm::vec3(orbitalRotation * glm::vec4(oldPosition, 1.0f));
+	translation = glm::translate(translation, -oldPosition);
+	translation = glm::translate(translation, newPosition);
+}
+}
+
+// Accessor functions.
+glm::mat4 Body::modelMatrix() const {
+	return translation * rotation * scale;
+}
+
+glm::vec3 Body::position() const {
+	return glm::vec3(translation[3]);
+}
+
+float Body::size() const {
+	return (scale[0][0] + scale[1][1] + scale[2][2]) / 3;
+}
+
+void advanceOrbit(glm::mat4& rotation, glm::mat4& translation, const glm::vec3& angularVelocity,
+                  const glm::vec3& orbitalAngularVelocity, float deltaT) {
+	// Rotate the body about its own centre according to its angular velocity and the time step.
+	if (glm::length(angularVelocity) > 0.0f) {
+		float rotationalAngle = glm::length(angularVelocity) * deltaT;
+		rotation = glm::rotate(rotation, rotationalAngle, angularVelocity);
+	}
+
+	// Rotate the body about the origin according to its orbital angular velocity and the time step:
+	// translate it back to the origin, rotate the old position vector, and translate to the new
+	// position.
+	if (glm::length(orbitalAngularVelocity) > 0.0f) {
+		float orbitalAngle = glm::length(orbitalAngularVelocity) * deltaT;
+		rotateAroundPoint(translation, glm::vec3(), orbitalAngle, orbitalAngularVelocity);
+	}
+}
+
+void advanceBody(Body& body, float deltaT) {
+	advanceOrbit(body.rotation, body.translation, body.angularVelocity, body.orbitalAngularVelocity,
+	             deltaT);
+}
+
+void advanceMoon(Body& moon, const Body& primary, float deltaT) {
+	// Move the moon so that it is the same relative position from the primary as in the previous
+	// step.
+	if (glm::length(primary.orbitalAngularVelocity) > 0.0f) {
+		float rotationalAngle = glm::length(primary.orbitalAngularVelocity) * deltaT;
+		rotateAroundPoint(moon.translation, glm::vec3(), rotationalAngle,
+		                  primary.orbitalAngularVelocity);
+	}
+
+	// Rotate the moon about its own centre according to its angular velocity.
+	if (glm::length(moon.angularVelocity) > 0.0f) {
+		float rotationalAngle = glm::length(moon.angularVelocity) * deltaT;
+		moon.rotation = glm::rotate(moon.rotation, rotationalAngle, moon.angularVelocity);
+	}
+
+	// Rotate the moon about the primary according to its orbital angular velocity.
+	if (glm::length(moon.orbitalAngularVelocity) > 0.0f) {
+		float orbitalAngle = glm::length(moon.orbitalAngularVelocity) * deltaT;
+		rotateAroundPoint(moon.translation, primary.position(), orbitalAngle,
+		                  moon.orbitalAngularVelocity);
+	}
+}
+
+bool bodyCollision(const Body& body, const glm::vec3& cameraPosition,
+                   const glm::vec3& cameraDirection) {
+	glm::vec3 shipPosition = cameraPosition - glm::vec3(0.0f, SHIP_DROP, 0.0f) +
+	                         SHIP_DISTANCE * cameraDirection;
+	float     radius       = glm::length(body.scale * glm::vec4(1.0f, 0.0f, 0.0f, 0.0f));
+
+	return glm::length(shipPosition - body.position()) <= radius * COLLISION_MARGIN;
+}
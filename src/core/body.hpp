@@ -0,0 +1,95 @@
+/**
+ * @file body.hpp
+ *
+ * Interface file for the Body struct, the simulation state of a sun, planet or moon.
+ */
+#ifndef SPACE_COWBOY_BODY_HPP
+#define SPACE_COWBOY_BODY_HPP
+
+#include <glm/glm.hpp>
+
+/**
+ * Simulation state of a celestial body: its transform and its state of motion. Holds no rendering
+ * state, so bodies can be generated and advanced without an OpenGL context.
+ */
+struct Body {
+	// Accessor functions.
+	/**
+	 * Returns the model matrix of the body.
+	 *
+	 * @return Body's model matrix.
+	 */
+	glm::mat4 modelMatrix() const;
+
+	/**
+	 * Returns the body's position.
+	 *
+	 * @return Body's position.
+	 */
+	glm::vec3 position() const;
+
+	/**
+	 * Returns the body's size.
+	 *
+	 * @return Body's size.
+	 */
+	float size() const;
+
+	// Data members.
+	/** Scale matrix. */
+	glm::mat4 scale;
+	/** Rotation matrix. */
+	glm::mat4 rotation;
+	/** Translation matrix. */
+	glm::mat4 translation;
+
+	/** Body's angular velocity about its own centre. */
+	glm::vec3 angularVelocity;
+	/** Body's orbital angular velocity, about the origin or about its primary. */
+	glm::vec3 orbitalAngularVelocity;
+};
+
+/**
+ * Advances a body by a time step: spins it about its own centre according to its angular velocity
+ * and moves it along its orbit about the origin according to its orbital angular velocity.
+ *
+ * @param rotation Rotation matrix of the body.
+ * @param translation Translation matrix of the body.
+ * @param angularVelocity Angular velocity of the body about its own centre.
+ * @param orbitalAngularVelocity Orbital angular velocity of the body about the origin.
+ * @param deltaT Time step in seconds.
+ */
+void advanceOrbit(glm::mat4& rotation, glm::mat4& translation, const glm::vec3& angularVelocity,
+                  const glm::vec3& orbitalAngularVelocity, float deltaT);
+
+/**
+ * Advances a body orbiting the origin by a time step.
+ *
+ * @param body Body to advance.
+ * @param deltaT Time step in seconds.
+ */
+void advanceBody(Body& body, float deltaT);
+
+/**
+ * Advances a moon by a time step: carries it along its primary's orbit so that it keeps its
+ * position relative to the primary, spins it, and moves it along its orbit about the primary. The
+ * primary must already have been advanced by the same time step.
+ *
+ * @param moon Moon to advance.
+ * @param primary Body the moon orbits.
+ * @param deltaT Time step in seconds.
+ */
+void advanceMoon(Body& moon, const Body& primary, float deltaT);
+
+/**
+ * Returns whether the spaceship in front of a camera touches a body.
+ *
+ * @param body Body to test.
+ * @param cameraPosition Position of the camera.
+ * @param cameraDirection Viewing direction of the camera.
+ * @return True if the spaceship is within the body's collision radius, false otherwise.
+ */
+bool bodyCollision(const Body& body, const glm::vec3& cameraPosition,
+                   const glm::vec3& cameraDirection);
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * @file camera.cpp
+ *
+ * Implementation file for the Camera class.
+ */
+#include "camera.hpp"
+
+// CameraBlock accessor functions.
+bool CameraBlock::sphereVisible(const glm::vec3& centre, float radius) const {
+	for (const glm::vec4& plane : frustumPlanes) {
+		if (glm::dot(glm::vec3(plane), centre) + plane.w < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+float CameraBlock::viewDepth(const glm::vec3& point) const {
+	return glm::dot(point - position, direction);
+}
+
+// Constructors.
+Camera::Camera() :
+		mFOV(glm::radians(45.0f)),
+		mAspectRatio(1.0f),
+		mNearClippingPlane(0.1f),
+		mFarClippingPlane(100.0f),
+		mPosition(glm::vec3(0, 0, 0)),
+		mDirection(glm::vec3(0, 0, -1.0f)),
+		mUp(glm::vec3(0, 1, 0)),
+		mShipTiltLeft(false),
+		mShipTiltRight(false),
+		mFreeCamera_Mode(false),
+		mBlock(),
+		mViewDirty(true),
+		mProjectionDirty(true),
+		mBlockDirty(true) { }
+
+Camera::Camera(float fov, float aspectRatio, float nearClippingPlane, float farClippingPlane,
+               const glm::vec3& position, const glm::vec3& direction, const glm::vec3& up) :
+		mFOV(fov),
+		mAspectRatio(aspectRatio),
+		mNearClippingPlane(nearClippingPlane),
+		mFarClippingPlane(farClippingPlane),
+		mPosition(position),
+		mDirection(direction),
+		mUp(up),
+		mShipTiltLeft(false),
+		mShipTiltRight(false),
+		mFreeCamera_Mode(false),
+		mBlock(),
+		mViewDirty(true),
+		mProjectionDirty(true),
+		mBlockDirty(true) { }
+
+// Accessor functions.
+glm::vec3 Camera::position() const {
+	return mPosition;
+}
+
+glm::vec3 Camera::direction() const {
+	return mDirection;
+}
+
+glm::vec3 Camera::up() const {
+	return mUp;
+}
+
+const glm::mat4& Camera::view() const {
+	updateView();
+	return mBlock.view;
+}
+
+const glm::mat4& Camera::projection() const {
+	updateProjection();
+	return mBlock.projection;
+}
+
+const CameraBlock& Camera::block() const {
+	updateView();
+	updateProjection();
+	if (not mBlockDirty) {
+		return mBlock;
+	}
+
+	mBlock.viewProjection        = mBlock.projection * mBlock.view;
+	mBlock.inverseView           = glm::inverse(mBlock.view);
+	mBlock.inverseProjection     = glm::inverse(mBlock.projection);
+	mBlock.inverseViewProjection = glm::inverse(mBlock.viewProjection);
+	mBlock.position              = mPosition;
+	mBlock.direction             = glm::normalize(mDirection);
+
+	// Extract the frustum planes from the rows of the view-projection matrix (Gribb and Hartmann).
+	// glm matrices are column major, so row i is (m[0][i], m[1][i], m[2][i], m[3][i]).
+	const glm::mat4& m = mBlock.viewProjection;
+	glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+	glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+	glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+	glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+	mBlock.frustumPlanes[0] = row3 + row0;
+	mBlock.frustumPlanes[1] = row3 - row0;
+	mBlock.frustumPlanes[2] = row3 + row1;
+	mBlock.frustumPlanes[3] = row3 - row1;
+	mBlock.frustumPlanes[4] = row3 + row2;
+	mBlock.frustumPlanes[5] = row3 - row2;
+	for (glm::vec4& plane : mBlock.frustumPlanes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+
+	mBlockDirty = false;
+	return mBlock;
+}
+
+// Mutator functions.
+void Camera::setFOV(float fov) {
+	if (fov != mFOV) {
+		mFOV = fov;
+		mProjectionDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+void Camera::setAspectRatio(float aspectRatio) {
+	if (aspectRatio != mAspectRatio) {
+		mAspectRatio = aspectRatio;
+		mProjectionDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+void Camera::setNearClippingPlane(float nearClippingPlane) {
+	if (nearClippingPlane != mNearClippingPlane) {
+		mNearClippingPlane = nearClippingPlane;
+		mProjectionDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+void Camera::setFarClippingPlane(float farClippingPlane) {
+	if (farClippingPlane != mFarClippingPlane) {
+		mFarClippingPlane = farClippingPlane;
+		mProjectionDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+void Camera::setPosition(const glm::vec3& position) {
+	if (position != mPosition) {
+		mPosition = position;
+		mViewDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+void Camera::setDirection(const glm::vec3& direction) {
+	if (direction != mDirection) {
+		mDirection = direction;
+		mViewDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+void Camera::setUp(const glm::vec3& up) {
+	if (up != mUp) {
+		mUp = up;
+		mViewDirty = true;
+		mBlockDirty = true;
+	}
+}
+
+bool Camera::getTiltLeft() const {
+
+	return mShipTiltLeft;
+}
+
+bool Camera::getTiltRight() const {
+
+	return mShipTiltRight;
+
+}
+
+void Camera::setTiltLeft(bool tilt) {
+	
+	mShipTiltLeft = tilt;
+}
+
+void Camera::setTiltRight(bool tilt) {
+	mShipTiltRight = tilt;
+}
+
+bool Camera::isFreeCameraMode() const {
+
+	return mFreeCamera_Mode;
+}
+
+void Camera::setFreeCameraMode(bool cameraMode) {
+
+	mFreeCamera_Mode = cameraMode;
+}
+
+// Helper functions.
+void Camera::updateView() const {
+	if (mViewDirty) {
+		mBlock.view = glm::lookAt(mPosition, mPosition + mDirection, mUp);
+		mViewDirty  = false;
+	}
+}
+
+void Camera::updateProjection() const {
+	if (mProjectionDirty) {
+		mBlock.projection = glm::perspective(mFOV, mAspectRatio, mNearClippingPlane,
+		                                     mFarClippingPlane);
+		mProjectionDirty  = false;
+	}
+}
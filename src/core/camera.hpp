@@ -9,10 +9,58 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+/**
+ * Derived camera state shared by every draw of a frame. Holds the view and projection matrices,
+ * their product and inverses, and the planes of the viewing frustum.
+ */
+struct CameraBlock {
+	// Accessor functions.
+	/**
+	 * Returns whether a sphere intersects the viewing frustum.
+	 *
+	 * @param centre Centre of the sphere in world space.
+	 * @param radius Radius of the sphere.
+	 * @return True if any part of the sphere may be visible, false otherwise.
+	 */
+	bool sphereVisible(const glm::vec3& centre, float radius) const;
+
+	/**
+	 * Returns the distance of a point from the camera along the viewing direction.
+	 *
+	 * @param point Point in world space.
+	 * @return View depth of the point, negative if it is behind the camera.
+	 */
+	float viewDepth(const glm::vec3& point) const;
+
+	// Data members.
+	/** View matrix. */
+	glm::mat4 view;
+	/** Projection matrix. */
+	glm::mat4 projection;
+	/** Product of the projection and view matrices. */
+	glm::mat4 viewProjection;
+	/** Inverse of the view matrix. */
+	glm::mat4 inverseView;
+	/** Inverse of the projection matrix. */
+	glm::mat4 inverseProjection;
+	/** Inverse of the product of the projection and view matrices. */
+	glm::mat4 inverseViewProjection;
+	/**
+	 * Frustum planes in world space, in the order left, right, bottom, top, near, far. Each plane is
+	 * stored as (normal, distance) with the normal pointing into the frustum and of unit length.
+	 */
+	glm::vec4 frustumPlanes[6];
+	/** Camera position. */
+	glm::vec3 position;
+	/** Direction camera is facing, of unit length. */
+	glm::vec3 direction;
+};
+
 /**
  * Class for accessing and manipulating the state of the camera. A camera object can create a view
  * and projection matrix when constructed with the necessary parameters, such as field of view and
- * camera position.
+ * camera position. The matrices are cached and only recomputed after the parameters they depend on
+ * change.
  */
 class Camera {
 public:
@@ -63,14 +111,22 @@ public:
 	 *
 	 * @return View matrix.
 	 */
-	glm::mat4 view() const;
+	const glm::mat4& view() const;
 
 	/**
 	 * Returns a projection matrix using perspective projection.
 	 *
 	 * @returns Projection matrix.
 	 */
-	glm::mat4 projection() const;
+	const glm::mat4& projection() const;
+
+	/**
+	 * Returns the camera block, updating the cached matrices and frustum planes if the camera
+	 * changed since they were last computed. Draws should share a copy taken once per frame.
+	 *
+	 * @return Camera block.
+	 */
+	const CameraBlock& block() const;
 
 	// Mutator functions.
 	/**
@@ -133,6 +189,7 @@ public:
 	bool isFreeCameraMode() const;
 
 	void setFreeCameraMode(bool cameraMode);
+
 private:
 	/** Camera field of view. */
 	float mFOV;
@@ -154,6 +211,26 @@ private:
 	glm::vec3 mDirection;
 	/** Points in a direction perpendicular to (mPosition + mDirection) and mPosition. */
 	glm::vec3 mUp;
+
+	/** Cached derived state. */
+	mutable CameraBlock mBlock;
+	/** Whether the view matrix is out of date. */
+	mutable bool        mViewDirty;
+	/** Whether the projection matrix is out of date. */
+	mutable bool        mProjectionDirty;
+	/** Whether the products, inverses and frustum planes are out of date. */
+	mutable bool        mBlockDirty;
+
+	// Helper functions.
+	/**
+	 * Recomputes the view matrix if it is out of date.
+	 */
+	void updateView() const;
+
+	/**
+	 * Recomputes the projection matrix if it is out of date.
+	 */
+	void updateProjection() const;
 };
 
 #endif
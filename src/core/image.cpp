@@ -0,0 +1,300 @@
+/**
+ * @file image.cpp
+ *
+ * Defines image processing functions in the "image" namespace.
+ */
+#include "image.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace image {
+namespace {
+/**
+ * Returns the offset of a pixel's first channel in an image's pixels.
+ */
+std::size_t pixelOffset(const Image& image, std::uint32_t x, std::uint32_t y) {
+	return (static_cast<std::size_t>(y) * image.width + x) * image.channels;
+}
+
+/**
+ * Packs an RGB colour into 5:6:5 bits, rounding to nearest.
+ */
+std::uint16_t toRgb565(const int colour[3]) {
+	int r = (colour[0] * 31 + 127) / 255;
+	int g = (colour[1] * 63 + 127) / 255;
+	int b = (colour[2] * 31 + 127) / 255;
+	return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+/**
+ * Expands 5:6:5 bits to an RGB colour, replicating the high bits into the low ones as GPUs do.
+ */
+void fromRgb565(std::uint16_t packed, int colour[3]) {
+	int r = (packed >> 11) & 31;
+	int g = (packed >> 5) & 63;
+	int b = packed & 31;
+	colour[0] = (r << 3) | (r >> 2);
+	colour[1] = (g << 2) | (g >> 4);
+	colour[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * Fills the four-colour palette of a block from its endpoints.
+ */
+void blockPalette(std::uint16_t colour0, std::uint16_t colour1, int palette[4][3]) {
+	fromRgb565(colour0, palette[0]);
+	fromRgb565(colour1, palette[1]);
+	for (std::size_t c = 0; c < 3; ++c) {
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+}
+
+#if defined(__SSE2__)
+/**
+ * Finds the bounding box of the colours of a block, four pixels at a time.
+ */
+void colourBounds(const std::uint8_t pixels[16][4], int minimum[3], int maximum[3]) {
+	const __m128i *rows = reinterpret_cast<const __m128i *>(pixels);
+	__m128i lowest  = _mm_min_epu8(_mm_min_epu8(_mm_load_si128(rows), _mm_load_si128(rows + 1)),
+	                               _mm_min_epu8(_mm_load_si128(rows + 2), _mm_load_si128(rows + 3)));
+	__m128i highest = _mm_max_epu8(_mm_max_epu8(_mm_load_si128(rows), _mm_load_si128(rows + 1)),
+	                               _mm_max_epu8(_mm_load_si128(rows + 2), _mm_load_si128(rows + 3)));
+
+	// Fold the four pixels of each vector into the first one.
+	lowest  = _mm_min_epu8(lowest, _mm_srli_si128(lowest, 8));
+	lowest  = _mm_min_epu8(lowest, _mm_srli_si128(lowest, 4));
+	highest = _mm_max_epu8(highest, _mm_srli_si128(highest, 8));
+	highest = _mm_max_epu8(highest, _mm_srli_si128(highest, 4));
+	std::uint32_t packedMinimum = static_cast<std::uint32_t>(_mm_cvtsi128_si32(lowest));
+	std::uint32_t packedMaximum = static_cast<std::uint32_t>(_mm_cvtsi128_si32(highest));
+	for (std::size_t c = 0; c < 3; ++c) {
+		minimum[c] = static_cast<int>((packedMinimum >> (8 * c)) & 0xff);
+		maximum[c] = static_cast<int>((packedMaximum >> (8 * c)) & 0xff);
+	}
+}
+
+/**
+ * Picks the palette entry nearest to each pixel of a block, four pixels at a time, preferring the
+ * first entry on ties.
+ */
+std::uint32_t selectIndices(const std::uint8_t pixels[16][4], const int palette[4][3]) {
+	const __m128i *rows = reinterpret_cast<const __m128i *>(pixels);
+	__m128i        zero = _mm_setzero_si128();
+	__m128i        entries[4];
+	for (std::size_t p = 0; p < 4; ++p) {
+		entries[p] = _mm_setr_epi16(static_cast<short>(palette[p][0]),
+		                            static_cast<short>(palette[p][1]),
+		                            static_cast<short>(palette[p][2]), 0,
+		                            static_cast<short>(palette[p][0]),
+		                            static_cast<short>(palette[p][1]),
+		                            static_cast<short>(palette[p][2]), 0);
+	}
+
+	std::uint32_t indices = 0;
+	for (int row = 0; row < 4; ++row) {
+		// Widen the row's pixels to 16 bits, two pixels per vector.
+		__m128i pixels8 = _mm_load_si128(rows + row);
+		__m128i first   = _mm_unpacklo_epi8(pixels8, zero);
+		__m128i second  = _mm_unpackhi_epi8(pixels8, zero);
+
+		__m128i bestError = _mm_set1_epi32(0x7fffffff);
+		__m128i best      = zero;
+		for (int p = 0; p < 4; ++p) {
+			// Square and sum the differences in pairs of channels, then add the pairs of each
+			// pixel: the errors of the four pixels, in order.
+			__m128i difference0 = _mm_sub_epi16(first, entries[p]);
+			__m128i difference1 = _mm_sub_epi16(second, entries[p]);
+			__m128i sums0       = _mm_shuffle_epi32(_mm_madd_epi16(difference0, difference0),
+			                                        _MM_SHUFFLE(3, 1, 2, 0));
+			__m128i sums1       = _mm_shuffle_epi32(_mm_madd_epi16(difference1, difference1),
+			                                        _MM_SHUFFLE(3, 1, 2, 0));
+			__m128i error       = _mm_add_epi32(_mm_unpacklo_epi64(sums0, sums1),
+			                                    _mm_unpackhi_epi64(sums0, sums1));
+
+			__m128i closer = _mm_cmplt_epi32(error, bestError);
+			bestError = _mm_or_si128(_mm_and_si128(closer, error),
+			                         _mm_andnot_si128(closer, bestError));
+			best      = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(p)),
+			                         _mm_andnot_si128(closer, best));
+		}
+
+		// Gather the four 2-bit indices into the row's byte, two by two.
+		best = _mm_or_si128(best, _mm_srli_epi64(best, 30));
+		std::uint32_t rowIndices = static_cast<std::uint32_t>(_mm_cvtsi128_si32(best)) & 0x0f;
+		rowIndices |= (static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(best, 8))) &
+		               0x0f) << 4;
+		indices |= rowIndices << (8 * row);
+	}
+	return indices;
+}
+#else
+/**
+ * Finds the bounding box of the colours of a block.
+ */
+void colourBounds(const std::uint8_t pixels[16][4], int minimum[3], int maximum[3]) {
+	for (std::size_t c = 0; c < 3; ++c) {
+		minimum[c] = 255;
+		maximum[c] = 0;
+	}
+	for (std::size_t i = 0; i < 16; ++i) {
+		for (std::size_t c = 0; c < 3; ++c) {
+			minimum[c] = std::min<int>(minimum[c], pixels[i][c]);
+			maximum[c] = std::max<int>(maximum[c], pixels[i][c]);
+		}
+	}
+}
+
+/**
+ * Picks the palette entry nearest to each pixel of a block, preferring the first entry on ties.
+ */
+std::uint32_t selectIndices(const std::uint8_t pixels[16][4], const int palette[4][3]) {
+	std::uint32_t indices = 0;
+	for (std::size_t i = 0; i < 16; ++i) {
+		std::uint32_t best      = 0;
+		int           bestError = 0x7fffffff;
+		for (std::uint32_t p = 0; p < 4; ++p) {
+			int error = 0;
+			for (std::size_t c = 0; c < 3; ++c) {
+				int difference = pixels[i][c] - palette[p][c];
+				error += difference * difference;
+			}
+			if (error < bestError) {
+				best      = p;
+				bestError = error;
+			}
+		}
+		indices |= best << (2 * i);
+	}
+	return indices;
+}
+#endif
+
+/**
+ * Encodes one block of 16 pixels, each RGB followed by an unused byte.
+ */
+void encodeBlock(const std::uint8_t pixels[16][4], std::uint8_t block[BC1_BLOCK_BYTES]) {
+	// Inset the bounding box of the colours to keep the endpoints off the outliers.
+	int minimum[3];
+	int maximum[3];
+	colourBounds(pixels, minimum, maximum);
+	for (std::size_t c = 0; c < 3; ++c) {
+		int inset = (maximum[c] - minimum[c]) / 16;
+		minimum[c] += inset;
+		maximum[c] -= inset;
+	}
+
+	// The four-colour mode requires the first endpoint to be the larger one. Equal endpoints make
+	// a flat block, all of whose indices may be zero.
+	std::uint16_t colour0 = toRgb565(maximum);
+	std::uint16_t colour1 = toRgb565(minimum);
+	std::uint32_t indices = 0;
+	if (colour0 < colour1) {
+		std::swap(colour0, colour1);
+	}
+	if (colour0 != colour1) {
+		int palette[4][3];
+		blockPalette(colour0, colour1, palette);
+		indices = selectIndices(pixels, palette);
+	}
+
+	block[0] = static_cast<std::uint8_t>(colour0 & 0xff);
+	block[1] = static_cast<std::uint8_t>(colour0 >> 8);
+	block[2] = static_cast<std::uint8_t>(colour1 & 0xff);
+	block[3] = static_cast<std::uint8_t>(colour1 >> 8);
+	for (std::size_t i = 0; i < 4; ++i) {
+		block[4 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+	}
+}
+}
+
+Image downsample(const Image& source) {
+	Image target;
+	target.width    = std::max(source.width / 2, 1u);
+	target.height   = std::max(source.height / 2, 1u);
+	target.channels = source.channels;
+	target.pixels.resize(pixelOffset(target, 0, target.height));
+
+	// Average the 2x2 footprint of each target pixel, clamped to the source for 1-pixel sides.
+	for (std::uint32_t y = 0; y < target.height; ++y) {
+		std::uint32_t y0 = std::min(2 * y, source.height - 1);
+		std::uint32_t y1 = std::min(2 * y + 1, source.height - 1);
+		for (std::uint32_t x = 0; x < target.width; ++x) {
+			std::uint32_t x0 = std::min(2 * x, source.width - 1);
+			std::uint32_t x1 = std::min(2 * x + 1, source.width - 1);
+			for (std::uint32_t c = 0; c < source.channels; ++c) {
+				int sum = source.pixels[pixelOffset(source, x0, y0) + c] +
+				          source.pixels[pixelOffset(source, x1, y0) + c] +
+				          source.pixels[pixelOffset(source, x0, y1) + c] +
+				          source.pixels[pixelOffset(source, x1, y1) + c];
+				target.pixels[pixelOffset(target, x, y) + c] =
+						static_cast<std::uint8_t>((sum + 2) / 4);
+			}
+		}
+	}
+	return target;
+}
+
+std::vector<Image> mipChain(const Image& source) {
+	PROFILE_SCOPE("image::mipChain");
+
+	std::vector<Image> levels(1, source);
+	while (levels.back().width > 1 or levels.back().height > 1) {
+		levels.push_back(downsample(levels.back()));
+	}
+	return levels;
+}
+
+std::vector<std::uint8_t> encodeBC1(const Image& source) {
+	PROFILE_SCOPE("image::encodeBC1");
+
+	std::uint32_t nBlocksX = (source.width + 3) / 4;
+	std::uint32_t nBlocksY = (source.height + 3) / 4;
+	std::vector<std::uint8_t> blocks(BC1_BLOCK_BYTES * nBlocksX * nBlocksY);
+	for (std::uint32_t by = 0; by < nBlocksY; ++by) {
+		for (std::uint32_t bx = 0; bx < nBlocksX; ++bx) {
+			alignas(16) std::uint8_t pixels[16][4];
+			for (std::uint32_t i = 0; i < 16; ++i) {
+				std::uint32_t x = std::min(4 * bx + i % 4, source.width - 1);
+				std::uint32_t y = std::min(4 * by + i / 4, source.height - 1);
+				const std::uint8_t *pixel = &source.pixels[pixelOffset(source, x, y)];
+				for (std::size_t c = 0; c < 3; ++c) {
+					pixels[i][c] = pixel[c];
+				}
+				pixels[i][3] = 0;
+			}
+			std::size_t block = static_cast<std::size_t>(by) * nBlocksX + bx;
+			encodeBlock(pixels, &blocks[BC1_BLOCK_BYTES * block]);
+		}
+	}
+	return blocks;
+}
+
+Image decodeBC1(const std::vector<std::uint8_t>& blocks, std::uint32_t width,
+                std::uint32_t height) {
+	Image decoded = { width, height, 3, std::vector<std::uint8_t>() };
+	decoded.pixels.resize(pixelOffset(decoded, 0, height));
+	std::uint32_t nBlocksX = (width + 3) / 4;
+	for (std::uint32_t y = 0; y < height; ++y) {
+		for (std::uint32_t x = 0; x < width; ++x) {
+			const std::uint8_t *block =
+					&blocks[BC1_BLOCK_BYTES * (static_cast<std::size_t>(y / 4) * nBlocksX + x / 4)];
+			int palette[4][3];
+			blockPalette(static_cast<std::uint16_t>(block[0] | (block[1] << 8)),
+			             static_cast<std::uint16_t>(block[2] | (block[3] << 8)), palette);
+			std::uint32_t i     = (y % 4) * 4 + x % 4;
+			std::uint32_t index = (block[4 + i / 4] >> (2 * (i % 4))) & 3u;
+			for (std::size_t c = 0; c < 3; ++c) {
+				decoded.pixels[pixelOffset(decoded, x, y) + c] =
+						static_cast<std::uint8_t>(palette[index][c]);
+			}
+		}
+	}
+	return decoded;
+}
+}
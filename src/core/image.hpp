@@ -0,0 +1,73 @@
+/**
+ * @file image.hpp
+ *
+ * Declares image processing functions in the "image" namespace.
+ */
+#ifndef SPACE_COWBOY_IMAGE_HPP
+#define SPACE_COWBOY_IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Builds mip chains and compresses images for uploading, with no OpenGL dependency. Images are
+ * tightly packed rows of 8-bit RGB or RGBA pixels, from the first row of the file.
+ */
+namespace image {
+/** Size in bytes of a BC1 block, which encodes 4x4 RGB pixels. */
+constexpr std::size_t BC1_BLOCK_BYTES = 8;
+
+/** Image with 8-bit channels. */
+struct Image {
+	/** Width in pixels. */
+	std::uint32_t             width;
+	/** Height in pixels. */
+	std::uint32_t             height;
+	/** Number of channels, 3 for RGB or 4 for RGBA. */
+	std::uint32_t             channels;
+	/** Pixels, row by row. */
+	std::vector<std::uint8_t> pixels;
+};
+
+/**
+ * Halves an image in both dimensions with a box filter, rounding odd dimensions down to at least
+ * one pixel.
+ *
+ * @param source Image to downsample.
+ * @return Downsampled image.
+ */
+Image downsample(const Image& source);
+
+/**
+ * Builds the mip chain of an image, down to 1x1.
+ *
+ * @param source Full resolution image.
+ * @return Levels of the chain, the first being the source itself.
+ */
+std::vector<Image> mipChain(const Image& source);
+
+/**
+ * Compresses an image to BC1 (DXT1) in its opaque four-colour mode, fitting each block's two
+ * endpoints to the bounding box of its colours inset by a sixteenth. Blocks past the edges of the
+ * image repeat its last row and column. The alpha channel, if any, is dropped. Uses SSE2 where
+ * available, four pixels at a time, with the same results.
+ *
+ * @param source Image to compress.
+ * @return Blocks, row by row, of ceil(width / 4) * ceil(height / 4) * BC1_BLOCK_BYTES bytes.
+ */
+std::vector<std::uint8_t> encodeBC1(const Image& source);
+
+/**
+ * Decodes BC1 blocks back to RGB pixels.
+ *
+ * @param blocks Blocks as encodeBC1 returns them.
+ * @param width Width of the image in pixels.
+ * @param height Height of the image in pixels.
+ * @return Decoded RGB image.
+ */
+Image decodeBC1(const std::vector<std::uint8_t>& blocks, std::uint32_t width,
+                std::uint32_t height);
+}
+
+#endif
@@ -0,0 +1,232 @@
+/**
+ * @file input_recorder.cpp
+ *
+ * Implementation file for the InputRecorder class.
+ */
+#include "input_recorder.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+/** Magic number at the start of a recording. */
+constexpr char           MAGIC[4]      = { 'S', 'C', 'I', 'R' };
+/** Version of the recording format. */
+constexpr std::uint32_t  VERSION       = 1;
+/** Size of a tick without events in bytes. */
+constexpr std::streamoff MIN_TICK_SIZE = sizeof(double) + sizeof(std::uint16_t);
+
+/** Events of an empty tick. */
+const std::vector<InputRecorder::Event> NO_EVENTS;
+
+/**
+ * Writes a value to a binary stream in native byte order.
+ */
+template <typename T>
+void writeValue(std::ostream& out, T value) {
+	out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Reads a value from a binary stream in native byte order.
+ *
+ * @throws std::runtime_error if the stream ended.
+ */
+template <typename T>
+T readValue(std::istream& in) {
+	T value;
+	if (not in.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+		throw std::runtime_error("Input recording is truncated.");
+	}
+	return value;
+}
+}
+
+// Redeclare constant static data members.
+constexpr int InputRecorder::N_KEY_CODES;
+
+// Constructors.
+InputRecorder::InputRecorder() :
+		mMode(OFF),
+		mSeed(0),
+		mNTicksPlayed(0) { }
+
+// Destructors.
+InputRecorder::~InputRecorder() {
+	try {
+		finish();
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Warning: " << e.what() << std::endl;
+	}
+}
+
+// Accessor functions.
+InputRecorder::Mode InputRecorder::mode() const {
+	return mMode;
+}
+
+bool InputRecorder::replaying() const {
+	return mMode == REPLAYING;
+}
+
+bool InputRecorder::replayFinished() const {
+	return mMode == REPLAYING and mNTicksPlayed >= mTicks.size();
+}
+
+std::uint32_t InputRecorder::seed() const {
+	return mSeed;
+}
+
+const std::vector<InputRecorder::Event>& InputRecorder::tickEvents() const {
+	if (mMode != REPLAYING or mNTicksPlayed == 0) {
+		return NO_EVENTS;
+	}
+	return mTicks[mNTicksPlayed - 1].events;
+}
+
+// Mutator functions.
+void InputRecorder::startRecording(const std::string& path, std::uint32_t seed) {
+	mMode = RECORDING;
+	mPath = path;
+	mSeed = seed;
+	mTicks.clear();
+}
+
+void InputRecorder::startReplay(const std::string& path) {
+	std::ifstream in(path, std::ios::binary);
+	if (not in) {
+		throw std::runtime_error("Could not open input recording " + path + ".");
+	}
+
+	char magic[4];
+	in.read(magic, sizeof(magic));
+	if (not in or not std::equal(magic, magic + 4, MAGIC)) {
+		throw std::runtime_error(path + " is not an input recording.");
+	}
+	if (readValue<std::uint32_t>(in) != VERSION) {
+		throw std::runtime_error("Unsupported input recording version in " + path + ".");
+	}
+
+	mSeed = readValue<std::uint32_t>(in);
+
+	// Bound the number of ticks by the bytes left before allocating them.
+	std::uint32_t  nTicks   = readValue<std::uint32_t>(in);
+	std::streamoff position = in.tellg();
+	std::streamoff end      = in.seekg(0, std::ios::end).tellg();
+	in.seekg(position);
+	if ((end - position) / MIN_TICK_SIZE < nTicks) {
+		throw std::runtime_error("Input recording " + path + " is truncated.");
+	}
+	mTicks.resize(nTicks);
+	for (Tick& tick : mTicks) {
+		tick.deltaTime = readValue<double>(in);
+		tick.events.resize(readValue<std::uint16_t>(in));
+		for (Event& event : tick.events) {
+			event = Event();
+			event.type = static_cast<EventType>(readValue<std::uint8_t>(in));
+			switch (event.type) {
+				case KEY:
+					event.code   = readValue<std::int16_t>(in);
+					event.action = readValue<std::uint8_t>(in);
+					event.mods   = readValue<std::uint8_t>(in);
+					if (event.code < 0 or event.code >= N_KEY_CODES) {
+						throw std::runtime_error("Invalid key code in input recording " + path +
+						                         ".");
+					}
+					break;
+				case MOUSE_BUTTON:
+					event.code   = readValue<std::uint8_t>(in);
+					event.action = readValue<std::uint8_t>(in);
+					event.mods   = readValue<std::uint8_t>(in);
+					break;
+				case CURSOR:
+				case SCROLL:
+					event.x = readValue<double>(in);
+					event.y = readValue<double>(in);
+					break;
+				default:
+					throw std::runtime_error("Unknown event type in input recording " + path +
+					                         ".");
+			}
+		}
+	}
+
+	mMode         = REPLAYING;
+	mPath         = path;
+	mNTicksPlayed = 0;
+}
+
+double InputRecorder::beginTick(double liveDeltaTime) {
+	switch (mMode) {
+		case RECORDING:
+			mTicks.push_back({ liveDeltaTime, {} });
+			return liveDeltaTime;
+		case REPLAYING:
+			if (mNTicksPlayed < mTicks.size()) {
+				return mTicks[mNTicksPlayed++].deltaTime;
+			}
+			return 0.0;
+		default:
+			return liveDeltaTime;
+	}
+}
+
+void InputRecorder::record(const Event& event) {
+	// Events can only arrive while polling inside a tick. The event count of a tick is stored in 16
+	// bits, which is far more than a frame's worth of input.
+	if (mMode != RECORDING or mTicks.empty() or
+	    mTicks.back().events.size() == std::numeric_limits<std::uint16_t>::max()) {
+		return;
+	}
+	mTicks.back().events.push_back(event);
+}
+
+void InputRecorder::finish() {
+	if (mMode != RECORDING) {
+		return;
+	}
+	mMode = OFF;
+
+	std::ofstream out(mPath, std::ios::binary);
+	if (not out) {
+		throw std::runtime_error("Could not write input recording " + mPath + ".");
+	}
+
+	out.write(MAGIC, sizeof(MAGIC));
+	writeValue<std::uint32_t>(out, VERSION);
+	writeValue<std::uint32_t>(out, mSeed);
+	writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(mTicks.size()));
+	for (const Tick& tick : mTicks) {
+		writeValue<double>(out, tick.deltaTime);
+		writeValue<std::uint16_t>(out, static_cast<std::uint16_t>(tick.events.size()));
+		for (const Event& event : tick.events) {
+			writeValue<std::uint8_t>(out, event.type);
+			switch (event.type) {
+				case KEY:
+					writeValue<std::int16_t>(out, static_cast<std::int16_t>(event.code));
+					writeValue<std::uint8_t>(out, static_cast<std::uint8_t>(event.action));
+					writeValue<std::uint8_t>(out, static_cast<std::uint8_t>(event.mods));
+					break;
+				case MOUSE_BUTTON:
+					writeValue<std::uint8_t>(out, static_cast<std::uint8_t>(event.code));
+					writeValue<std::uint8_t>(out, static_cast<std::uint8_t>(event.action));
+					writeValue<std::uint8_t>(out, static_cast<std::uint8_t>(event.mods));
+					break;
+				case CURSOR:
+				case SCROLL:
+					writeValue<double>(out, event.x);
+					writeValue<double>(out, event.y);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+
+	std::cout << "Input recording of " << mTicks.size() << " ticks written to " << mPath << "."
+	          << std::endl;
+}
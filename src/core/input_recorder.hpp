@@ -0,0 +1,174 @@
+/**
+ * @file input_recorder.hpp
+ *
+ * Interface file for the InputRecorder class.
+ */
+#ifndef SPACE_COWBOY_INPUT_RECORDER_HPP
+#define SPACE_COWBOY_INPUT_RECORDER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Records the input events of a session, together with the world seed and the duration of every
+ * simulation tick, and plays them back. Since the world is generated from the seed and the game state
+ * is advanced only by the simulation clock and input events, replaying a recording reproduces the
+ * recorded session exactly, which makes it suitable for profiling and before/after comparisons.
+ *
+ * Recordings are stored in a compact binary file in native byte order:
+ *   header: magic "SCIR", uint32 version, uint32 world seed, uint32 number of ticks
+ *   tick:   double duration in seconds, uint16 number of events, events
+ *   event:  uint8 type, followed by
+ *             key:          int16 key, uint8 action, uint8 modifiers
+ *             mouse button: uint8 button, uint8 action, uint8 modifiers
+ *             cursor/scroll: double x, double y
+ */
+class InputRecorder {
+public:
+	/** Whether the recorder is idle, recording or replaying. */
+	enum Mode {
+		OFF,
+		RECORDING,
+		REPLAYING
+	};
+
+	/** Types of recorded input events. */
+	enum EventType : std::uint8_t {
+		KEY,
+		CURSOR,
+		MOUSE_BUTTON,
+		SCROLL
+	};
+
+	/** A GLFW input event. */
+	struct Event {
+		/** Type of the event. */
+		EventType type;
+		/** Key or mouse button. */
+		int       code;
+		/** Key or mouse button action. */
+		int       action;
+		/** Modifier key bits. */
+		int       mods;
+		/** Cursor x position or horizontal scroll offset. */
+		double    x;
+		/** Cursor y position or vertical scroll offset. */
+		double    y;
+	};
+
+	// Constants.
+	/** Number of key codes. Recorded keys are in [0, N_KEY_CODES). */
+	static constexpr int N_KEY_CODES = 1024;
+
+	// Constructors.
+	/**
+	 * Creates an idle recorder.
+	 */
+	InputRecorder();
+
+	/**
+	 * Copy constructor is disabled as a recording is written exactly once.
+	 */
+	InputRecorder(const InputRecorder&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as a recording is written exactly once.
+	 */
+	void operator=(const InputRecorder&) = delete;
+
+	// Destructors.
+	/**
+	 * Writes the recording if it was not written with finish.
+	 */
+	~InputRecorder();
+
+	// Accessor functions.
+	/**
+	 * Returns whether the recorder is idle, recording or replaying.
+	 */
+	Mode mode() const;
+
+	/**
+	 * Returns true iff a recording is being replayed.
+	 */
+	bool replaying() const;
+
+	/**
+	 * Returns true iff a replay has played back all of its ticks.
+	 */
+	bool replayFinished() const;
+
+	/**
+	 * Returns the world seed of the recording.
+	 */
+	std::uint32_t seed() const;
+
+	/**
+	 * Returns the recorded events of the current tick when replaying.
+	 */
+	const std::vector<Event>& tickEvents() const;
+
+	// Mutator functions.
+	/**
+	 * Starts recording a session.
+	 *
+	 * @param path Path of the recording, written by finish.
+	 * @param seed World seed of the session.
+	 */
+	void startRecording(const std::string& path, std::uint32_t seed);
+
+	/**
+	 * Loads a recording and starts replaying it.
+	 *
+	 * @param path Path of the recording.
+	 * @throws std::runtime_error if the recording could not be read, or holds a key code outside
+	 *                            [0, N_KEY_CODES).
+	 */
+	void startReplay(const std::string& path);
+
+	/**
+	 * Starts the next simulation tick. When recording, the live tick duration is recorded; when
+	 * replaying, it is replaced by the recorded duration and the tick's events become available
+	 * through tickEvents.
+	 *
+	 * @param liveDeltaTime Measured duration of the tick in seconds.
+	 * @return Duration of the tick the simulation should advance by.
+	 */
+	double beginTick(double liveDeltaTime);
+
+	/**
+	 * Records an input event in the current tick. Does nothing unless recording.
+	 *
+	 * @param event Input event.
+	 */
+	void record(const Event& event);
+
+	/**
+	 * Writes the recording if recording. Subsequent calls do nothing.
+	 *
+	 * @throws std::runtime_error if the recording could not be written.
+	 */
+	void finish();
+
+private:
+	/** Duration and input events of one simulation tick. */
+	struct Tick {
+		double             deltaTime;
+		std::vector<Event> events;
+	};
+
+	// Data members.
+	/** Current mode. */
+	Mode              mMode;
+	/** Path of the recording. */
+	std::string       mPath;
+	/** World seed. */
+	std::uint32_t     mSeed;
+	/** Recorded ticks. */
+	std::vector<Tick> mTicks;
+	/** Number of ticks played back so far when replaying. */
+	std::size_t       mNTicksPlayed;
+};
+
+#endif
@@ -0,0 +1,425 @@
+/**
+ * @file mesh_lod.cpp
+ *
+ * Implementation file for mesh welding, simplification and level of detail generation.
+ */
+#include "mesh_lod.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+/** Fraction of the previous level's triangles each level is simplified to. */
+constexpr double LEVEL_RATIO     = 0.5;
+/** Fraction of the previous level's triangles below which a level must fall to be kept. */
+constexpr double MIN_LEVEL_RATIO = 0.8;
+/** Marks a vertex without a twin. */
+constexpr std::uint32_t NO_VERTEX = 0xffffffffu;
+
+/** Vertex attributes as a hashable key, compared bitwise. */
+struct VertexKey {
+	float values[8];
+
+	bool operator==(const VertexKey& other) const {
+		return std::memcmp(values, other.values, sizeof(values)) == 0;
+	}
+};
+
+/** Hashes vertex attributes. */
+struct VertexKeyHash {
+	std::size_t operator()(const VertexKey& key) const {
+		std::uint32_t bits[8];
+		std::memcpy(bits, key.values, sizeof(bits));
+		std::uint64_t hash = 0;
+		for (std::uint32_t word : bits) {
+			hash = (hash ^ word) * 0x100000001b3ULL;
+		}
+		return std::hash<std::uint64_t>()(hash);
+	}
+};
+
+/** Position as a hashable key, compared bitwise. */
+struct PositionKey {
+	float values[3];
+
+	bool operator==(const PositionKey& other) const {
+		return std::memcmp(values, other.values, sizeof(values)) == 0;
+	}
+};
+
+/** Hashes positions. */
+struct PositionKeyHash {
+	std::size_t operator()(const PositionKey& key) const {
+		std::uint32_t bits[3];
+		std::memcpy(bits, key.values, sizeof(bits));
+		std::uint64_t hash = 0;
+		for (std::uint32_t word : bits) {
+			hash = (hash ^ word) * 0x100000001b3ULL;
+		}
+		return std::hash<std::uint64_t>()(hash);
+	}
+};
+
+/**
+ * Symmetric 4x4 matrix summing the squared distances to a set of planes, stored as its upper
+ * triangle.
+ */
+struct Quadric {
+	double a[10];
+
+	Quadric() : a() {
+	}
+
+	/** Adds the plane n.p + d = 0, weighted. */
+	void addPlane(const glm::dvec3& n, double d, double weight) {
+		a[0] += weight * n.x * n.x; a[1] += weight * n.x * n.y; a[2] += weight * n.x * n.z;
+		a[3] += weight * n.x * d;   a[4] += weight * n.y * n.y; a[5] += weight * n.y * n.z;
+		a[6] += weight * n.y * d;   a[7] += weight * n.z * n.z; a[8] += weight * n.z * d;
+		a[9] += weight * d * d;
+	}
+
+	Quadric& operator+=(const Quadric& other) {
+		for (std::size_t i = 0; i < 10; ++i) {
+			a[i] += other.a[i];
+		}
+		return *this;
+	}
+
+	/** Returns the weighted sum of the squared distances of a point to the planes. */
+	double error(const glm::dvec3& p) const {
+		return a[0] * p.x * p.x + 2.0 * a[1] * p.x * p.y + 2.0 * a[2] * p.x * p.z +
+		       2.0 * a[3] * p.x + a[4] * p.y * p.y + 2.0 * a[5] * p.y * p.z + 2.0 * a[6] * p.y +
+		       a[7] * p.z * p.z + 2.0 * a[8] * p.z + a[9];
+	}
+};
+
+/** Candidate merge of a vertex into a neighbour. */
+struct Collapse {
+	/** Quadric error of the merged vertex. */
+	double        cost;
+	/** Vertex removed. */
+	std::uint32_t from;
+	/** Vertex kept. */
+	std::uint32_t to;
+	/** Versions of both vertices when the collapse was evaluated. */
+	std::uint32_t fromVersion;
+	std::uint32_t toVersion;
+
+	bool operator>(const Collapse& other) const {
+		return cost > other.cost;
+	}
+};
+
+/**
+ * Returns the unnormalized normal of a triangle.
+ */
+glm::dvec3 triangleNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+	return glm::cross(glm::dvec3(b - a), glm::dvec3(c - a));
+}
+}
+
+LodMesh weldMesh(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                 const std::vector<glm::vec2>& uvs) {
+	PROFILE_SCOPE("weldMesh");
+
+	LodMesh mesh;
+	mesh.levels.emplace_back();
+	std::vector<std::uint32_t>& indices = mesh.levels.front();
+	indices.reserve(vertices.size());
+
+	std::unordered_map<VertexKey, std::uint32_t, VertexKeyHash> indexOf;
+	indexOf.reserve(vertices.size());
+	for (std::size_t i = 0; i < vertices.size(); ++i) {
+		glm::vec3 normal = i < normals.size() ? normals[i] : glm::vec3(0.0f, 0.0f, 1.0f);
+		glm::vec2 uv     = i < uvs.size() ? uvs[i] : glm::vec2(0.0f);
+		VertexKey key    = { { vertices[i].x, vertices[i].y, vertices[i].z, normal.x, normal.y,
+		                       normal.z, uv.x, uv.y } };
+		auto inserted = indexOf.emplace(key, static_cast<std::uint32_t>(mesh.positions.size()));
+		if (inserted.second) {
+			mesh.positions.push_back(vertices[i]);
+			mesh.normals.push_back(normal);
+			mesh.uvs.push_back(uv);
+		}
+		indices.push_back(inserted.first->second);
+	}
+	return mesh;
+}
+
+std::vector<std::uint32_t> simplifyMesh(const LodMesh& mesh,
+                                        const std::vector<std::uint32_t>& indices,
+                                        std::size_t targetTriangles) {
+	PROFILE_SCOPE("simplifyMesh");
+
+	const std::vector<glm::vec3>& positions = mesh.positions;
+	std::size_t nVertices  = positions.size();
+	std::size_t nTriangles = indices.size() / 3;
+	std::vector<std::uint32_t> triangles(indices.begin(), indices.end());
+	triangles.resize(3 * nTriangles);
+
+	// Pair up the vertices sharing their position, which lie on a UV or normal seam: a seam vertex
+	// may only slide along the seam, together with its twin on the other side. Lock the vertices
+	// where more than two sides of a seam meet.
+	std::vector<std::uint32_t> twins(nVertices, NO_VERTEX);
+	std::vector<bool>          locked(nVertices, false);
+	std::vector<std::uint32_t> positionOf(nVertices);
+	std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> firstAt;
+	firstAt.reserve(nVertices);
+	for (std::uint32_t v = 0; v < nVertices; ++v) {
+		PositionKey key = { { positions[v].x, positions[v].y, positions[v].z } };
+		auto inserted = firstAt.emplace(key, v);
+		std::uint32_t first = inserted.first->second;
+		positionOf[v] = first;
+		if (inserted.second) {
+			continue;
+		}
+		if (twins[first] == NO_VERTEX and not locked[first]) {
+			twins[first] = v;
+			twins[v]     = first;
+		}
+		else {
+			locked[v]     = true;
+			locked[first] = true;
+			if (twins[first] != NO_VERTEX) {
+				locked[twins[first]] = true;
+			}
+		}
+	}
+
+	// Accumulate the area-weighted planes of the triangles around each vertex, and list the
+	// triangles using each vertex.
+	std::vector<Quadric> quadrics(nVertices);
+	std::vector<std::vector<std::uint32_t>> vertexTriangles(nVertices);
+	for (std::uint32_t t = 0; t < nTriangles; ++t) {
+		const std::uint32_t *v = &triangles[3 * t];
+		glm::dvec3 normal = triangleNormal(positions[v[0]], positions[v[1]], positions[v[2]]);
+		double     length = glm::length(normal);
+		if (length > 0.0) {
+			normal /= length;
+			double d = -glm::dot(normal, glm::dvec3(positions[v[0]]));
+			for (std::size_t i = 0; i < 3; ++i) {
+				quadrics[v[i]].addPlane(normal, d, 0.5 * length);
+			}
+		}
+		for (std::size_t i = 0; i < 3; ++i) {
+			vertexTriangles[v[i]].push_back(t);
+		}
+	}
+
+	std::vector<bool>          removedTriangles(nTriangles, false);
+	std::vector<bool>          removedVertices(nVertices, false);
+	std::vector<std::uint32_t> versions(nVertices, 0);
+
+	// Returns the number of remaining triangles along an edge.
+	auto sharedTriangles = [&](std::uint32_t a, std::uint32_t b) {
+		std::size_t shared = 0;
+		for (std::uint32_t t : vertexTriangles[a]) {
+			const std::uint32_t *v = &triangles[3 * t];
+			if (not removedTriangles[t] and (v[0] == b or v[1] == b or v[2] == b)) {
+				++shared;
+			}
+		}
+		return shared;
+	};
+
+	// Lock the vertices on open boundaries, outside of seams.
+	for (std::uint32_t v = 0; v < nVertices; ++v) {
+		for (std::uint32_t t : vertexTriangles[v]) {
+			for (std::size_t i = 0; i < 3 and not locked[v] and twins[v] == NO_VERTEX; ++i) {
+				std::uint32_t neighbour = triangles[3 * t + i];
+				locked[v] = neighbour != v and sharedTriangles(v, neighbour) == 1;
+			}
+		}
+	}
+
+	// Returns the twin a seam vertex moves to along with it, NO_VERTEX if it has none, or the
+	// vertex itself if the collapse would tear the seam.
+	auto twinCollapse = [&](std::uint32_t from, std::uint32_t to) {
+		std::uint32_t twin = twins[from];
+		if (twin == NO_VERTEX) {
+			return NO_VERTEX;
+		}
+		if (twins[to] == NO_VERTEX or sharedTriangles(from, to) != 1 or
+		    sharedTriangles(twin, twins[to]) != 1) {
+			return from;
+		}
+		return twin;
+	};
+
+	// Returns whether a collapse would flip a triangle that survives it.
+	auto flips = [&](std::uint32_t from, std::uint32_t to) {
+		for (std::uint32_t t : vertexTriangles[from]) {
+			const std::uint32_t *v = &triangles[3 * t];
+			if (removedTriangles[t] or v[0] == to or v[1] == to or v[2] == to) {
+				continue;
+			}
+			glm::vec3 moved[3];
+			for (std::size_t i = 0; i < 3; ++i) {
+				moved[i] = positions[v[i] == from ? to : v[i]];
+			}
+			glm::dvec3 before = triangleNormal(positions[v[0]], positions[v[1]], positions[v[2]]);
+			glm::dvec3 after  = triangleNormal(moved[0], moved[1], moved[2]);
+			if (glm::dot(before, after) <= 0.0) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// Returns whether a collapse would glue the surface into non-manifold edges, which happens when
+	// both positions share a neighbour that no triangle along their edge accounts for. Seams are
+	// seen through, comparing positions rather than vertices.
+	auto pinches = [&](std::uint32_t from, std::uint32_t to) {
+		std::vector<std::uint32_t> neighbours[2];
+		std::uint32_t ends[2]  = { from, to };
+		std::size_t   alongEdge = sharedTriangles(from, to);
+		if (twins[from] != NO_VERTEX and twins[to] != NO_VERTEX) {
+			alongEdge += sharedTriangles(twins[from], twins[to]);
+		}
+		for (std::size_t end = 0; end < 2; ++end) {
+			for (std::uint32_t vertex : { ends[end], twins[ends[end]] }) {
+				if (vertex == NO_VERTEX) {
+					continue;
+				}
+				for (std::uint32_t t : vertexTriangles[vertex]) {
+					for (std::size_t i = 0; i < 3 and not removedTriangles[t]; ++i) {
+						neighbours[end].push_back(positionOf[triangles[3 * t + i]]);
+					}
+				}
+			}
+			std::sort(neighbours[end].begin(), neighbours[end].end());
+			neighbours[end].erase(std::unique(neighbours[end].begin(), neighbours[end].end()),
+			                      neighbours[end].end());
+		}
+		std::vector<std::uint32_t> common;
+		std::set_intersection(neighbours[0].begin(), neighbours[0].end(), neighbours[1].begin(),
+		                      neighbours[1].end(), std::back_inserter(common));
+		// The common neighbours include both positions themselves.
+		return common.size() - 2 != alongEdge;
+	};
+
+	// Returns the quadric error of the vertex a collapse keeps.
+	auto error = [&](std::uint32_t from, std::uint32_t to) {
+		Quadric merged = quadrics[from];
+		merged += quadrics[to];
+		return merged.error(glm::dvec3(positions[to]));
+	};
+
+	// Queue the collapses along every edge, cheapest first. A collapse goes stale when either
+	// vertex changes, which its versions record, and twins change together.
+	std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+	auto push = [&](std::uint32_t from, std::uint32_t to) {
+		std::uint32_t twin = locked[from] ? from : twinCollapse(from, to);
+		if (twin == from) {
+			return;
+		}
+		double cost = error(from, to) + (twin == NO_VERTEX ? 0.0 : error(twin, twins[to]));
+		collapses.push({ cost, from, to, versions[from], versions[to] });
+	};
+	auto requeue = [&](std::uint32_t vertex) {
+		std::vector<std::uint32_t>& around = vertexTriangles[vertex];
+		around.erase(std::remove_if(around.begin(), around.end(), [&](std::uint32_t t) {
+			return removedTriangles[t];
+		}), around.end());
+		for (std::uint32_t t : around) {
+			for (std::size_t i = 0; i < 3; ++i) {
+				std::uint32_t neighbour = triangles[3 * t + i];
+				if (neighbour != vertex) {
+					push(neighbour, vertex);
+					push(vertex, neighbour);
+				}
+			}
+		}
+	};
+	for (std::size_t t = 0; t < nTriangles; ++t) {
+		for (std::size_t e = 0; e < 3; ++e) {
+			push(triangles[3 * t + e], triangles[3 * t + (e + 1) % 3]);
+			push(triangles[3 * t + (e + 1) % 3], triangles[3 * t + e]);
+		}
+	}
+
+	// Merges a vertex into a neighbour, removing the triangles along their edge and handing the
+	// others over to the kept vertex.
+	std::size_t remaining = nTriangles;
+	auto merge = [&](std::uint32_t from, std::uint32_t to) {
+		for (std::uint32_t t : vertexTriangles[from]) {
+			std::uint32_t *v = &triangles[3 * t];
+			if (removedTriangles[t]) {
+				continue;
+			}
+			if (v[0] == to or v[1] == to or v[2] == to) {
+				removedTriangles[t] = true;
+				--remaining;
+				continue;
+			}
+			for (std::size_t i = 0; i < 3; ++i) {
+				if (v[i] == from) {
+					v[i] = to;
+				}
+			}
+			vertexTriangles[to].push_back(t);
+		}
+		removedVertices[from] = true;
+		quadrics[to]         += quadrics[from];
+		vertexTriangles[from].clear();
+		++versions[to];
+	};
+
+	while (remaining > targetTriangles and not collapses.empty()) {
+		Collapse collapse = collapses.top();
+		collapses.pop();
+		std::uint32_t from = collapse.from;
+		std::uint32_t to   = collapse.to;
+		if (removedVertices[from] or removedVertices[to] or
+		    collapse.fromVersion != versions[from] or collapse.toVersion != versions[to]) {
+			continue;
+		}
+
+		// The neighbourhood may have changed since the collapse was queued, so check it again.
+		std::uint32_t twin = twinCollapse(from, to);
+		if (twin == from or flips(from, to) or pinches(from, to) or
+		    (twin != NO_VERTEX and (flips(twin, twins[to]) or pinches(twin, twins[to])))) {
+			continue;
+		}
+		merge(from, to);
+		requeue(to);
+		if (twin != NO_VERTEX) {
+			merge(twin, twins[to]);
+			requeue(twins[to]);
+		}
+	}
+
+	std::vector<std::uint32_t> simplified;
+	simplified.reserve(3 * remaining);
+	for (std::size_t t = 0; t < nTriangles; ++t) {
+		if (not removedTriangles[t]) {
+			simplified.insert(simplified.end(), &triangles[3 * t], &triangles[3 * t] + 3);
+		}
+	}
+	return simplified;
+}
+
+LodMesh generateLods(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                     const std::vector<glm::vec2>& uvs, std::size_t maxLevels) {
+	PROFILE_SCOPE("generateLods");
+
+	LodMesh mesh = weldMesh(vertices, normals, uvs);
+	while (mesh.levels.size() < maxLevels) {
+		const std::vector<std::uint32_t>& previous = mesh.levels.back();
+		std::size_t nTriangles = previous.size() / 3;
+		std::vector<std::uint32_t> level =
+				simplifyMesh(mesh, previous, static_cast<std::size_t>(nTriangles * LEVEL_RATIO));
+		if (level.empty() or level.size() / 3 > nTriangles * MIN_LEVEL_RATIO) {
+			break;
+		}
+		mesh.levels.push_back(std::move(level));
+	}
+	return mesh;
+}
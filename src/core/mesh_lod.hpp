@@ -0,0 +1,71 @@
+/**
+ * @file mesh_lod.hpp
+ *
+ * Interface file for mesh welding, simplification and level of detail generation.
+ */
+#ifndef SPACE_COWBOY_MESH_LOD_HPP
+#define SPACE_COWBOY_MESH_LOD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * Indexed triangle mesh with levels of detail. Every level indexes the same vertices, so that the
+ * levels can share one vertex buffer and only differ in the range of the element buffer drawn.
+ */
+struct LodMesh {
+	/** Position of each vertex. */
+	std::vector<glm::vec3>                  positions;
+	/** Normal of each vertex. */
+	std::vector<glm::vec3>                  normals;
+	/** Texture coordinates of each vertex. */
+	std::vector<glm::vec2>                  uvs;
+	/** Triangle indices of each level, from full detail to the coarsest. */
+	std::vector<std::vector<std::uint32_t>> levels;
+};
+
+/**
+ * Merges the identical vertices of a triangle soup, such as loadOBJ returns, into an indexed mesh
+ * with a single level.
+ *
+ * @param vertices Position of each vertex of the triangles.
+ * @param normals Normal of each vertex.
+ * @param uvs Texture coordinates of each vertex.
+ * @return Indexed mesh.
+ */
+LodMesh weldMesh(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                 const std::vector<glm::vec2>& uvs);
+
+/**
+ * Simplifies triangles of a mesh by collapsing edges in order of their quadric error, each vertex
+ * being merged into a neighbour. A vertex sharing its position with another, on a UV or normal
+ * seam, only slides along the seam together with its twin, so the seams stay closed; vertices where
+ * more seams meet and vertices on open boundaries never move. Collapses that would flip a triangle
+ * or make an edge non-manifold are skipped. Stops at the target triangle count or when no collapse
+ * remains.
+ *
+ * @param mesh Mesh whose vertices the triangles index.
+ * @param indices Triangles to simplify.
+ * @param targetTriangles Number of triangles to simplify down to.
+ * @return Simplified triangles, indexing the mesh's vertices.
+ */
+std::vector<std::uint32_t> simplifyMesh(const LodMesh& mesh,
+                                        const std::vector<std::uint32_t>& indices,
+                                        std::size_t targetTriangles);
+
+/**
+ * Welds a triangle soup and generates its levels of detail, each simplified from the previous one
+ * to half its triangles. Stops early once a level no longer shrinks noticeably.
+ *
+ * @param vertices Position of each vertex of the triangles.
+ * @param normals Normal of each vertex.
+ * @param uvs Texture coordinates of each vertex.
+ * @param maxLevels Largest number of levels, including the full detail one.
+ * @return Indexed mesh with its levels.
+ */
+LodMesh generateLods(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                     const std::vector<glm::vec2>& uvs, std::size_t maxLevels);
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file mesh_optimize.cpp
+ *
+ * Implementation file for reordering indexed meshes for the GPU's vertex cache and vertex fetch.
+ */
+#include "mesh_optimize.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+namespace {
+// Vertex cache optimization constants, as tuned by Forsyth.
+/** Number of vertices of the modelled cache. */
+constexpr std::size_t CACHE_SIZE          = 32;
+/** Score of the vertices of the last emitted triangle. */
+constexpr float       LAST_TRIANGLE_SCORE = 0.75f;
+/** Power with which the score of a cached vertex decays with its cache position. */
+constexpr float       CACHE_DECAY_POWER   = 1.5f;
+/** Scale of the bonus of vertices with few triangles left. */
+constexpr float       VALENCE_BOOST_SCALE = 2.0f;
+/** Power with which the bonus decays with the number of triangles left. */
+constexpr float       VALENCE_BOOST_POWER = -0.5f;
+
+/** Marks a vertex outside the cache or the absence of a triangle. */
+constexpr std::uint32_t NONE = 0xffffffffu;
+
+/**
+ * Returns the score of a vertex from its position in the cache and its number of triangles left.
+ */
+float vertexScore(std::uint32_t cachePosition, std::uint32_t nTrianglesLeft) {
+	if (nTrianglesLeft == 0) {
+		return -1.0f;
+	}
+	float score = 0.0f;
+	if (cachePosition != NONE) {
+		if (cachePosition < 3) {
+			score = LAST_TRIANGLE_SCORE;
+		}
+		else {
+			float scaler = 1.0f / (CACHE_SIZE - 3);
+			score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+		}
+	}
+	return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(nTrianglesLeft),
+	                                              VALENCE_BOOST_POWER);
+}
+}
+
+std::vector<std::uint32_t> optimizeVertexCache(const std::vector<std::uint32_t>& indices,
+                                               std::size_t nVertices) {
+	PROFILE_SCOPE("optimizeVertexCache");
+
+	std::size_t nTriangles = indices.size() / 3;
+
+	// List the triangles of each vertex, packed by vertex.
+	std::vector<std::uint32_t> nTrianglesLeft(nVertices, 0);
+	for (std::size_t i = 0; i < 3 * nTriangles; ++i) {
+		++nTrianglesLeft[indices[i]];
+	}
+	std::vector<std::uint32_t> firstTriangle(nVertices + 1, 0);
+	for (std::size_t v = 0; v < nVertices; ++v) {
+		firstTriangle[v + 1] = firstTriangle[v] + nTrianglesLeft[v];
+	}
+	std::vector<std::uint32_t> vertexTriangles(3 * nTriangles);
+	std::vector<std::uint32_t> filled(firstTriangle.begin(), firstTriangle.end() - 1);
+	for (std::size_t i = 0; i < 3 * nTriangles; ++i) {
+		vertexTriangles[filled[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+	}
+
+	std::vector<std::uint32_t> cachePositions(nVertices, NONE);
+	std::vector<float>         vertexScores(nVertices);
+	for (std::size_t v = 0; v < nVertices; ++v) {
+		vertexScores[v] = vertexScore(NONE, nTrianglesLeft[v]);
+	}
+	std::vector<float> triangleScores(nTriangles);
+	std::vector<bool>  emitted(nTriangles, false);
+	for (std::size_t t = 0; t < nTriangles; ++t) {
+		triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] +
+		                    vertexScores[indices[3 * t + 2]];
+	}
+
+	std::vector<std::uint32_t> optimized;
+	optimized.reserve(3 * nTriangles);
+	std::vector<std::uint32_t> cache;
+	std::uint32_t bestTriangle = NONE;
+	std::size_t   nextScan     = 0;
+	while (optimized.size() < 3 * nTriangles) {
+		// Fall back on the first triangle left when no cached vertex has any.
+		if (bestTriangle == NONE) {
+			while (emitted[nextScan]) {
+				++nextScan;
+			}
+			bestTriangle = static_cast<std::uint32_t>(nextScan);
+		}
+
+		// Emit the triangle and remove it from its vertices' lists.
+		emitted[bestTriangle] = true;
+		const std::uint32_t *triangle = &indices[3 * bestTriangle];
+		optimized.insert(optimized.end(), triangle, triangle + 3);
+		for (std::size_t i = 0; i < 3; ++i) {
+			std::uint32_t  v     = triangle[i];
+			std::uint32_t *begin = &vertexTriangles[firstTriangle[v]];
+			std::uint32_t *end   = begin + nTrianglesLeft[v];
+			std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+			--nTrianglesLeft[v];
+		}
+
+		// Move the triangle's vertices to the front of the cache; the vertices pushed out of it
+		// are rescored too.
+		std::vector<std::uint32_t> newCache(triangle, triangle + 3);
+		for (std::uint32_t v : cache) {
+			if (v != triangle[0] and v != triangle[1] and v != triangle[2]) {
+				newCache.push_back(v);
+			}
+		}
+		for (std::size_t i = 0; i < newCache.size(); ++i) {
+			std::uint32_t v = newCache[i];
+			cachePositions[v] = i < CACHE_SIZE ? static_cast<std::uint32_t>(i) : NONE;
+			float score = vertexScore(cachePositions[v], nTrianglesLeft[v]);
+			float delta = score - vertexScores[v];
+			vertexScores[v] = score;
+			for (std::uint32_t j = 0; j < nTrianglesLeft[v]; ++j) {
+				triangleScores[vertexTriangles[firstTriangle[v] + j]] += delta;
+			}
+		}
+		newCache.resize(std::min(newCache.size(), CACHE_SIZE));
+		cache.swap(newCache);
+
+		// Pick the best triangle among those of the cached vertices.
+		bestTriangle = NONE;
+		float bestScore = -1.0f;
+		for (std::uint32_t v : cache) {
+			for (std::uint32_t j = 0; j < nTrianglesLeft[v]; ++j) {
+				std::uint32_t t = vertexTriangles[firstTriangle[v] + j];
+				if (triangleScores[t] > bestScore) {
+					bestTriangle = t;
+					bestScore    = triangleScores[t];
+				}
+			}
+		}
+	}
+	return optimized;
+}
+
+std::vector<std::uint32_t> optimizeVertexFetch(std::vector<std::uint32_t>& indices,
+                                               std::size_t nVertices) {
+	std::vector<std::uint32_t> newIndices(nVertices, NONE);
+	std::vector<std::uint32_t> order;
+	for (std::uint32_t& index : indices) {
+		if (newIndices[index] == NONE) {
+			newIndices[index] = static_cast<std::uint32_t>(order.size());
+			order.push_back(index);
+		}
+		index = newIndices[index];
+	}
+	return order;
+}
+
+double averageCacheMissRatio(const std::vector<std::uint32_t>& indices, std::size_t cacheSize) {
+	if (indices.size() < 3) {
+		return 0.0;
+	}
+	std::deque<std::uint32_t> cache;
+	std::size_t misses = 0;
+	for (std::uint32_t index : indices) {
+		if (std::find(cache.begin(), cache.end(), index) == cache.end()) {
+			++misses;
+			cache.push_back(index);
+			if (cache.size() > cacheSize) {
+				cache.pop_front();
+			}
+		}
+	}
+	return static_cast<double>(misses) / (indices.size() / 3);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file mesh_optimize.hpp
+ *
+ * Interface file for reordering indexed meshes for the GPU's vertex cache and vertex fetch.
+ */
+#ifndef SPACE_COWBOY_MESH_OPTIMIZE_HPP
+#define SPACE_COWBOY_MESH_OPTIMIZE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Reorders triangles so that consecutive triangles reuse recently transformed vertices, with Tom
+ * Forsyth's linear-speed vertex cache optimization: each step emits the triangle whose vertices
+ * score highest, favouring vertices recently used and vertices with few triangles left.
+ *
+ * @param indices Triangles to reorder.
+ * @param nVertices Number of vertices the triangles index.
+ * @return Reordered triangles.
+ */
+std::vector<std::uint32_t> optimizeVertexCache(const std::vector<std::uint32_t>& indices,
+                                               std::size_t nVertices);
+
+/**
+ * Renumbers vertices in the order the triangles first use them, so that vertex fetches walk the
+ * vertex buffer forwards. Vertices no triangle uses are dropped.
+ *
+ * @param indices Triangles, renumbered in place.
+ * @param nVertices Number of vertices the triangles index.
+ * @return Former index of each vertex in the new order.
+ */
+std::vector<std::uint32_t> optimizeVertexFetch(std::vector<std::uint32_t>& indices,
+                                               std::size_t nVertices);
+
+/**
+ * Returns the average number of vertices transformed per triangle by a FIFO post-transform cache,
+ * between 0.5 for an ideal order on a large mesh and 3 with no reuse.
+ *
+ * @param indices Triangles in drawing order.
+ * @param cacheSize Number of vertices in the cache.
+ * @return Average cache miss ratio.
+ */
+double averageCacheMissRatio(const std::vector<std::uint32_t>& indices, std::size_t cacheSize);
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file mpsc_queue.hpp
+ *
+ * Interface file for the MpscQueue class template.
+ */
+#ifndef SPACE_COWBOY_MPSC_QUEUE_HPP
+#define SPACE_COWBOY_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Lock-free queue with any number of producer threads and a single consumer thread. Producers push
+ * onto an intrusive stack with a compare-and-swap; the consumer takes the whole stack at once with
+ * an exchange and reverses it, so values come out in the order they were pushed and no value is
+ * ever popped while another thread holds it.
+ */
+template <typename T>
+class MpscQueue {
+public:
+	// Constructors.
+	/**
+	 * Creates an empty queue.
+	 */
+	MpscQueue() :
+			mHead(nullptr) { }
+
+	/**
+	 * Copy constructor is disabled as the queue owns its nodes.
+	 */
+	MpscQueue(const MpscQueue&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as the queue owns its nodes.
+	 */
+	void operator=(const MpscQueue&) = delete;
+
+	// Destructors.
+	/**
+	 * Destroys the values left in the queue.
+	 */
+	~MpscQueue() {
+		Node *node = mHead.load(std::memory_order_acquire);
+		while (node != nullptr) {
+			Node *next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+
+	// Mutator functions.
+	/**
+	 * Pushes a value. Safe to call from any thread.
+	 *
+	 * @param value Value to push.
+	 */
+	void push(T value) {
+		Node *node = new Node{ std::move(value), mHead.load(std::memory_order_relaxed) };
+		while (not mHead.compare_exchange_weak(node->next, node, std::memory_order_release,
+		                                       std::memory_order_relaxed)) {
+		}
+	}
+
+	/**
+	 * Moves every value pushed so far to the back of a container, oldest first. Must only be called
+	 * from the consumer thread.
+	 *
+	 * @param values Container to append the values to, with a push_back function.
+	 * @return Number of values appended.
+	 */
+	template <typename Container>
+	std::size_t popAll(Container& values) {
+		// The stack holds the newest value first; reverse it.
+		Node *node     = mHead.exchange(nullptr, std::memory_order_acquire);
+		Node *reversed = nullptr;
+		while (node != nullptr) {
+			Node *next = node->next;
+			node->next = reversed;
+			reversed   = node;
+			node       = next;
+		}
+
+		std::size_t nValues = 0;
+		while (reversed != nullptr) {
+			Node *next = reversed->next;
+			values.push_back(std::move(reversed->value));
+			delete reversed;
+			reversed = next;
+			++nValues;
+		}
+		return nValues;
+	}
+
+private:
+	/** Pushed value and the value pushed before it. */
+	struct Node {
+		/** Pushed value. */
+		T     value;
+		/** Node pushed before this one. */
+		Node *next;
+	};
+
+	// Data members.
+	/** Node pushed last, or nullptr if the queue is empty. */
+	std::atomic<Node *> mHead;
+};
+
+#endif
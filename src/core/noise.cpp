@@ -0,0 +1,122 @@
+/**
+ * @file noise.cpp
+ *
+ * Defines the value noise and colour functions used to colour the planets and moons.
+ */
+#include "noise.hpp"
+
+#include "world_random.hpp"
+
+#include <cmath>
+
+namespace {
+/** Standard deviation of the colour components around the chosen colour, out of 255. */
+constexpr float COLOR_STD = 10;
+
+/**
+ * Returns a random colour normally distributed around one of the given colours.
+ *
+ * @param colorChoices Colours to choose from, with components out of 255.
+ * @return RGB colour with components out of 1.
+ */
+glm::vec3 getRandomColor(const std::vector<glm::vec3>& colorChoices) {
+	glm::vec3 colorChoice = colorChoices[worldRandom::integer(0, colorChoices.size() - 1)];
+
+	return glm::vec3{ worldRandom::normal(colorChoice.x, COLOR_STD) / 255,
+	                  worldRandom::normal(colorChoice.y, COLOR_STD) / 255,
+	                  worldRandom::normal(colorChoice.z, COLOR_STD) / 255 };
+}
+}
+
+std::vector<std::vector<float>> generateNoiseMatrix() {
+	worldRandom::Generator& random = worldRandom::engine();
+
+	// Fill each row with uniform noise in bulk.
+	std::vector<std::vector<float>> noiseMatrix(NOISE_SIZE, std::vector<float>(NOISE_SIZE));
+	for (std::vector<float>& row : noiseMatrix) {
+		random.fill(row.data(), row.size());
+	}
+
+	return noiseMatrix;
+}
+
+// This code was made with the help of http://lodev.org/cgtutor/randomnoise.html
+float smoothNoise(float x, float y, const std::vector<std::vector<float>>& noise) {
+	//get fractional part of x and y
+	double fractX = x - floor(x);
+	double fractY = y - floor(y);
+
+	//wrap around
+	int x1 = (static_cast<int>(x) + NOISE_SIZE) % NOISE_SIZE;
+	int y1 = (static_cast<int>(y) + NOISE_SIZE) % NOISE_SIZE;
+
+	//neighbor values
+	int x2 = (x1 + NOISE_SIZE - 1) % NOISE_SIZE;
+	int y2 = (y1 + NOISE_SIZE - 1) % NOISE_SIZE;
+
+	//smooth the noise with bilinear interpolation
+	float value = 0.0;
+	value += fractX * fractY * noise[y1][x1];
+	value += (1 - fractX) * fractY * noise[y1][x2];
+	value += fractX * (1 - fractY) * noise[y2][x1];
+	value += (1 - fractX) * (1 - fractY) * noise[y2][x2];
+
+	return value;
+}
+
+// This code was made with the help of http://lodev.org/cgtutor/randomnoise.html
+double turbulence(double x, double y, double size, const std::vector<std::vector<float>>& noise) {
+	double value = 0.0, initialSize = size;
+
+	while (size >= 1) {
+		value += smoothNoise(x / size, y / size, noise) * size;
+		size /= 2.0;
+	}
+
+	return (128.0 * value / initialSize);
+}
+
+glm::vec3 getBrightColor() {
+	return getRandomColor({
+			glm::vec3{ 102, 204, 255 },
+			glm::vec3{ 236, 121, 154 },
+			glm::vec3{ 224, 204, 151 },
+			glm::vec3{ 225, 179, 120 },
+			glm::vec3{ 244, 170, 262 }
+	});
+}
+
+glm::vec3 getDarkColor() {
+	return getRandomColor({
+			glm::vec3{ 121, 72, 59 },
+			glm::vec3{ 73, 99, 141 },
+			glm::vec3{ 184, 41, 30 },
+			glm::vec3{ 56, 132, 65 },
+			glm::vec3{ 70, 117, 118 }
+	});
+}
+
+void generateColours(std::vector<float>& colours, glm::vec3 primaryColor, glm::vec3 secondaryColor,
+                     double xPeriod, double yPeriod, double turbPower, double turbSize) {
+	std::vector<std::vector<float>> noiseMatrix = generateNoiseMatrix();
+
+	// Generate random noise and pattern.
+	for (int i = 0; i < NOISE_SIZE; i++) {
+		for (int j = 0; j < NOISE_SIZE; j++) {
+			double xyValue = i * xPeriod / NOISE_SIZE +
+			                 j * yPeriod / NOISE_SIZE +
+			                 turbPower * turbulence(i, j, turbSize, noiseMatrix) / 256.0;
+
+			double sineValue = pow(cos(xyValue * M_PI), 2);
+
+			float factor = static_cast<float>(sineValue);
+
+			colours[3 * (j + NOISE_SIZE * i)]     =
+					factor * primaryColor.x + (1 - factor) * secondaryColor.x;
+			colours[3 * (j + NOISE_SIZE * i) + 1] =
+					factor * primaryColor.y + (1 - factor) * secondaryColor.y;
+			colours[3 * (j + NOISE_SIZE * i) + 2] =
+					factor * primaryColor.z + (1 - factor) * secondaryColor.z;
+		}
+	}
+}
@@ -0,0 +1,74 @@
+/**
+ * @file noise.hpp
+ *
+ * Declares the value noise and colour functions used to colour the planets and moons.
+ */
+#ifndef SPACE_COWBOY_NOISE_HPP
+#define SPACE_COWBOY_NOISE_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+
+/** Side length of the noise matrix. Matches the resolution of the planet and moon meshes. */
+constexpr int NOISE_SIZE = 129;
+
+/**
+ * Generates a square matrix of uniformly distributed noise in [0, 1) using the world random number
+ * engine.
+ *
+ * @return Noise matrix of NOISE_SIZE by NOISE_SIZE values.
+ */
+std::vector<std::vector<float>> generateNoiseMatrix();
+
+/**
+ * Samples a noise matrix at a fractional position with bilinear interpolation, wrapping around its
+ * edges.
+ *
+ * @param x Column to sample.
+ * @param y Row to sample.
+ * @param noise Noise matrix.
+ * @return Interpolated noise value.
+ */
+float smoothNoise(float x, float y, const std::vector<std::vector<float>>& noise);
+
+/**
+ * Sums the smoothed noise over octaves from the given size down to one.
+ *
+ * @param x Column to sample.
+ * @param y Row to sample.
+ * @param size Size of the largest octave.
+ * @param noise Noise matrix.
+ * @return Turbulence in [0, 256).
+ */
+double turbulence(double x, double y, double size, const std::vector<std::vector<float>>& noise);
+
+/**
+ * Returns a random colour close to one of the bright planet colours.
+ *
+ * @return RGB colour.
+ */
+glm::vec3 getBrightColor();
+
+/**
+ * Returns a random colour close to one of the dark planet colours.
+ *
+ * @return RGB colour.
+ */
+glm::vec3 getDarkColor();
+
+/**
+ * Fills the vertex colours of a NOISE_SIZE by NOISE_SIZE sphere with a turbulent blend of two
+ * colours. Zero periods give marble-free rock, non-zero periods give the bands of gas giants.
+ *
+ * @param colours Vertex colours to fill, three components per vertex.
+ * @param primaryColor First colour of the blend.
+ * @param secondaryColor Second colour of the blend.
+ * @param xPeriod Number of bands along the lines of latitude.
+ * @param yPeriod Number of bands along the lines of longitude.
+ * @param turbPower Strength of the turbulence.
+ * @param turbSize Size of the largest turbulence octave.
+ */
+void generateColours(std::vector<float>& colours, glm::vec3 primaryColor, glm::vec3 secondaryColor,
+                     double xPeriod, double yPeriod, double turbPower, double turbSize);
+
+#endif
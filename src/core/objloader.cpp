@@ -5,54 +5,85 @@
 */
 #include "objloader.hpp"
 
+#include "utility.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+/** Longest line parsed, including its null terminator. Longer lines are cut short. */
+constexpr std::size_t MAX_LINE_LENGTH = 1024;
+}
+
 bool loadOBJ(
 	const char * path,
 	std::vector<glm::vec3> & out_vertices,
 	std::vector<glm::vec3> & out_normals,
 	std::vector<glm::vec2> & out_uvs){
 
+	PROFILE_SCOPE("loadOBJ");
+
 	std::vector<unsigned int> vertexIndices, uvIndices, normalIndices;
 	std::vector<glm::vec3> temp_vertices;
 	std::vector<glm::vec2> temp_uvs;
 	std::vector<glm::vec3> temp_normals;
 
-	FILE * file = fopen(path, "r");
-	if (file == NULL){
+	// Map the file and parse it line by line, copying each line to a null-terminated buffer for
+	// sscanf.
+	std::unique_ptr<utility::MappedFile> file;
+	try {
+		file.reset(new utility::MappedFile(path));
+	}
+	catch (const std::runtime_error&) {
 		printf("Impossible to open the file ! Are you in the right path ?\n");
 		getchar();
 		return false;
 	}
 
-	while (1){
+	const char * cursor = file->begin();
+	while (cursor < file->end()){
+
+		// copy the line, cutting overly long ones short
+		const char * lineEnd = static_cast<const char *>(
+				memchr(cursor, '\n', static_cast<std::size_t>(file->end() - cursor)));
+		if (lineEnd == NULL)
+			lineEnd = file->end();
+		char line[MAX_LINE_LENGTH];
+		std::size_t length = std::min(static_cast<std::size_t>(lineEnd - cursor),
+		                              MAX_LINE_LENGTH - 1);
+		memcpy(line, cursor, length);
+		line[length] = '\0';
+		cursor = lineEnd + 1;
 
-		char lineHeader[128];
 		// read the first word of the line
-		int res = fscanf(file, "%s", lineHeader);
-		if (res == EOF)
-			break; // EOF = End Of File. Quit the loop.
+		char lineHeader[128];
+		int headerLength;
+		if (sscanf(line, "%127s%n", lineHeader, &headerLength) != 1)
+			continue; // Blank line.
+		const char * arguments = line + headerLength;
 
 		// else : parse lineHeader
 
 		if (strcmp(lineHeader, "v") == 0){
 			glm::vec3 vertex;
-			fscanf(file, "%f %f %f\n", &vertex.x, &vertex.y, &vertex.z);
+			sscanf(arguments, "%f %f %f", &vertex.x, &vertex.y, &vertex.z);
 			temp_vertices.push_back(vertex);
 		}
 		else if (strcmp(lineHeader, "vt") == 0){
 			glm::vec2 uv;
-			fscanf(file, "%f %f\n", &uv.x, &uv.y);
+			sscanf(arguments, "%f %f", &uv.x, &uv.y);
 			uv.y = -uv.y; // Invert V coordinate since we will only use DDS texture, which are inverted. Remove if you want to use TGA or BMP loaders.
 			temp_uvs.push_back(uv);
 		}
 		else if (strcmp(lineHeader, "vn") == 0){
 			glm::vec3 normal;
-			fscanf(file, "%f %f %f\n", &normal.x, &normal.y, &normal.z);
+			sscanf(arguments, "%f %f %f", &normal.x, &normal.y, &normal.z);
 			temp_normals.push_back(normal);
 		}
 		else if (strcmp(lineHeader, "f") == 0){
-			std::string vertex1, vertex2, vertex3;
 			unsigned int vertexIndex[3], uvIndex[3], normalIndex[3];
-			int matches = fscanf(file, "%d/%d/%d %d/%d/%d %d/%d/%d\n", &vertexIndex[0], &uvIndex[0], &normalIndex[0], &vertexIndex[1], &uvIndex[1], &normalIndex[1], &vertexIndex[2], &uvIndex[2], &normalIndex[2]); 
+			int matches = sscanf(arguments, "%u/%u/%u %u/%u/%u %u/%u/%u", &vertexIndex[0], &uvIndex[0], &normalIndex[0], &vertexIndex[1], &uvIndex[1], &normalIndex[1], &vertexIndex[2], &uvIndex[2], &normalIndex[2]);
 			if (matches != 9){
 				printf("File can't be read by our simple parser :-( Try exporting with other options\n");
 				return false;
@@ -69,11 +100,7 @@ bool loadOBJ(
 			normalIndices.push_back(normalIndex[1]);
 			normalIndices.push_back(normalIndex[2]);
 		}
-		else{
-			// Probably a comment, eat up the rest of the line
-			char stupidBuffer[1000];
-			fgets(stupidBuffer, 1000, file);
-		}
+		// else : probably a comment, the rest of the line is skipped with it
 
 	}
 
@@ -6,6 +6,8 @@
 #ifndef SPACE_COWBOY_OBJLOADER_HPP
 #define SPACE_COWBOY_OBJLOADER_HPP
 
+#include "profiler.hpp"
+
 #include <vector>
 #include <glm/glm.hpp>
 #include <stdio.h>
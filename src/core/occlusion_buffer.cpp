@@ -0,0 +1,192 @@
+/**
+ * @file occlusion_buffer.cpp
+ *
+ * Implementation file for the OcclusionBuffer class.
+ */
+#include "occlusion_buffer.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Redeclare constant static data members.
+constexpr int OcclusionBuffer::WIDTH;
+constexpr int OcclusionBuffer::HEIGHT;
+
+namespace {
+/** Depth of pixels no occluder covers. */
+constexpr float FAR_DEPTH           = std::numeric_limits<float>::infinity();
+/** Smallest radius in pixels of an occluder worth rasterizing. */
+constexpr float MIN_OCCLUDER_PIXELS = 2.0f;
+
+/**
+ * Lowers the depths of a span of pixels to a depth.
+ *
+ * @param pixels First pixel of the span.
+ * @param n Number of pixels in the span.
+ * @param depth Depth to write where it is nearer.
+ */
+void fillSpan(float *pixels, int n, float depth) {
+	int i = 0;
+#if defined(__SSE2__)
+	__m128 depths = _mm_set1_ps(depth);
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(pixels + i, _mm_min_ps(_mm_loadu_ps(pixels + i), depths));
+	}
+#endif
+	for (; i < n; ++i) {
+		pixels[i] = std::min(pixels[i], depth);
+	}
+}
+}
+
+// Constructors.
+OcclusionBuffer::OcclusionBuffer() :
+		mProjectionScale(1.0f, 1.0f) {
+	// Halve the size, rounding up, down to a single pixel.
+	glm::ivec2 size(WIDTH, HEIGHT);
+	while (true) {
+		mLevelSizes.push_back(size);
+		mLevels.emplace_back(static_cast<std::size_t>(size.x * size.y), FAR_DEPTH);
+		if (size.x == 1 and size.y == 1) {
+			break;
+		}
+		size = glm::ivec2((size.x + 1) / 2, (size.y + 1) / 2);
+	}
+}
+
+// Accessor functions.
+bool OcclusionBuffer::sphereVisible(const glm::vec3& centre, float radius) const {
+	glm::vec3 viewCentre = viewPosition(centre);
+	float     nearest    = viewCentre.z - radius;
+	if (nearest <= 0.0f) {
+		return true;
+	}
+
+	// Clamp the sphere's bounds to the buffer. Spheres off the buffer are left to frustum culling.
+	ScreenBounds bounds = screenBounds(viewCentre, radius);
+	int x0 = std::max(static_cast<int>(std::floor(bounds.minimum.x)), 0);
+	int y0 = std::max(static_cast<int>(std::floor(bounds.minimum.y)), 0);
+	int x1 = std::min(static_cast<int>(std::floor(bounds.maximum.x)), WIDTH - 1);
+	int y1 = std::min(static_cast<int>(std::floor(bounds.maximum.y)), HEIGHT - 1);
+	if (x0 > x1 or y0 > y1) {
+		return true;
+	}
+
+	// Go up the hierarchy until the bounds span at most two pixels in each direction, then compare
+	// the sphere's nearest depth with the farthest depth of those pixels.
+	std::size_t level = 0;
+	while (level + 1 < mLevels.size() and
+	       ((x1 >> level) - (x0 >> level) > 1 or (y1 >> level) - (y0 >> level) > 1)) {
+		++level;
+	}
+	const std::vector<float>& depths = mLevels[level];
+	int   width    = mLevelSizes[level].x;
+	float farthest = 0.0f;
+	for (int y = y0 >> level; y <= y1 >> level; ++y) {
+		for (int x = x0 >> level; x <= x1 >> level; ++x) {
+			farthest = std::max(farthest, depths[static_cast<std::size_t>(y * width + x)]);
+		}
+	}
+	return nearest <= farthest;
+}
+
+// Mutator functions.
+void OcclusionBuffer::clear(const CameraBlock& camera) {
+	mView            = camera.view;
+	mProjectionScale = glm::vec2(camera.projection[0][0], camera.projection[1][1]);
+	std::fill(mLevels[0].begin(), mLevels[0].end(), FAR_DEPTH);
+}
+
+bool OcclusionBuffer::addOccluder(const glm::vec3& centre, float radius) {
+	// The camera must be outside the sphere, in front of it.
+	glm::vec3 viewCentre = viewPosition(centre);
+	if (viewCentre.z - radius <= 0.0f) {
+		return false;
+	}
+
+	// The disc facing the camera projects to an ellipse around the projected centre.
+	float centreX = (mProjectionScale.x * viewCentre.x / viewCentre.z + 1.0f) * 0.5f * WIDTH;
+	float centreY = (mProjectionScale.y * viewCentre.y / viewCentre.z + 1.0f) * 0.5f * HEIGHT;
+	float radiusX = mProjectionScale.x * radius / viewCentre.z * 0.5f * WIDTH;
+	float radiusY = mProjectionScale.y * radius / viewCentre.z * 0.5f * HEIGHT;
+	if (radiusX < MIN_OCCLUDER_PIXELS or radiusY < MIN_OCCLUDER_PIXELS) {
+		return false;
+	}
+
+	// Fill the pixels of each row lying entirely inside the ellipse: those between the ellipse's
+	// edges at whichever of the row's top and bottom is farther from the centre.
+	int firstRow = std::max(static_cast<int>(std::ceil(centreY - radiusY)), 0);
+	int lastRow  = std::min(static_cast<int>(std::floor(centreY + radiusY)) - 1, HEIGHT - 1);
+	std::vector<float>& depths = mLevels[0];
+	for (int y = firstRow; y <= lastRow; ++y) {
+		float dy     = std::max(std::abs(y - centreY), std::abs(y + 1 - centreY)) / radiusY;
+		float extent = 1.0f - dy * dy;
+		if (extent <= 0.0f) {
+			continue;
+		}
+		float halfWidth = radiusX * std::sqrt(extent);
+		int   first     = std::max(static_cast<int>(std::ceil(centreX - halfWidth)), 0);
+		int   last      = std::min(static_cast<int>(std::floor(centreX + halfWidth)), WIDTH);
+		if (first < last) {
+			fillSpan(&depths[static_cast<std::size_t>(y * WIDTH + first)], last - first,
+			         viewCentre.z);
+		}
+	}
+	return true;
+}
+
+void OcclusionBuffer::buildHierarchy() {
+	PROFILE_SCOPE("OcclusionBuffer::buildHierarchy");
+
+	// Each pixel keeps the farthest of the up to four pixels it covers in the level below.
+	for (std::size_t level = 1; level < mLevels.size(); ++level) {
+		const std::vector<float>& source     = mLevels[level - 1];
+		std::vector<float>&       target     = mLevels[level];
+		glm::ivec2                sourceSize = mLevelSizes[level - 1];
+		glm::ivec2                targetSize = mLevelSizes[level];
+		for (int y = 0; y < targetSize.y; ++y) {
+			int y0 = 2 * y;
+			int y1 = std::min(2 * y + 1, sourceSize.y - 1);
+			for (int x = 0; x < targetSize.x; ++x) {
+				int x0 = 2 * x;
+				int x1 = std::min(2 * x + 1, sourceSize.x - 1);
+				target[static_cast<std::size_t>(y * targetSize.x + x)] = std::max(
+						std::max(source[static_cast<std::size_t>(y0 * sourceSize.x + x0)],
+						         source[static_cast<std::size_t>(y0 * sourceSize.x + x1)]),
+						std::max(source[static_cast<std::size_t>(y1 * sourceSize.x + x0)],
+						         source[static_cast<std::size_t>(y1 * sourceSize.x + x1)]));
+			}
+		}
+	}
+}
+
+// Helper functions.
+glm::vec3 OcclusionBuffer::viewPosition(const glm::vec3& point) const {
+	glm::vec4 viewPoint = mView * glm::vec4(point, 1.0f);
+	return glm::vec3(viewPoint.x, viewPoint.y, -viewPoint.z);
+}
+
+OcclusionBuffer::ScreenBounds OcclusionBuffer::screenBounds(const glm::vec3& centre,
+                                                            float radius) const {
+	// x / z over the sphere is bounded by its box's edges at the box's nearest and farthest depths.
+	float nearZ = centre.z - radius;
+	float farZ  = centre.z + radius;
+	glm::vec2 low(std::min((centre.x - radius) / nearZ, (centre.x - radius) / farZ),
+	              std::min((centre.y - radius) / nearZ, (centre.y - radius) / farZ));
+	glm::vec2 high(std::max((centre.x + radius) / nearZ, (centre.x + radius) / farZ),
+	               std::max((centre.y + radius) / nearZ, (centre.y + radius) / farZ));
+
+	ScreenBounds bounds;
+	bounds.minimum = glm::vec2((mProjectionScale.x * low.x + 1.0f) * 0.5f * WIDTH,
+	                           (mProjectionScale.y * low.y + 1.0f) * 0.5f * HEIGHT);
+	bounds.maximum = glm::vec2((mProjectionScale.x * high.x + 1.0f) * 0.5f * WIDTH,
+	                           (mProjectionScale.y * high.y + 1.0f) * 0.5f * HEIGHT);
+	return bounds;
+}
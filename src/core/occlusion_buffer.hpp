@@ -0,0 +1,115 @@
+/**
+ * @file occlusion_buffer.hpp
+ *
+ * Interface file for the OcclusionBuffer class.
+ */
+#ifndef SPACE_COWBOY_OCCLUSION_BUFFER_HPP
+#define SPACE_COWBOY_OCCLUSION_BUFFER_HPP
+
+#include "camera.hpp"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * Low resolution depth buffer rasterized on the CPU, used to skip bodies hidden behind large ones
+ * before they are submitted. Each frame the large bodies are rasterized as occluders, the hierarchy
+ * of farthest depths is built, and bodies are then tested against it.
+ *
+ * An occluder sphere is drawn as the disc through its centre facing the camera, which lies inside
+ * the sphere. Only pixels the disc covers entirely are written, at the depth of the sphere's centre,
+ * so the buffer never claims more occlusion than the spheres provide. Pixel rows are filled four at a
+ * time with SSE2 where available. Depths are distances along the viewing direction.
+ */
+class OcclusionBuffer {
+public:
+	// Constants.
+	/** Width of the buffer in pixels. A multiple of four. */
+	static constexpr int WIDTH  = 256;
+	/** Height of the buffer in pixels. */
+	static constexpr int HEIGHT = 128;
+
+	// Constructors.
+	/**
+	 * Creates an empty occlusion buffer.
+	 */
+	OcclusionBuffer();
+
+	// Accessor functions.
+	/**
+	 * Returns whether a sphere may be visible past the occluders. Only valid once the hierarchy has
+	 * been built.
+	 *
+	 * @param centre Centre of the sphere in world space.
+	 * @param radius Radius of the sphere.
+	 * @return False if the sphere is entirely behind the occluders, true otherwise.
+	 */
+	bool sphereVisible(const glm::vec3& centre, float radius) const;
+
+	// Mutator functions.
+	/**
+	 * Clears the buffer for a new frame.
+	 *
+	 * @param camera Camera block of the frame.
+	 */
+	void clear(const CameraBlock& camera);
+
+	/**
+	 * Rasterizes a sphere as an occluder. Spheres covering less than a few pixels are skipped, as
+	 * their inner disc covers hardly any pixel entirely.
+	 *
+	 * @param centre Centre of the sphere in world space.
+	 * @param radius Radius of a sphere contained in the occluder.
+	 * @return True if the sphere was rasterized.
+	 */
+	bool addOccluder(const glm::vec3& centre, float radius);
+
+	/**
+	 * Builds the hierarchy of farthest depths from the rasterized occluders. Should be called after
+	 * the last occluder is added and before testing spheres.
+	 */
+	void buildHierarchy();
+
+private:
+	/** Bounds of a sphere on the screen. */
+	struct ScreenBounds {
+		/** Smallest pixel coordinates covered. */
+		glm::vec2 minimum;
+		/** Largest pixel coordinates covered. */
+		glm::vec2 maximum;
+	};
+
+	// Data members.
+	/** View matrix of the frame. */
+	glm::mat4 mView;
+	/** Horizontal and vertical scale from view space to normalized device coordinates. */
+	glm::vec2 mProjectionScale;
+
+	/**
+	 * Farthest depth of each pixel of every level. Level 0 is the rasterized buffer; each following
+	 * level halves its size.
+	 */
+	std::vector<std::vector<float>> mLevels;
+	/** Size of each level in pixels. */
+	std::vector<glm::ivec2>         mLevelSizes;
+
+	// Helper functions.
+	/**
+	 * Transforms a point into view space, with the depth along the viewing direction positive.
+	 *
+	 * @param point Point in world space.
+	 * @return View space position of the point.
+	 */
+	glm::vec3 viewPosition(const glm::vec3& point) const;
+
+	/**
+	 * Bounds a sphere in front of the camera on the screen, conservatively.
+	 *
+	 * @param centre Centre of the sphere in view space.
+	 * @param radius Radius of the sphere.
+	 * @return Pixel bounds of the sphere, possibly beyond the buffer.
+	 */
+	ScreenBounds screenBounds(const glm::vec3& centre, float radius) const;
+};
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * @file profiler.cpp
+ *
+ * Implementation file for the built-in CPU profiler.
+ */
+#include "profiler.hpp"
+
+#ifdef SPACE_COWBOY_PROFILE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace profiler {
+namespace {
+/** Number of zones each thread's ring buffer holds. Once full, the oldest zones are overwritten. */
+constexpr std::size_t RING_CAPACITY = 1 << 16;
+
+/** A completed zone. */
+struct Zone {
+	/** Name of the zone. */
+	const char    *name;
+	/** Start timestamp in nanoseconds. */
+	std::uint64_t start;
+	/** End timestamp in nanoseconds. */
+	std::uint64_t end;
+};
+
+/**
+ * Single-producer ring buffer owned by one thread. Only the owning thread writes zones; the frame
+ * thread reads them once a capture completes. The head counter is published with release semantics
+ * so that every zone below it is visible to the reader.
+ */
+struct ThreadBuffer {
+	/** Recorded zones, indexed by head modulo RING_CAPACITY. */
+	std::array<Zone, RING_CAPACITY> zones;
+	/** Total number of zones ever written by the owning thread. */
+	std::atomic<std::uint64_t>      head { 0 };
+	/** Name of the owning thread, or nullptr if it was never named. */
+	std::atomic<const char *>       name { nullptr };
+	/** Identifier of the owning thread in the trace output. */
+	unsigned int                    threadID = 0;
+};
+
+/** Reference point for all timestamps. */
+const std::chrono::steady_clock::time_point sEpoch = std::chrono::steady_clock::now();
+
+/** True iff zones are currently being recorded. */
+std::atomic<bool> sCapturing { false };
+
+/** Guards sThreadBuffers. Only taken when a thread records its first zone and when writing. */
+std::mutex                                 sThreadBuffersMutex;
+/** Ring buffers of every thread that has recorded a zone. */
+std::vector<std::shared_ptr<ThreadBuffer>> sThreadBuffers;
+
+// Capture state. Only accessed from the thread driving beginFrame and endFrame.
+/** Number of frames left in the current capture. */
+unsigned int  sRemainingFrames = 0;
+/** Number of frames in the current capture. */
+unsigned int  sCapturedFrames  = 0;
+/** Timestamp at which the current capture started. */
+std::uint64_t sCaptureStart    = 0;
+/** Timestamp at which the current frame started. */
+std::uint64_t sFrameStart      = 0;
+/** Path of the trace file for the current capture. */
+std::string   sOutputPath;
+
+/**
+ * Creates a ring buffer for the calling thread and registers it.
+ *
+ * @return The calling thread's ring buffer.
+ */
+std::shared_ptr<ThreadBuffer> registerThread() {
+	std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+
+	std::lock_guard<std::mutex> lock(sThreadBuffersMutex);
+	buffer->threadID = static_cast<unsigned int>(sThreadBuffers.size());
+	sThreadBuffers.push_back(buffer);
+	return buffer;
+}
+
+/**
+ * Returns the calling thread's ring buffer, creating it on first use.
+ *
+ * @return The calling thread's ring buffer.
+ */
+ThreadBuffer& threadBuffer() {
+	thread_local std::shared_ptr<ThreadBuffer> buffer = registerThread();
+	return *buffer;
+}
+
+/**
+ * Returns the ring buffer of the GPU track, creating it on first use.
+ *
+ * @return The GPU track's ring buffer.
+ */
+ThreadBuffer& gpuBuffer() {
+	static std::shared_ptr<ThreadBuffer> buffer = [] {
+		std::shared_ptr<ThreadBuffer> gpu = registerThread();
+		gpu->name.store("GPU", std::memory_order_release);
+		return gpu;
+	}();
+	return *buffer;
+}
+
+/**
+ * Appends a zone to a ring buffer.
+ *
+ * @param buffer Ring buffer. Must only be written by the calling thread.
+ * @param zone Completed zone.
+ */
+void push(ThreadBuffer& buffer, const Zone& zone) {
+	std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+	buffer.zones[head % RING_CAPACITY] = zone;
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Writes a timestamp in nanoseconds as microseconds relative to the start of the capture.
+ *
+ * @param out Stream to write to.
+ * @param timestamp Timestamp in nanoseconds.
+ */
+void writeMicroseconds(std::ostream& out, std::uint64_t timestamp) {
+	std::uint64_t relative = timestamp - sCaptureStart;
+	out << relative / 1000 << '.' << std::setw(3) << std::setfill('0') << relative % 1000;
+}
+
+/**
+ * Writes a string as a JSON string literal.
+ *
+ * @param out Stream to write to.
+ * @param str Null-terminated string.
+ */
+void writeString(std::ostream& out, const char *str) {
+	out << '"';
+	for (; *str != '\0'; ++str) {
+		if (*str == '"' or *str == '\\') {
+			out << '\\';
+		}
+		out << *str;
+	}
+	out << '"';
+}
+
+/**
+ * Writes every zone recorded since the start of the capture to the trace file, in the Chrome trace
+ * event format.
+ */
+void writeTrace() {
+	std::ofstream out(sOutputPath);
+	if (not out.is_open()) {
+		std::cerr << "Error: Cannot write profile trace to " << sOutputPath << "." << std::endl;
+		return;
+	}
+
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	{
+		std::lock_guard<std::mutex> lock(sThreadBuffersMutex);
+		buffers = sThreadBuffers;
+	}
+
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Space Cowboy\"}}";
+
+	std::size_t nZones = 0;
+	for (const std::shared_ptr<ThreadBuffer>& buffer : buffers) {
+		const char *threadName = buffer->name.load(std::memory_order_acquire);
+		out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadID
+		    << ",\"args\":{\"name\":";
+		if (threadName != nullptr) {
+			writeString(out, threadName);
+		}
+		else {
+			out << "\"Thread " << buffer->threadID << '"';
+		}
+		out << "}}";
+
+		// Only the most recent RING_CAPACITY zones are still in the buffer.
+		std::uint64_t head  = buffer->head.load(std::memory_order_acquire);
+		std::uint64_t first = head - std::min<std::uint64_t>(head, RING_CAPACITY);
+		for (std::uint64_t i = first; i < head; ++i) {
+			const Zone& zone = buffer->zones[i % RING_CAPACITY];
+			if (zone.start < sCaptureStart) {
+				continue;
+			}
+
+			out << ",\n{\"name\":";
+			writeString(out, zone.name);
+			out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadID
+			    << ",\"ts\":";
+			writeMicroseconds(out, zone.start);
+			out << ",\"dur\":";
+			out << (zone.end - zone.start) / 1000 << '.' << std::setw(3) << std::setfill('0')
+			    << (zone.end - zone.start) % 1000;
+			out << '}';
+			++nZones;
+		}
+	}
+	out << "\n]}\n";
+
+	std::cout << "Wrote " << nZones << " zones over " << sCapturedFrames << " frames to "
+	          << sOutputPath << "." << std::endl;
+}
+}
+
+std::uint64_t now() {
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - sEpoch).count());
+}
+
+bool isCapturing() {
+	return sCapturing.load(std::memory_order_relaxed);
+}
+
+void requestCapture(unsigned int nFrames, const std::string& outputPath) {
+	if (isCapturing() or nFrames == 0) {
+		return;
+	}
+	sRemainingFrames = nFrames;
+	sCapturedFrames  = nFrames;
+	sOutputPath      = outputPath;
+	sCaptureStart    = now();
+	sCapturing.store(true, std::memory_order_relaxed);
+}
+
+void beginFrame() {
+	sFrameStart = now();
+}
+
+void endFrame() {
+	if (not isCapturing()) {
+		return;
+	}
+
+	record("Frame", sFrameStart, now());
+	if (--sRemainingFrames == 0) {
+		sCapturing.store(false, std::memory_order_relaxed);
+		writeTrace();
+	}
+}
+
+void setThreadName(const char *name) {
+	threadBuffer().name.store(name, std::memory_order_release);
+}
+
+void record(const char *name, std::uint64_t start, std::uint64_t end) {
+	push(threadBuffer(), Zone { name, start, end });
+}
+
+void recordGpu(const char *name, std::uint64_t start, std::uint64_t end) {
+	push(gpuBuffer(), Zone { name, start, end });
+}
+}
+
+#endif
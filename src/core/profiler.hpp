@@ -0,0 +1,161 @@
+/**
+ * @file profiler.hpp
+ *
+ * Interface file for the built-in CPU profiler. Code is instrumented with the PROFILE_* macros
+ * defined below, which record named zones into per-thread lock-free ring buffers. A capture of a
+ * number of frames can be requested at runtime; once the capture completes, the recorded zones are
+ * written to a JSON file that can be opened with chrome://tracing or Perfetto.
+ *
+ * The profiler is only compiled in when SPACE_COWBOY_PROFILE is defined (see the
+ * SPACE_COWBOY_PROFILING CMake option). Otherwise every macro expands to nothing.
+ */
+#ifndef SPACE_COWBOY_PROFILER_HPP
+#define SPACE_COWBOY_PROFILER_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace profiler {
+/** Number of frames captured when a capture is requested without an explicit frame count. */
+constexpr unsigned int DEFAULT_CAPTURE_FRAMES = 120;
+/** File the trace is written to when no explicit path is given. */
+constexpr char DEFAULT_TRACE_PATH[] = "profile_trace.json";
+}
+
+#ifdef SPACE_COWBOY_PROFILE
+
+namespace profiler {
+/**
+ * Returns the time elapsed since the profiler's epoch in nanoseconds. The clock is monotonic.
+ *
+ * @return Current timestamp in nanoseconds.
+ */
+std::uint64_t now();
+
+/**
+ * Returns true iff a capture is currently in progress.
+ *
+ * @return True iff zones are currently being recorded.
+ */
+bool isCapturing();
+
+/**
+ * Starts a capture that ends after nFrames further frames have ended. Zones recorded before the
+ * first frame, such as those of the loading code, are included. Requests made while a capture is
+ * in progress are ignored. Must be called from the thread that drives the frames.
+ *
+ * @param nFrames Number of frames to capture.
+ * @param outputPath Path of the JSON file the trace is written to.
+ */
+void requestCapture(unsigned int nFrames, const std::string& outputPath = DEFAULT_TRACE_PATH);
+
+/**
+ * Marks the beginning of a frame.
+ */
+void beginFrame();
+
+/**
+ * Marks the end of a frame. Finishes the current capture and writes the trace once the requested
+ * number of frames has been recorded.
+ */
+void endFrame();
+
+/**
+ * Names the calling thread in the trace output.
+ *
+ * @param name Name of the thread. Must have static storage duration.
+ */
+void setThreadName(const char *name);
+
+/**
+ * Records a completed zone for the calling thread.
+ *
+ * @param name Name of the zone. Must have static storage duration.
+ * @param start Timestamp at which the zone began, in nanoseconds.
+ * @param end Timestamp at which the zone ended, in nanoseconds.
+ */
+void record(const char *name, std::uint64_t start, std::uint64_t end);
+
+/**
+ * Records a completed zone on the GPU track of the trace. Must only be called from the thread that
+ * owns the OpenGL context.
+ *
+ * @param name Name of the zone. Must have static storage duration.
+ * @param start Timestamp at which the zone began on the profiler clock, in nanoseconds.
+ * @param end Timestamp at which the zone ended on the profiler clock, in nanoseconds.
+ */
+void recordGpu(const char *name, std::uint64_t start, std::uint64_t end);
+
+/**
+ * RAII zone. The constructor stamps the start time and the destructor records the zone into the
+ * calling thread's ring buffer. Zones are only recorded while a capture is in progress, so an idle
+ * profiler costs a single relaxed atomic load per zone.
+ */
+class ScopedZone {
+public:
+	/**
+	 * Opens a zone.
+	 *
+	 * @param name Name of the zone. Must have static storage duration.
+	 */
+	explicit ScopedZone(const char *name) :
+			mName(name),
+			mStart(isCapturing() ? now() : 0) { }
+
+	/**
+	 * Disallow copy constructor, as a zone is tied to the scope it was opened in.
+	 */
+	ScopedZone(const ScopedZone&) = delete;
+
+	/**
+	 * Disallow copy assignment operator, as a zone is tied to the scope it was opened in.
+	 */
+	void operator=(const ScopedZone&) = delete;
+
+	/**
+	 * Closes the zone and records it.
+	 */
+	~ScopedZone() {
+		if (mStart != 0) {
+			record(mName, mStart, now());
+		}
+	}
+
+private:
+	/** Name of the zone. */
+	const char    *mName;
+	/** Start timestamp, or zero if no capture was in progress when the zone was opened. */
+	std::uint64_t mStart;
+};
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+/** Profiles the enclosing scope. The name must be a string literal. */
+#define PROFILE_SCOPE(name) \
+	profiler::ScopedZone PROFILE_CONCAT(profileZone_, __LINE__)("" name "")
+/** Profiles the enclosing function under its own name. */
+#define PROFILE_FUNCTION() \
+	profiler::ScopedZone PROFILE_CONCAT(profileZone_, __LINE__)(__func__)
+/** Marks the beginning of a frame. */
+#define PROFILE_FRAME_BEGIN() profiler::beginFrame()
+/** Marks the end of a frame. */
+#define PROFILE_FRAME_END() profiler::endFrame()
+/** Starts a capture of the given number of frames, written to the given path. */
+#define PROFILE_CAPTURE(nFrames, path) profiler::requestCapture((nFrames), (path))
+/** Names the calling thread. The name must be a string literal. */
+#define PROFILE_THREAD_NAME(name) profiler::setThreadName("" name "")
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_FRAME_BEGIN()
+#define PROFILE_FRAME_END()
+#define PROFILE_CAPTURE(nFrames, path)
+#define PROFILE_THREAD_NAME(name)
+
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file radix_sort.cpp
+ *
+ * Defines the radix sort of 64-bit keys.
+ */
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace {
+/** Bits per digit. */
+constexpr unsigned int DIGIT_BITS          = 8;
+/** Number of values a digit can take. */
+constexpr std::size_t  N_BUCKETS           = std::size_t(1) << DIGIT_BITS;
+/** Number of digits in a key. */
+constexpr unsigned int N_DIGITS            = 64 / DIGIT_BITS;
+
+/** Number of entries below which a comparison sort is faster than building the histograms. */
+constexpr std::size_t  MIN_RADIX_SORT_SIZE = 256;
+}
+
+void radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch) {
+	std::size_t n = entries.size();
+	if (n < MIN_RADIX_SORT_SIZE) {
+		std::stable_sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) {
+			return a.key < b.key;
+		});
+		return;
+	}
+	scratch.resize(n);
+
+	// Count the occurrences of every digit value in a single pass over the keys.
+	std::array<std::array<std::size_t, N_BUCKETS>, N_DIGITS> counts = {};
+	for (const SortEntry& entry : entries) {
+		for (unsigned int digit = 0; digit < N_DIGITS; ++digit) {
+			++counts[digit][(entry.key >> (digit * DIGIT_BITS)) & (N_BUCKETS - 1)];
+		}
+	}
+
+	for (unsigned int digit = 0; digit < N_DIGITS; ++digit) {
+		std::array<std::size_t, N_BUCKETS>& count = counts[digit];
+
+		// Skip digits shared by every key; the pass would not move anything.
+		std::size_t firstBucket = (entries[0].key >> (digit * DIGIT_BITS)) & (N_BUCKETS - 1);
+		if (count[firstBucket] == n) {
+			continue;
+		}
+
+		// Turn the counts into the offset of each bucket, then scatter.
+		std::size_t offset = 0;
+		for (std::size_t& bucket : count) {
+			std::size_t size = bucket;
+			bucket = offset;
+			offset += size;
+		}
+		for (const SortEntry& entry : entries) {
+			scratch[count[(entry.key >> (digit * DIGIT_BITS)) & (N_BUCKETS - 1)]++] = entry;
+		}
+		entries.swap(scratch);
+	}
+}
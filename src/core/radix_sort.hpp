@@ -0,0 +1,32 @@
+/**
+ * @file radix_sort.hpp
+ *
+ * Declares a radix sort of 64-bit keys, used to order the render queue each frame.
+ */
+#ifndef SPACE_COWBOY_RADIX_SORT_HPP
+#define SPACE_COWBOY_RADIX_SORT_HPP
+
+#include <cstdint>
+#include <vector>
+
+/** Key to sort by and the value it is attached to, typically an index into another array. */
+struct SortEntry {
+	/** Sort key. */
+	std::uint64_t key;
+	/** Value carried along with the key. */
+	std::uint32_t value;
+};
+
+/**
+ * Sorts entries by ascending key with a least significant digit radix sort of eight 8-bit digits.
+ * The sort is stable. Digits that are the same in every key are skipped, so keys whose high bits are
+ * mostly shared sort in fewer passes. Short inputs, for which building the digit histograms costs
+ * more than sorting, are sorted with a stable comparison sort instead.
+ *
+ * @param entries Entries to sort.
+ * @param scratch Buffer the passes alternate with. Resized as needed, so a buffer kept between calls
+ *                avoids reallocating.
+ */
+void radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+
+#endif
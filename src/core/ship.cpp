@@ -0,0 +1,154 @@
+/**
+ * @file ship.cpp
+ *
+ * Implementation file for the ShipState and CowboyState structs.
+ */
+#include "ship.hpp"
+
+#include "profiler.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+// Spaceship properties.
+/** Scale of the spaceship model. */
+constexpr float SHIP_SCALE     = 0.2f;
+/** Distance of the spaceship in front of the camera. */
+constexpr float SHIP_DISTANCE  = 25.0f;
+/** Height of the camera above the spaceship. */
+constexpr float SHIP_DROP      = 4.0f;
+/** Largest bank angle in radians. */
+constexpr float MAX_TILT_ANGLE = 3.14159f / 2.0f;
+/** Change of the bank angle per update while tilting, in radians. */
+constexpr float TILT_STEP      = 0.1f;
+/** Factor the bank angle decays by per update while not tilting. */
+constexpr float TILT_DECAY     = 0.9f;
+
+// Spacecowboy properties.
+/** Scale of the spacecowboy model. */
+constexpr float COWBOY_SCALE = 0.1f;
+
+/**
+ * Turns and banks the spaceship so that it points in the camera direction.
+ *
+ * @param ship Spaceship to turn.
+ * @param camera Camera the spaceship follows.
+ */
+void updateRotations(ShipState& ship, const Camera& camera) {
+	// The space ship is loaded pointing in the negative X direction due to object File
+	glm::vec3 spaceShipDir = glm::vec3(-1.0f, 0.0f, 0.0f);
+
+	//Useful Values variable that will come up often
+	glm::vec3 camDir   = camera.direction();
+	glm::mat4 identity = glm::mat4(1.0f);
+
+	// Our first goal is to find the rotation on the XZ plane, to do so we map the camera direction
+	// to the xz plane and find the angle theta
+	float xzDot    = glm::dot(spaceShipDir, glm::vec3(camDir.x, 0.0f, camDir.z));
+	float xzLength = glm::length(glm::vec3(camDir.x, 0.0f, camDir.z));
+	float theta    = glm::acos(xzDot / xzLength);
+
+	// Next we can define the first rotation realising the dot product will never let us rotate
+	// more than 180 degrees, we adjust for the two halves of the xz plane
+	if (camDir.z < 0) {
+		ship.xzRotation = glm::rotate(identity, theta, glm::vec3(0.0f, -1.0f, 0.0f));
+	}
+	else {
+		ship.xzRotation = glm::rotate(identity, theta, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	// We find the angle between the xz plane and the camera direction using the dot product between
+	// the camera direction and its mapping on the xz plane. The axis of rotation will be the cross
+	// product between the two
+	glm::vec3 xzProjection = glm::vec3(camDir.x, 0.0f, camDir.z);
+	glm::vec3 rotationAxis = glm::cross(camDir, xzProjection);
+
+	// Similar to above
+	float dot       = glm::dot(camDir, xzProjection);
+	float xzpLength = glm::length(xzProjection);
+	float camLength = glm::length(camDir);
+	float phi       = glm::acos(dot / (xzpLength * camLength));
+
+	// Adjust the rotation accordingly
+	if (camDir.y > 0) {
+		ship.yRotation = glm::rotate(identity, phi, -rotationAxis);
+	}
+	else {
+		ship.yRotation = glm::rotate(identity, -phi, rotationAxis);
+	}
+
+	// Bank while tilting, and level out otherwise.
+	if (camera.getTiltLeft()) {
+		if (ship.tiltAngle >= -MAX_TILT_ANGLE) {
+			ship.tiltAngle -= TILT_STEP;
+		}
+	}
+	else if (camera.getTiltRight()) {
+		if (ship.tiltAngle <= MAX_TILT_ANGLE) {
+			ship.tiltAngle += TILT_STEP;
+		}
+	}
+	else {
+		ship.tiltAngle *= TILT_DECAY;
+	}
+	ship.tiltRotation = glm::rotate(identity, ship.tiltAngle, camDir);
+}
+}
+
+// Constructors.
+ShipState::ShipState() :
+		scale(glm::scale(glm::mat4(), glm::vec3(SHIP_SCALE, SHIP_SCALE, SHIP_SCALE))),
+		rotation(glm::rotate(glm::mat4(), -3.14159f / 2.0f, glm::vec3(0.0f, 1.0f, 0.0f))),
+		translation(),
+		tiltAngle(0.0f),
+		tiltRotation(),
+		yRotation(),
+		xzRotation() {
+}
+
+CowboyState::CowboyState() :
+		scale(glm::scale(glm::mat4(), glm::vec3(COWBOY_SCALE, COWBOY_SCALE, COWBOY_SCALE))),
+		rotation(),
+		translation() {
+}
+
+// Accessor functions.
+glm::mat4 ShipState::modelMatrix() const {
+	return translation * rotation * scale;
+}
+
+glm::vec3 ShipState::position() const {
+	return glm::vec3(translation[3]);
+}
+
+glm::mat4 CowboyState::modelMatrix() const {
+	return rotation * translation * scale;
+}
+
+glm::vec3 CowboyState::position() const {
+	return glm::vec3(translation[3]);
+}
+
+void updateShip(ShipState& ship, const Camera& camera) {
+	PROFILE_SCOPE("updateShip");
+
+	// Position the ship in front of the camera
+	glm::vec3 newPosition = camera.position() - glm::vec3(0.0f, SHIP_DROP, 0.0f) +
+	                        SHIP_DISTANCE * camera.direction();
+	ship.translation = glm::translate(glm::mat4(), newPosition);
+
+	// Rotate the ship so it points in the camera direction
+	if (not camera.isFreeCameraMode()) {
+		updateRotations(ship, camera);
+	}
+
+	ship.rotation = ship.tiltRotation * ship.yRotation * ship.xzRotation;
+}
+
+void updateCowboy(CowboyState& cowboy, const Body& planet) {
+	//position spacecowboy at top of planet
+	glm::vec3 planetPosition = planet.position();
+	cowboy.translation = glm::translate(glm::mat4(), glm::vec3(planetPosition.x,
+	                                                           planetPosition.y + planet.size(),
+	                                                           planetPosition.z));
+}
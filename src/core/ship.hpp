@@ -0,0 +1,110 @@
+/**
+ * @file ship.hpp
+ *
+ * Interface file for the ShipState and CowboyState structs, the simulation state of the spaceship
+ * and the spacecowboy.
+ */
+#ifndef SPACE_COWBOY_SHIP_HPP
+#define SPACE_COWBOY_SHIP_HPP
+
+#include "body.hpp"
+#include "camera.hpp"
+
+#include <glm/glm.hpp>
+
+/**
+ * Simulation state of the user-controlled spaceship, which flies in front of the camera and banks
+ * when the camera tilts.
+ */
+struct ShipState {
+	// Constructors.
+	/**
+	 * Creates a level spaceship at the origin, pointing along the negative z axis.
+	 */
+	ShipState();
+
+	// Accessor functions.
+	/**
+	 * Returns the model matrix of the spaceship.
+	 *
+	 * @return Spaceship's model matrix.
+	 */
+	glm::mat4 modelMatrix() const;
+
+	/**
+	 * Returns the position of the spaceship.
+	 *
+	 * @return Position of spaceship.
+	 */
+	glm::vec3 position() const;
+
+	// Data members.
+	/** Scale matrix. */
+	glm::mat4 scale;
+	/** Rotation matrix. */
+	glm::mat4 rotation;
+	/** Translation matrix. */
+	glm::mat4 translation;
+
+	/** Bank angle in radians. */
+	float     tiltAngle;
+	/** Rotation banking the spaceship about the camera direction. */
+	glm::mat4 tiltRotation;
+	/** Rotation pitching the spaceship out of the xz plane. */
+	glm::mat4 yRotation;
+	/** Rotation turning the spaceship within the xz plane. */
+	glm::mat4 xzRotation;
+};
+
+/**
+ * Simulation state of the spacecowboy, who stands on top of a planet.
+ */
+struct CowboyState {
+	// Constructors.
+	/**
+	 * Creates a spacecowboy at the origin.
+	 */
+	CowboyState();
+
+	// Accessor functions.
+	/**
+	 * Returns the model matrix of the spacecowboy.
+	 *
+	 * @return Spacecowboy's model matrix.
+	 */
+	glm::mat4 modelMatrix() const;
+
+	/**
+	 * Returns the position of the spacecowboy.
+	 *
+	 * @return Position of spacecowboy.
+	 */
+	glm::vec3 position() const;
+
+	// Data members.
+	/** Scale matrix. */
+	glm::mat4 scale;
+	/** Rotation matrix. */
+	glm::mat4 rotation;
+	/** Translation matrix. */
+	glm::mat4 translation;
+};
+
+/**
+ * Places the spaceship in front of the camera and, unless the camera is in free mode, turns it to
+ * point in the camera direction.
+ *
+ * @param ship Spaceship to update.
+ * @param camera Camera the spaceship follows.
+ */
+void updateShip(ShipState& ship, const Camera& camera);
+
+/**
+ * Places the spacecowboy on top of a planet.
+ *
+ * @param cowboy Spacecowboy to update.
+ * @param planet Planet the spacecowboy stands on.
+ */
+void updateCowboy(CowboyState& cowboy, const Body& planet);
+
+#endif
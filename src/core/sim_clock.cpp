@@ -0,0 +1,21 @@
+/**
+ * @file sim_clock.cpp
+ *
+ * Defines the simulation clock in the "simClock" namespace.
+ */
+#include "sim_clock.hpp"
+
+namespace simClock {
+namespace {
+/** Current simulation time in seconds. */
+double sTime = 0.0;
+}
+
+double now() {
+	return sTime;
+}
+
+void advance(double deltaTime) {
+	sTime += deltaTime;
+}
+}
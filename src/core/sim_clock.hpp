@@ -0,0 +1,27 @@
+/**
+ * @file sim_clock.hpp
+ *
+ * Declares the simulation clock in the "simClock" namespace. All game state is advanced with this
+ * clock rather than with glfwGetTime, so that a recorded session can be replayed with exactly the
+ * same time steps.
+ */
+#ifndef SPACE_COWBOY_SIM_CLOCK_HPP
+#define SPACE_COWBOY_SIM_CLOCK_HPP
+
+namespace simClock {
+/**
+ * Returns the simulation time, which starts at zero and advances once per frame.
+ *
+ * @return Simulation time in seconds.
+ */
+double now();
+
+/**
+ * Advances the simulation time by one tick.
+ *
+ * @param deltaTime Duration of the tick in seconds.
+ */
+void advance(double deltaTime);
+}
+
+#endif
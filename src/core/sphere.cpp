@@ -5,8 +5,12 @@
  */
 #include "sphere.hpp"
 
+#include "world_random.hpp"
+
 // Constructors.
 Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude, float smoothness, bool rockyPlanet) {
+	PROFILE_SCOPE("Sphere::Sphere (terrain)");
+
 	// Assertions to check that input parameters make sense.
 	assert(radius > 0);
 	assert(nLatitude > 2);
@@ -17,7 +21,7 @@ Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude, fl
 	normals.reserve(3 * nLatitude * nLongitude);
 	indices.reserve(6 * nLatitude * nLongitude);
 	uvs.reserve(2 * nLatitude * nLongitude);
-	colors = std::vector<GLfloat>(3 * nLatitude * nLongitude, 1.0f);
+	colors = std::vector<float>(3 * nLatitude * nLongitude, 1.0f);
 
 	// deltaTheta is the angle between lines of latitude. deltaPhi is the angle between lines of
 	// longitude.
@@ -54,16 +58,16 @@ Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude, fl
 			normals.push_back(n_y);
 			normals.push_back(n_z);
 
-			//create UVS here, why normals pushed back n_x vs x for vertices, which to push here?
-			uvs.push_back(static_cast <float> (rand()) / static_cast <float>(RAND_MAX));
-			uvs.push_back(static_cast <float> (rand()) / static_cast <float>(RAND_MAX));
-
 			if (longitude == 256) {
 				break;
 			}
 		}
 	}
 
+	// Give every vertex random texture coordinates, drawn in bulk.
+	uvs.resize(vertices.size() / 3 * 2);
+	worldRandom::engine().fill(uvs.data(), uvs.size());
+
 	// Fill the indices.
 	// Break the sphere into groups of squares. Each square is then broken down into two triangles.
 	for (unsigned int latitude = 0; latitude < nLatitude - 1; ++latitude) {
@@ -193,6 +197,8 @@ Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude, fl
 }
 
 Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude) {
+	PROFILE_SCOPE("Sphere::Sphere");
+
 	// Assertions to check that input parameters make sense.
 	assert(radius > 0);
 	assert(nLatitude > 2);
@@ -203,7 +209,7 @@ Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude) {
 	normals.reserve(3 * nLatitude * nLongitude);
 	indices.reserve(6 * nLatitude * nLongitude);
 	uvs.reserve(2 * nLatitude * nLongitude);
-	colors = std::vector<GLfloat>(3 * nLatitude * nLongitude, 1.0f);
+	colors = std::vector<float>(3 * nLatitude * nLongitude, 1.0f);
 
 	// deltaTheta is the angle between lines of latitude. deltaPhi is the angle between lines of
 	// longitude.
@@ -232,13 +238,13 @@ Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude) {
 			normals.push_back(n_x);
 			normals.push_back(n_y);
 			normals.push_back(n_z);
-
-			//create UVS here, why normals pushed back n_x vs x for vertices, which to push here?
-			uvs.push_back(static_cast<float> (rand()) / static_cast<float>(RAND_MAX));
-			uvs.push_back(static_cast<float> (rand()) / static_cast<float>(RAND_MAX));
 		}
 	}
 
+	// Give every vertex random texture coordinates, drawn in bulk.
+	uvs.resize(vertices.size() / 3 * 2);
+	worldRandom::engine().fill(uvs.data(), uvs.size());
+
 	// Fill the indices.
 	// Break the sphere into groups of squares. Each square is then broken down into two triangles.
 	for (unsigned int latitude = 0; latitude < nLatitude - 1; ++latitude) {
@@ -254,7 +260,7 @@ Sphere::Sphere(float radius, unsigned int nLatitude, unsigned int nLongitude) {
 }
 
 float Sphere::getRand(float smoothness, int iteration) {
-	float r       = static_cast <float> (rand()) / static_cast <float>(RAND_MAX);
+	float r       = worldRandom::engine().uniform();
 	float randNum = static_cast <float> ((1.0 * r - 0.5) / pow(smoothness, iteration) / 10);
 	return randNum;
 }
@@ -317,34 +323,3 @@ void Sphere::polarize(std::vector<std::vector<float>>& heightMap) {
 	}
 
 }
-
-void Sphere::textureSphere(const char *textSrc, GLuint& sphere_texture) {
-	glActiveTexture(GL_TEXTURE0); //select texture unit 0
-
-	//GLuint sphere_texture;
-	glGenTextures(1, &sphere_texture);
-	glBindTexture(GL_TEXTURE_2D, sphere_texture); //bind this texture to the currently bound texture unit
-
-	// Set the texture wrapping parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-
-	// Set texture wrapping to GL_REPEAT (usually basic wrapping method)
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-	// Set texture filtering parameters
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	// Load image, create texture and generate mipmaps
-	int           sphere_texture_width, sphere_texture_height;
-	unsigned char *sphere_image = SOIL_load_image(textSrc, &sphere_texture_width,
-	                                              &sphere_texture_height, 0, SOIL_LOAD_RGB);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, sphere_texture_width, sphere_texture_height, 0, GL_RGB,
-	             GL_UNSIGNED_BYTE, sphere_image);
-
-	SOIL_free_image_data(sphere_image); //free resources
-
-	//unbind for safety
-	glBindTexture(GL_TEXTURE_2D, 0);
-}
-
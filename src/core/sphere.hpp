@@ -6,17 +6,15 @@
 #ifndef SPACE_COWBOY_SPHERE_HPP
 #define SPACE_COWBOY_SPHERE_HPP
 
+#include "profiler.hpp"
+
 #include <cassert>
 #include <cmath>
 #include <vector>
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
-#include <time.h>    
 #include <math.h>
 #include <iostream>
 #include <string>
 #include <glm/glm.hpp>
-#include <SOIL/SOIL.h>
 
 /**
  * Contains the mesh data required to render a sphere.
@@ -45,17 +43,17 @@ public:
 
 	// Data members.
 	/** Vertices of the sphere. Each triplet of numbers is a sphere vertex. */
-	std::vector<GLfloat> vertices;
+	std::vector<float>   vertices;
 	/** Sphere normals. Each triplet of numbers is a normal vector of a sphere vertex. */
-	std::vector<GLfloat> normals;
+	std::vector<float>   normals;
 	/** Order in which to render the vertices. */
-	std::vector<GLuint>  indices;
+	std::vector<unsigned int>indices;
 	/**heightmap used to vary the landscape of the spheres*/
 	std::vector<std::vector<float>> heightMap;
 	/**UV coordinates of the sphere. Each pair of numbers correspond to the texture coordinates of a sphere vertex*/
-	std::vector<GLfloat> uvs;
+	std::vector<float>   uvs;
 	/**Color of each vertex in the sphere*/
-	std::vector<GLfloat> colors;
+	std::vector<float>   colors;
 
 
 	//functions
@@ -65,8 +63,6 @@ public:
 	float getRand(float smoothness, int iteration);
 	/**making sure the north and south poles of sphere are the same value*/
 	void polarize(std::vector<std::vector<float>> &heightMap);
-	/**apply texture to sphere based on generated heightmap*/
-	void textureSphere(const char* textSrc, GLuint &sphere_texture);
 
 };
 
@@ -0,0 +1,139 @@
+/**
+ * @file utility.cpp
+ *
+ * Defines general purpose utility functions and classes in the "utility" namespace.
+ */
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utility {
+// Constructors.
+MappedFile::MappedFile(const std::string& path) :
+		mData(nullptr),
+		mSize(0),
+		mMapping(nullptr) {
+	// Map the whole file read-only. Empty files cannot be mapped.
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::runtime_error("File " + path + " cannot be found.");
+	}
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) and size.QuadPart > 0) {
+		mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+	CloseHandle(file);
+	if (mMapping != nullptr) {
+		mData = static_cast<const char *>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+		if (mData == nullptr) {
+			CloseHandle(mMapping);
+			mMapping = nullptr;
+		}
+		else {
+			mSize = static_cast<std::size_t>(size.QuadPart);
+		}
+	}
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw std::runtime_error("File " + path + " cannot be found.");
+	}
+	struct stat status;
+	if (fstat(file, &status) == 0 and S_ISREG(status.st_mode) and status.st_size > 0) {
+		void *data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ,
+		                  MAP_PRIVATE, file, 0);
+		if (data != MAP_FAILED) {
+			mData = static_cast<const char *>(data);
+			mSize = static_cast<std::size_t>(status.st_size);
+		}
+	}
+	close(file);
+#endif
+	if (mData != nullptr) {
+		return;
+	}
+
+	// Read the file in one go instead.
+	std::ifstream in(path, std::ios::binary);
+	if (not in) {
+		throw std::runtime_error("File " + path + " cannot be found.");
+	}
+	in.seekg(0, std::ios::end);
+	std::streamoff size = in.tellg();
+	in.seekg(0, std::ios::beg);
+	mBuffer.resize(static_cast<std::size_t>(std::max<std::streamoff>(size, 0)));
+	if (not in.read(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()))) {
+		throw std::runtime_error("File " + path + " cannot be read.");
+	}
+	mData = mBuffer.data();
+	mSize = mBuffer.size();
+}
+
+// Destructors.
+MappedFile::~MappedFile() {
+	if (not mapped()) {
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(mData);
+	CloseHandle(mMapping);
+#else
+	munmap(const_cast<char *>(mData), mSize);
+#endif
+}
+
+// Accessor functions.
+const char *MappedFile::data() const {
+	return mData;
+}
+
+std::size_t MappedFile::size() const {
+	return mSize;
+}
+
+const char *MappedFile::begin() const {
+	return mData;
+}
+
+const char *MappedFile::end() const {
+	return mData + mSize;
+}
+
+bool MappedFile::mapped() const {
+	return mData != nullptr and mData != mBuffer.data();
+}
+
+#ifdef _WIN32
+void MappedFile::advise(std::size_t, std::size_t, Advice) const { }
+#else
+void MappedFile::advise(std::size_t offset, std::size_t size, Advice advice) const {
+	if (not mapped() or size == 0) {
+		return;
+	}
+
+	// Advice applies to whole pages, so round the range's start down to a page boundary.
+	std::uintptr_t pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+	std::uintptr_t begin    = reinterpret_cast<std::uintptr_t>(mData + offset) / pageSize *
+	                          pageSize;
+	std::uintptr_t end      = reinterpret_cast<std::uintptr_t>(mData + offset + size);
+	madvise(reinterpret_cast<void *>(begin), end - begin,
+	        advice == WILL_NEED ? MADV_WILLNEED : MADV_DONTNEED);
+}
+#endif
+}
@@ -0,0 +1,102 @@
+/**
+ * @file utility.hpp
+ *
+ * Declares general purpose utility functions and classes in the "utility" namespace.
+ */
+#ifndef SPACE_COWBOY_UTILITY_HPP
+#define SPACE_COWBOY_UTILITY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utility {
+/**
+ * Read-only contents of a whole file, memory-mapped so that reading the file costs no copies. Files
+ * that cannot be mapped, such as empty files, are read into memory instead.
+ */
+class MappedFile {
+public:
+	/** How the pages of a range of the file will be used. */
+	enum Advice {
+		/** The range will be read soon, so its pages should be read ahead. */
+		WILL_NEED,
+		/** The range will not be read again soon, so its pages can be dropped. */
+		DONT_NEED
+	};
+
+	// Constructors.
+	/**
+	 * Maps a file, or reads it if it cannot be mapped.
+	 *
+	 * @param path Path of the file.
+	 * @throws std::runtime_error if the file cannot be opened.
+	 */
+	explicit MappedFile(const std::string& path);
+
+	/**
+	 * Copy constructor is disabled as the file holds its mapping.
+	 */
+	MappedFile(const MappedFile&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as the file holds its mapping.
+	 */
+	void operator=(const MappedFile&) = delete;
+
+	// Destructors.
+	/**
+	 * Unmaps the file, invalidating its contents.
+	 */
+	~MappedFile();
+
+	// Accessor functions.
+	/**
+	 * Returns the contents of the file, which are not null-terminated.
+	 */
+	const char *data() const;
+
+	/**
+	 * Returns the size of the file in bytes.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * Returns the start of the contents, to iterate over them.
+	 */
+	const char *begin() const;
+
+	/**
+	 * Returns the end of the contents, to iterate over them.
+	 */
+	const char *end() const;
+
+	/**
+	 * Returns whether the file is mapped rather than read into memory.
+	 */
+	bool mapped() const;
+
+	/**
+	 * Advises the OS how the pages of a range of the file will be used. Does nothing if the file is
+	 * not mapped or where the OS takes no such advice.
+	 *
+	 * @param offset Start of the range in bytes.
+	 * @param size Size of the range in bytes.
+	 * @param advice How the range will be used.
+	 */
+	void advise(std::size_t offset, std::size_t size, Advice advice) const;
+
+private:
+	// Data members.
+	/** Contents of the file. */
+	const char       *mData;
+	/** Size of the file in bytes. */
+	std::size_t       mSize;
+	/** Handle of the file mapping on Windows, unused elsewhere. */
+	void             *mMapping;
+	/** Contents of the file if it is read rather than mapped. */
+	std::vector<char> mBuffer;
+};
+}
+
+#endif
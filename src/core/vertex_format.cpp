@@ -0,0 +1,262 @@
+/**
+ * @file vertex_format.cpp
+ *
+ * Defines the compact vertex formats in the "vertexFormat" namespace.
+ */
+#include "vertex_format.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace vertexFormat {
+namespace {
+/** Largest magnitude of a 16-bit signed normalized integer. */
+constexpr float SNORM16_MAX = 32767.0f;
+
+/** Packed model vertex as a hashable key of two 64-bit words. */
+struct VertexKey {
+	std::uint64_t words[2];
+
+	bool operator==(const VertexKey& other) const {
+		return words[0] == other.words[0] and words[1] == other.words[1];
+	}
+};
+
+/** Hashes a packed model vertex. */
+struct VertexKeyHash {
+	std::size_t operator()(const VertexKey& key) const {
+		return std::hash<std::uint64_t>()(key.words[0] ^ (key.words[1] * 0x9e3779b97f4a7c15ULL));
+	}
+};
+
+static_assert(sizeof(BodyVertex) == 16, "Compact body vertices must take 16 bytes.");
+static_assert(sizeof(ModelVertex) == sizeof(VertexKey),
+              "Compact model vertices must take 16 bytes.");
+
+/**
+ * Returns the quantization fitting a set of positions.
+ *
+ * @param position Returns the position of a vertex by index.
+ * @param nVertices Number of vertices.
+ */
+template <typename Position>
+Quantization fitQuantization(Position position, std::size_t nVertices) {
+	if (nVertices == 0) {
+		return { glm::vec3(0.0f), 1.0f };
+	}
+	glm::vec3 minimum(std::numeric_limits<float>::max());
+	glm::vec3 maximum(std::numeric_limits<float>::lowest());
+	for (std::size_t i = 0; i < nVertices; ++i) {
+		glm::vec3 p = position(i);
+		minimum = glm::vec3(std::min(minimum.x, p.x), std::min(minimum.y, p.y),
+		                    std::min(minimum.z, p.z));
+		maximum = glm::vec3(std::max(maximum.x, p.x), std::max(maximum.y, p.y),
+		                    std::max(maximum.z, p.z));
+	}
+	glm::vec3 halfExtent = 0.5f * (maximum - minimum);
+	float     scale      = std::max(std::max(halfExtent.x, halfExtent.y), halfExtent.z);
+	return { 0.5f * (minimum + maximum), scale > 0.0f ? scale : 1.0f };
+}
+
+/**
+ * Quantizes a position into the padded four components of a compact vertex.
+ */
+void quantizePosition(const glm::vec3& position, const Quantization& quantization,
+                      std::int16_t quantized[4]) {
+	glm::vec3 normalized = (position - quantization.offset) / quantization.scale;
+	quantized[0] = toSnorm16(normalized.x);
+	quantized[1] = toSnorm16(normalized.y);
+	quantized[2] = toSnorm16(normalized.z);
+	quantized[3] = 0;
+}
+
+/**
+ * Quantizes a colour component in [0, 1] to eight bits, rounding to nearest.
+ */
+std::uint8_t toUnorm8(float value) {
+	return static_cast<std::uint8_t>(std::lround(std::min(std::max(value, 0.0f), 1.0f) * 255.0f));
+}
+}
+
+std::int16_t toSnorm16(float value) {
+	float clamped = std::min(std::max(value, -1.0f), 1.0f);
+	return static_cast<std::int16_t>(std::lround(clamped * SNORM16_MAX));
+}
+
+std::uint16_t toHalf(float value) {
+	std::uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	std::uint32_t sign      = (bits >> 16) & 0x8000u;
+	std::uint32_t magnitude = bits & 0x7fffffffu;
+
+	// Infinities and NaNs keep their class; values of 2^16 and beyond overflow.
+	if (magnitude >= 0x7f800000u) {
+		return static_cast<std::uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+	}
+	if (magnitude >= 0x47800000u) {
+		return static_cast<std::uint16_t>(sign | 0x7c00u);
+	}
+
+	// Values below 2^-14 become subnormal halves, shifting the mantissa with its implicit bit.
+	if (magnitude < 0x38800000u) {
+		if (magnitude < 0x33000000u) {
+			return static_cast<std::uint16_t>(sign);
+		}
+		std::uint32_t exponent  = magnitude >> 23;
+		std::uint32_t mantissa  = (magnitude & 0x7fffffu) | 0x800000u;
+		std::uint32_t shift     = 126 - exponent;
+		std::uint32_t half      = mantissa >> shift;
+		std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+		std::uint32_t halfway   = 1u << (shift - 1);
+		if (remainder > halfway or (remainder == halfway and (half & 1u))) {
+			++half;
+		}
+		return static_cast<std::uint16_t>(sign | half);
+	}
+
+	// Rebias the exponent and round the mantissa; a carry correctly rounds up to infinity.
+	std::uint32_t half      = (magnitude - 0x38000000u) >> 13;
+	std::uint32_t remainder = magnitude & 0x1fffu;
+	if (remainder > 0x1000u or (remainder == 0x1000u and (half & 1u))) {
+		++half;
+	}
+	return static_cast<std::uint16_t>(sign | half);
+}
+
+float fromHalf(std::uint16_t half) {
+	std::uint32_t sign     = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+	std::uint32_t exponent = (half >> 10) & 0x1fu;
+	std::uint32_t mantissa = half & 0x3ffu;
+	std::uint32_t bits;
+	if (exponent == 0x1fu) {
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	}
+	else if (exponent != 0) {
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	}
+	else if (mantissa == 0) {
+		bits = sign;
+	}
+	else {
+		// Normalize the subnormal half's mantissa into a float exponent.
+		exponent = 113;
+		while ((mantissa & 0x400u) == 0) {
+			mantissa <<= 1;
+			--exponent;
+		}
+		bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+	}
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+void encodeOctahedral(const glm::vec3& normal, std::int16_t encoded[2]) {
+	// Project onto the octahedron |x| + |y| + |z| = 1 and fold the lower half over the upper.
+	float     norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	glm::vec3 n    = norm > 0.0f ? normal / norm : glm::vec3(0.0f, 0.0f, 1.0f);
+	float     x    = n.x;
+	float     y    = n.y;
+	if (n.z < 0.0f) {
+		x = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	encoded[0] = toSnorm16(x);
+	encoded[1] = toSnorm16(y);
+}
+
+glm::vec3 decodeOctahedral(const std::int16_t encoded[2]) {
+	float     x = std::max(encoded[0] / SNORM16_MAX, -1.0f);
+	float     y = std::max(encoded[1] / SNORM16_MAX, -1.0f);
+	glm::vec3 n(x, y, 1.0f - std::abs(x) - std::abs(y));
+	float     t = std::max(-n.z, 0.0f);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+	return glm::normalize(n);
+}
+
+glm::mat4 dequantization(const Quantization& quantization) {
+	glm::mat4 matrix = glm::translate(glm::mat4(1.0f), quantization.offset);
+	return glm::scale(matrix, glm::vec3(quantization.scale));
+}
+
+glm::vec3 dequantizePosition(const std::int16_t quantized[4], const Quantization& quantization) {
+	glm::vec3 normalized(std::max(quantized[0] / SNORM16_MAX, -1.0f),
+	                     std::max(quantized[1] / SNORM16_MAX, -1.0f),
+	                     std::max(quantized[2] / SNORM16_MAX, -1.0f));
+	return quantization.offset + quantization.scale * normalized;
+}
+
+PackedBodyMesh packBodyMesh(const BodyMesh& mesh) {
+	PROFILE_SCOPE("vertexFormat::packBodyMesh");
+
+	// Vertices are stored as a position followed by a normal, and colours as RGB triplets.
+	std::size_t nVertices = mesh.vertices.size() / 6;
+	const float *vertices = mesh.vertices.data();
+	PackedBodyMesh packed;
+	packed.quantization = fitQuantization([vertices](std::size_t i) {
+		return glm::vec3(vertices[6 * i], vertices[6 * i + 1], vertices[6 * i + 2]);
+	}, nVertices);
+
+	packed.vertices.resize(nVertices);
+	for (std::size_t i = 0; i < nVertices; ++i) {
+		BodyVertex& vertex = packed.vertices[i];
+		quantizePosition(glm::vec3(vertices[6 * i], vertices[6 * i + 1], vertices[6 * i + 2]),
+		                 packed.quantization, vertex.position);
+		encodeOctahedral(glm::vec3(vertices[6 * i + 3], vertices[6 * i + 4], vertices[6 * i + 5]),
+		                 vertex.normal);
+		for (std::size_t c = 0; c < 3; ++c) {
+			std::size_t component = 3 * i + c;
+			float       value     = component < mesh.colours.size() ? mesh.colours[component] : 0.0f;
+			vertex.colour[c] = toUnorm8(value);
+		}
+		vertex.colour[3] = 255;
+	}
+	return packed;
+}
+
+PackedModel packModel(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                      const std::vector<glm::vec2>& uvs) {
+	PROFILE_SCOPE("vertexFormat::packModel");
+
+	PackedModel packed;
+	packed.quantization = fitQuantization([&vertices](std::size_t i) {
+		return vertices[i];
+	}, vertices.size());
+
+	// OBJ files repeat each vertex for every face using it. Merge the vertices that pack to the same
+	// bits and index them instead.
+	std::unordered_map<VertexKey, std::uint32_t, VertexKeyHash> indexOf;
+	indexOf.reserve(vertices.size());
+	packed.indices.reserve(vertices.size());
+	for (std::size_t i = 0; i < vertices.size(); ++i) {
+		ModelVertex vertex;
+		quantizePosition(vertices[i], packed.quantization, vertex.position);
+		encodeOctahedral(i < normals.size() ? normals[i] : glm::vec3(0.0f, 0.0f, 1.0f),
+		                 vertex.normal);
+		glm::vec2 uv = i < uvs.size() ? uvs[i] : glm::vec2(0.0f);
+		vertex.uv[0] = toHalf(uv.x);
+		vertex.uv[1] = toHalf(uv.y);
+
+		VertexKey key;
+		std::memcpy(key.words, &vertex, sizeof(vertex));
+		auto inserted = indexOf.emplace(key, static_cast<std::uint32_t>(packed.vertices.size()));
+		if (inserted.second) {
+			packed.vertices.push_back(vertex);
+		}
+		packed.indices.push_back(inserted.first->second);
+	}
+	return packed;
+}
+
+std::vector<std::uint16_t> narrowIndices(const std::vector<std::uint32_t>& indices) {
+	return std::vector<std::uint16_t>(indices.begin(), indices.end());
+}
+}
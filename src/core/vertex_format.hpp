@@ -0,0 +1,161 @@
+/**
+ * @file vertex_format.hpp
+ *
+ * Interface file for the compact vertex formats, in the "vertexFormat" namespace.
+ */
+#ifndef SPACE_COWBOY_VERTEX_FORMAT_HPP
+#define SPACE_COWBOY_VERTEX_FORMAT_HPP
+
+#include "world.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * Packs meshes into compact interleaved vertices for uploading. Positions are quantized to 16-bit
+ * signed normalized integers relative to the mesh's bounding box, normals are octahedral-encoded
+ * into two 16-bit signed normalized integers, body colours become RGBA8 and texture coordinates
+ * half floats. Every compact vertex takes 16 bytes, against 36 bytes for a body vertex and 32 bytes
+ * for a model vertex in the float layout. The packing has no OpenGL dependency; the renderers
+ * upload the packed data and undo the position quantization with the mesh's dequantization matrix.
+ */
+namespace vertexFormat {
+/** Largest number of vertices a mesh may have to be indexed with 16-bit indices. */
+constexpr std::size_t MAX_SHORT_INDEXED_VERTICES = 65536;
+
+/** Maps quantized positions back to the mesh's own space: position = offset + scale * quantized. */
+struct Quantization {
+	/** Centre of the mesh's bounding box. */
+	glm::vec3 offset;
+	/** Half the largest extent of the mesh's bounding box. */
+	float     scale;
+};
+
+/** Compact vertex of a planet, moon or asteroid mesh. */
+struct BodyVertex {
+	/** Quantized position, padded to four components to keep the normal aligned. */
+	std::int16_t position[4];
+	/** Octahedral-encoded normal. */
+	std::int16_t normal[2];
+	/** RGBA8 colour, fully opaque. */
+	std::uint8_t colour[4];
+};
+
+/** Compact vertex of a textured model. */
+struct ModelVertex {
+	/** Quantized position, padded to four components to keep the normal aligned. */
+	std::int16_t  position[4];
+	/** Octahedral-encoded normal. */
+	std::int16_t  normal[2];
+	/** Texture coordinates as half floats, which unlike normalized integers may leave [0, 1]. */
+	std::uint16_t uv[2];
+};
+
+/** Body mesh in the compact layout. */
+struct PackedBodyMesh {
+	/** Interleaved vertices, in the order of the source mesh's, so that its indices still apply. */
+	std::vector<BodyVertex> vertices;
+	/** Position quantization of the vertices. */
+	Quantization            quantization;
+};
+
+/** Textured model in the compact layout, indexed after merging identical vertices. */
+struct PackedModel {
+	/** Interleaved distinct vertices. */
+	std::vector<ModelVertex>   vertices;
+	/** Order in which to render the vertices. */
+	std::vector<std::uint32_t> indices;
+	/** Position quantization of the vertices. */
+	Quantization               quantization;
+};
+
+/**
+ * Quantizes a value in [-1, 1] to a 16-bit signed normalized integer, rounding to nearest.
+ *
+ * @param value Value to quantize. Values outside [-1, 1] are clamped.
+ * @return Quantized value.
+ */
+std::int16_t toSnorm16(float value);
+
+/**
+ * Converts a float to a half float, rounding to nearest even. Overflows become infinities.
+ *
+ * @param value Value to convert.
+ * @return Bits of the half float.
+ */
+std::uint16_t toHalf(float value);
+
+/**
+ * Converts a half float to a float. Exact for every half float.
+ *
+ * @param half Bits of the half float.
+ * @return Converted value.
+ */
+float fromHalf(std::uint16_t half);
+
+/**
+ * Encodes a unit vector with the octahedral mapping, as the vertex shaders decode it.
+ *
+ * @param normal Unit vector to encode.
+ * @param encoded Receives the two quantized components.
+ */
+void encodeOctahedral(const glm::vec3& normal, std::int16_t encoded[2]);
+
+/**
+ * Decodes an octahedral-encoded unit vector.
+ *
+ * @param encoded Quantized components.
+ * @return Decoded unit vector.
+ */
+glm::vec3 decodeOctahedral(const std::int16_t encoded[2]);
+
+/**
+ * Returns the matrix mapping quantized positions, as the GPU normalizes them, to the mesh's space.
+ * Post-multiply it into a mesh's model matrix.
+ *
+ * @param quantization Quantization of the mesh.
+ * @return Dequantization matrix.
+ */
+glm::mat4 dequantization(const Quantization& quantization);
+
+/**
+ * Dequantizes a compact position back to the mesh's space.
+ *
+ * @param quantized Quantized position.
+ * @param quantization Quantization of the mesh.
+ * @return Position.
+ */
+glm::vec3 dequantizePosition(const std::int16_t quantized[4], const Quantization& quantization);
+
+/**
+ * Packs a body mesh into the compact layout.
+ *
+ * @param mesh Mesh in the float layout.
+ * @return Compact mesh.
+ */
+PackedBodyMesh packBodyMesh(const BodyMesh& mesh);
+
+/**
+ * Packs a model loaded from an OBJ file into the compact layout, merging vertices that are
+ * identical once packed so that the model can be indexed.
+ *
+ * @param vertices Position of each vertex of the triangles.
+ * @param normals Normal of each vertex.
+ * @param uvs Texture coordinates of each vertex.
+ * @return Compact indexed model.
+ */
+PackedModel packModel(const std::vector<glm::vec3>& vertices, const std::vector<glm::vec3>& normals,
+                      const std::vector<glm::vec2>& uvs);
+
+/**
+ * Narrows indices to 16 bits. Only valid if every index is below MAX_SHORT_INDEXED_VERTICES.
+ *
+ * @param indices Indices to narrow.
+ * @return Narrowed indices.
+ */
+std::vector<std::uint16_t> narrowIndices(const std::vector<std::uint32_t>& indices);
+}
+
+#endif
@@ -0,0 +1,360 @@
+/**
+ * @file world.cpp
+ *
+ * Implementation file for the World struct.
+ */
+#include "world.hpp"
+
+#include "noise.hpp"
+#include "profiler.hpp"
+#include "sphere.hpp"
+#include "world_random.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+/** Enumerated planet types. */
+enum TERRAIN_TYPE {
+	ROCKY, GASEOUS
+};
+
+// Random streams.
+/** First random stream of the planets' meshes and colours, one stream per planet. */
+constexpr std::uint64_t PLANET_STREAMS  = 1ull << 32;
+/** First random stream of the moons' meshes and colours, one stream per moon. */
+constexpr std::uint64_t MOON_STREAMS    = 2ull << 32;
+/** Random stream of the asteroid mesh. */
+constexpr std::uint64_t ASTEROID_STREAM = 3ull << 32;
+
+// Sun properties.
+/** Size of Sun. */
+constexpr float SUN_SIZE = 800.5f;
+
+// Mesh properties.
+/** Number of lines of latitude and longitude of planet and moon meshes. */
+constexpr unsigned int MESH_RESOLUTION          = NOISE_SIZE;
+/** Number of lines of latitude and longitude of the asteroid mesh. */
+constexpr unsigned int ASTEROID_MESH_RESOLUTION = 17;
+/** Mean terrain smoothness of rocky bodies. */
+constexpr float        MEAN_ROCKY_SMOOTHNESS = 1.1f;
+/** Standard deviation of the terrain smoothness of rocky bodies. */
+constexpr float        SDEV_ROCKY_SMOOTHNESS = 0.1f;
+/** Terrain smoothness of gaseous bodies. */
+constexpr float        GASEOUS_SMOOTHNESS    = 5.0f;
+
+// Planet generation.
+constexpr float MEAN_NUMBER_OF_ROCKY_PLANETS = 5.0f;
+constexpr float SDEV_NUMBER_OF_ROCKY_PLANETS = 2.0f;
+
+constexpr float MEAN_NUMBER_OF_GASEOUS_PLANETS = 10.0f;
+constexpr float SDEV_NUMBER_OF_GASEOUS_PLANETS = 3.0f;
+
+constexpr float MEAN_ROCKY_PLANET_SIZE = 1600.0f;
+constexpr float SDEV_ROCKY_PLANET_SIZE = 80.0f;
+
+constexpr float MEAN_GASEOUS_PLANET_SIZE = 4000.0f;
+constexpr float SDEV_GASEOUS_PLANET_SIZE = 100.0f;
+
+constexpr float MEAN_ROCKY_PLANET_DISTANCE   = 8.0f * MEAN_ROCKY_PLANET_SIZE;
+constexpr float SDEV_ROCKY_PLANET_DISTANCE   = 2.0f * MEAN_ROCKY_PLANET_SIZE;
+constexpr float MEAN_GASEOUS_PLANET_DISTANCE = 8.0f * MEAN_GASEOUS_PLANET_SIZE;
+constexpr float SDEV_GASEOUS_PLANET_DISTANCE = 2.0f * MEAN_GASEOUS_PLANET_SIZE;
+
+constexpr float MIN_ROCKY_PLANET_ORBIT_RADIUS = 1500.0f;
+
+constexpr float MEAN_ANGULAR_VELOCITY = 0.2f;
+constexpr float SDEV_ANGULAR_VELOCITY = 0.1f;
+
+// Moon generation.
+constexpr float NUM_MOONS_AVERAGE_PLANET = 2.0f;
+
+constexpr float MIN_MOON_SIZE_FACTOR = 0.05f;
+constexpr float MAX_MOON_SIZE_FACTOR = 0.2f;
+
+constexpr float MIN_MOON_DISTANCE_FACTOR = 2.0f;
+constexpr float MAX_MOON_DISTANCE_FACTOR = 4.0f;
+
+// Asteroid generation.
+constexpr float MIN_ASTEROID_SIZE = 20.0f;
+constexpr float MAX_ASTEROID_SIZE = 120.0f;
+
+/** Standard deviation of the asteroids' height above the orbital plane. */
+constexpr float SDEV_ASTEROID_HEIGHT = 400.0f;
+
+/** Grey level of the asteroid mesh. */
+constexpr float ASTEROID_SHADE = 0.45f;
+
+/**
+ * Generates the mesh of a planet or moon: a sphere of unit radius whose terrain is displaced by the
+ * diamond-square algorithm when rocky.
+ *
+ * @param rocky Whether the body has a rocky terrain.
+ * @param resolution Number of lines of latitude and longitude.
+ * @return Generated mesh, with white vertex colours.
+ */
+BodyMesh generateMesh(bool rocky, unsigned int resolution = MESH_RESOLUTION) {
+	float smoothness = GASEOUS_SMOOTHNESS;
+	if (rocky) {
+		smoothness = worldRandom::normal(MEAN_ROCKY_SMOOTHNESS, SDEV_ROCKY_SMOOTHNESS);
+	}
+
+	Sphere sphere(1.0f, resolution, resolution, smoothness, rocky);
+
+	// Combine the vertices and normals into a single vector such that each triplet of vertex
+	// components is followed by the components of the vertex's normal.
+	BodyMesh mesh;
+	mesh.vertices.reserve(2 * sphere.vertices.size());
+	for (std::size_t i = 0; i < sphere.vertices.size(); i += 3) {
+		mesh.vertices.insert(mesh.vertices.end(), &sphere.vertices[i], &sphere.vertices[i] + 3);
+		mesh.vertices.insert(mesh.vertices.end(), &sphere.normals[i], &sphere.normals[i] + 3);
+	}
+	mesh.indices = std::move(sphere.indices);
+	mesh.colours = std::move(sphere.colors);
+
+	return mesh;
+}
+
+/**
+ * Procedurally generates planets of one type and appends them to the world.
+ *
+ * @param world World to add the planets to.
+ * @param planetType Planet type to generate.
+ * @param minDistance Orbit radius of the innermost planet, before its random spacing is added.
+ */
+void generatePlanets(World& world, TERRAIN_TYPE planetType, float minDistance) {
+	PROFILE_SCOPE("generatePlanets");
+
+	bool  rocky = planetType == ROCKY;
+	float MEAN_NUMBER_OF_PLANETS;
+	float SDEV_NUMBER_OF_PLANETS;
+	float MEAN_PLANET_SIZE;
+	float SDEV_PLANET_SIZE;
+	float MEAN_PLANET_DISTANCE;
+	float SDEV_PLANET_DISTANCE;
+
+	if (rocky) {
+		MEAN_NUMBER_OF_PLANETS = MEAN_NUMBER_OF_ROCKY_PLANETS;
+		SDEV_NUMBER_OF_PLANETS = SDEV_NUMBER_OF_ROCKY_PLANETS;
+		MEAN_PLANET_SIZE       = MEAN_ROCKY_PLANET_SIZE;
+		SDEV_PLANET_SIZE       = SDEV_ROCKY_PLANET_SIZE;
+		MEAN_PLANET_DISTANCE   = MEAN_ROCKY_PLANET_DISTANCE;
+		SDEV_PLANET_DISTANCE   = SDEV_ROCKY_PLANET_DISTANCE;
+	}
+	else {
+		MEAN_NUMBER_OF_PLANETS = MEAN_NUMBER_OF_GASEOUS_PLANETS;
+		SDEV_NUMBER_OF_PLANETS = SDEV_NUMBER_OF_GASEOUS_PLANETS;
+		MEAN_PLANET_SIZE       = MEAN_GASEOUS_PLANET_SIZE;
+		SDEV_PLANET_SIZE       = SDEV_GASEOUS_PLANET_SIZE;
+		MEAN_PLANET_DISTANCE   = MEAN_GASEOUS_PLANET_DISTANCE;
+		SDEV_PLANET_DISTANCE   = SDEV_GASEOUS_PLANET_DISTANCE;
+	}
+
+	// Set number of planets, at least one of each type, which the asteroid belt lies between.
+	std::size_t numberOfPlanets = static_cast<std::size_t>(
+			std::max(worldRandom::normal(MEAN_NUMBER_OF_PLANETS, SDEV_NUMBER_OF_PLANETS), 1.0f));
+	std::size_t first           = world.planets.size();
+
+	// Each planet's mesh and colours are drawn from its own stream, independently of the other
+	// planets.
+	world.planets.resize(first + numberOfPlanets);
+	for (std::size_t i = first; i < world.planets.size(); ++i) {
+		worldRandom::ScopedStream stream(PLANET_STREAMS + i);
+		world.planetMeshes.push_back(generateMesh(rocky));
+		if (rocky) {
+			generateColours(world.planetMeshes[i].colours, getDarkColor(), getDarkColor(), 0.0, 0.0,
+			                100.0, 32.0);
+		}
+		else {
+			generateColours(world.planetMeshes[i].colours, getBrightColor(), getDarkColor(), 5.0,
+			                10.0, 10.0, 32.0);
+		}
+	}
+
+	// Change Size of each planet
+	for (std::size_t i = first; i < world.planets.size(); ++i) {
+		float scaleFactor = worldRandom::normal(MEAN_PLANET_SIZE, SDEV_PLANET_SIZE);
+		world.planets[i].scale = glm::scale(glm::mat4(),
+		                                    glm::vec3(scaleFactor, scaleFactor, scaleFactor));
+	}
+
+	// Change orbit
+	float orbitRadius = minDistance;
+	for (std::size_t i = first; i < world.planets.size(); ++i) {
+		if (i > first) {
+			orbitRadius = glm::length(world.planets[i - 1].position());
+		}
+		orbitRadius += worldRandom::normal(MEAN_PLANET_DISTANCE, SDEV_PLANET_DISTANCE);
+		float randomAngle = worldRandom::uniform(0.0f, static_cast<float>(2.0 * M_PI));
+		world.planets[i].translation = glm::translate(
+				glm::mat4(), glm::vec3(orbitRadius * glm::cos(randomAngle), 0,
+				                       orbitRadius * glm::sin(randomAngle)));
+	}
+
+	// Change orbital angular velocity
+	for (std::size_t i = first; i < world.planets.size(); ++i) {
+		Body& planet = world.planets[i];
+		planet.orbitalAngularVelocity =
+				{ 0, 2.0f * pow(1.0f / glm::length(planet.position()), 2.0f / 3.0f), 0 };
+	}
+
+	// Change angular velocity
+	for (std::size_t i = first; i < world.planets.size(); ++i) {
+		world.planets[i].angularVelocity = {
+				0, worldRandom::normal(MEAN_ANGULAR_VELOCITY, SDEV_ANGULAR_VELOCITY), 0 };
+	}
+}
+
+/**
+ * Procedurally generates moons for each of the world's planets.
+ *
+ * @param world World to add the moons to.
+ */
+void generateMoons(World& world) {
+	PROFILE_SCOPE("generateMoons");
+
+	// Get the planet of each moon.
+	for (std::size_t j = 0; j < world.planets.size(); ++j) {
+		int nMoons = static_cast<int>(NUM_MOONS_AVERAGE_PLANET * world.planets[j].size() /
+		                              MEAN_ROCKY_PLANET_SIZE);
+		world.moonPrimaries.insert(world.moonPrimaries.end(), static_cast<std::size_t>(nMoons), j);
+	}
+
+	// Each moon's mesh and colours are drawn from its own stream, independently of the other moons.
+	world.moons.resize(world.moonPrimaries.size());
+	for (std::size_t i = 0; i < world.moons.size(); ++i) {
+		worldRandom::ScopedStream stream(MOON_STREAMS + i);
+		world.moonMeshes.push_back(generateMesh(true));
+
+		glm::vec3 primaryColor { worldRandom::normal(0.7f, 0.2f) };
+		glm::vec3 secondaryColor { worldRandom::normal(0.3f, 0.2f) };
+		generateColours(world.moonMeshes[i].colours, primaryColor, secondaryColor, 0.0, 0.0, 100.0,
+		                32.0);
+	}
+
+	// Set properties for each moon.
+	for (std::size_t i = 0; i < world.moons.size(); ++i) {
+		Body&       moon   = world.moons[i];
+		const Body& planet = world.planets[world.moonPrimaries[i]];
+
+		// Set moon size.
+		float scaleFactor = worldRandom::uniform(MIN_MOON_SIZE_FACTOR, MAX_MOON_SIZE_FACTOR);
+		scaleFactor *= planet.size();
+		moon.scale = glm::scale(glm::mat4(), glm::vec3(scaleFactor, scaleFactor, scaleFactor));
+
+		// Position the moon.
+		float angle       = worldRandom::uniform(0.0f, 2 * static_cast<float>(M_PI));
+		float orbitRadius = worldRandom::uniform(MIN_MOON_DISTANCE_FACTOR * planet.size(),
+		                                         MAX_MOON_DISTANCE_FACTOR * planet.size());
+		moon.translation = glm::translate(glm::mat4(), planet.position() +
+		                                               glm::vec3(orbitRadius * glm::cos(angle), 0.0f,
+		                                                         orbitRadius * glm::sin(angle)));
+
+		// Set orbital angular velocity.
+		float orbitalAngularSpeed = 15.0f * static_cast<float>(pow(1.0f / orbitRadius, 2.0f / 3.0f));
+		moon.orbitalAngularVelocity = glm::vec3(0.0f, orbitalAngularSpeed, 0.0f);
+
+		// Set angular velocity.
+		float angularSpeed = worldRandom::uniform(-orbitalAngularSpeed, orbitalAngularSpeed);
+		moon.angularVelocity = glm::vec3(0.0f, angularSpeed, 0.0f);
+	}
+}
+}
+
+World generateWorld() {
+	PROFILE_SCOPE("generateWorld");
+
+	World world;
+	world.sun.scale = glm::scale(glm::mat4(), glm::vec3(SUN_SIZE, SUN_SIZE, SUN_SIZE));
+
+	// Rocky planets orbit closest to the sun, gaseous planets beyond the outermost rocky planet.
+	generatePlanets(world, ROCKY, MIN_ROCKY_PLANET_ORBIT_RADIUS);
+	world.nRockyPlanets = world.planets.size();
+	generatePlanets(world, GASEOUS, glm::length(world.planets.back().position()));
+
+	generateMoons(world);
+
+	// Choose a random gaseous planet on which to spawn the spacecowboy.
+	world.cowboyPlanet = worldRandom::integer(world.nRockyPlanets, world.planets.size() - 1);
+
+	return world;
+}
+
+void generateAsteroids(World& world, std::size_t nAsteroids) {
+	PROFILE_SCOPE("generateAsteroids");
+
+	// Every asteroid shares one small grey mesh, drawn from its own stream.
+	{
+		worldRandom::ScopedStream stream(ASTEROID_STREAM);
+		world.asteroidMesh = generateMesh(true, ASTEROID_MESH_RESOLUTION);
+	}
+	for (float& colour : world.asteroidMesh.colours) {
+		colour = ASTEROID_SHADE;
+	}
+
+	// Scatter the asteroids in a belt between the outermost rocky planet and the innermost gaseous
+	// planet, clear of both.
+	const Body& innerPlanet = world.planets[world.nRockyPlanets - 1];
+	const Body& outerPlanet = world.planets[world.nRockyPlanets];
+	float minRadius = glm::length(innerPlanet.position()) + 2.0f * innerPlanet.size();
+	float maxRadius = std::max(glm::length(outerPlanet.position()) - 2.0f * outerPlanet.size(),
+	                           minRadius + MEAN_ROCKY_PLANET_DISTANCE);
+
+	world.asteroids.resize(nAsteroids);
+	for (Body& asteroid : world.asteroids) {
+		float size = worldRandom::uniform(MIN_ASTEROID_SIZE, MAX_ASTEROID_SIZE);
+		asteroid.scale = glm::scale(glm::mat4(), glm::vec3(size, size, size));
+
+		float orbitRadius = worldRandom::uniform(minRadius, maxRadius);
+		float angle       = worldRandom::uniform(0.0f, 2 * static_cast<float>(M_PI));
+		float height      = worldRandom::normal(0.0f, SDEV_ASTEROID_HEIGHT);
+		asteroid.translation = glm::translate(
+				glm::mat4(), glm::vec3(orbitRadius * glm::cos(angle), height,
+				                       orbitRadius * glm::sin(angle)));
+
+		// Orbit like a planet at the same distance.
+		asteroid.orbitalAngularVelocity = { 0, 2.0f * pow(1.0f / orbitRadius, 2.0f / 3.0f), 0 };
+		asteroid.angularVelocity        = {
+				0, worldRandom::normal(MEAN_ANGULAR_VELOCITY, SDEV_ANGULAR_VELOCITY), 0 };
+	}
+}
+
+void updateWorld(World& world, float deltaT) {
+	PROFILE_SCOPE("updateWorld");
+
+	// Planets first, as the moons follow the planets' new positions.
+	for (Body& planet : world.planets) {
+		advanceBody(planet, deltaT);
+	}
+	for (std::size_t i = 0; i < world.moons.size(); ++i) {
+		advanceMoon(world.moons[i], world.planets[world.moonPrimaries[i]], deltaT);
+	}
+	for (Body& asteroid : world.asteroids) {
+		advanceBody(asteroid, deltaT);
+	}
+}
+
+bool worldCollision(const World& world, const glm::vec3& cameraPosition,
+                    const glm::vec3& cameraDirection, glm::vec3& bounce) {
+	const Body *pHit = nullptr;
+	if (bodyCollision(world.sun, cameraPosition, cameraDirection)) {
+		pHit = &world.sun;
+	}
+	for (std::size_t i = 0; pHit == nullptr and i < world.planets.size(); ++i) {
+		if (bodyCollision(world.planets[i], cameraPosition, cameraDirection)) {
+			pHit = &world.planets[i];
+		}
+	}
+	for (std::size_t i = 0; pHit == nullptr and i < world.moons.size(); ++i) {
+		if (bodyCollision(world.moons[i], cameraPosition, cameraDirection)) {
+			pHit = &world.moons[i];
+		}
+	}
+
+	if (pHit == nullptr) {
+		return false;
+	}
+	bounce = glm::normalize(cameraPosition - pHit->position());
+	return true;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file world.hpp
+ *
+ * Interface file for the World struct, the simulation state of the solar system.
+ */
+#ifndef SPACE_COWBOY_WORLD_HPP
+#define SPACE_COWBOY_WORLD_HPP
+
+#include "body.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Terrain bounds.
+/** Radius of a sphere inside every body mesh, relative to the body's size. */
+constexpr float MIN_TERRAIN_RADIUS = 0.8f;
+/** Radius of a sphere around every body mesh, relative to the body's size. */
+constexpr float MAX_TERRAIN_RADIUS = 1.2f;
+
+/**
+ * Generated mesh of a planet or moon, ready to be uploaded by the renderer.
+ */
+struct BodyMesh {
+	/** Vertex data. Each triplet of vertex components is followed by the vertex's normal. */
+	std::vector<float>        vertices;
+	/** Order in which to render the vertices. */
+	std::vector<unsigned int> indices;
+	/** Colour of each vertex. */
+	std::vector<float>        colours;
+};
+
+/**
+ * Simulation state of the solar system: a sun at the origin, planets orbiting it and moons orbiting
+ * the planets. Holds plain data only, so a world can be generated, advanced and tested for
+ * collisions without an OpenGL context.
+ */
+struct World {
+	/** The sun. */
+	Body                     sun;
+	/** Planets, the rocky ones first followed by the gaseous ones. */
+	std::vector<Body>        planets;
+	/** Mesh of each planet. */
+	std::vector<BodyMesh>    planetMeshes;
+	/** Number of rocky planets at the front of planets. */
+	std::size_t              nRockyPlanets;
+	/** Moons, grouped by the planet they orbit. */
+	std::vector<Body>        moons;
+	/** Index of the planet each moon orbits. */
+	std::vector<std::size_t> moonPrimaries;
+	/** Mesh of each moon. */
+	std::vector<BodyMesh>    moonMeshes;
+	/** Asteroids, only generated on request to stress the renderer. Not collided with. */
+	std::vector<Body>        asteroids;
+	/** Mesh shared by every asteroid. */
+	BodyMesh                 asteroidMesh;
+	/** Index of the planet the spacecowboy stands on. */
+	std::size_t              cowboyPlanet;
+};
+
+/**
+ * Procedurally generates a world from the world random number engine, so that the same seed always
+ * generates the same world. Number of planets, size, angular velocity and number of moons of each
+ * planet follow gaussian distributions. Orbital angular velocities follow Kepler's third law.
+ *
+ * @return Generated world.
+ */
+World generateWorld();
+
+/**
+ * Procedurally generates a belt of asteroids between the rocky and the gaseous planets of a world,
+ * replacing any previous asteroids. The asteroids share one low-resolution mesh and orbit like
+ * planets at their distance.
+ *
+ * @param world World to add the asteroids to.
+ * @param nAsteroids Number of asteroids to generate.
+ */
+void generateAsteroids(World& world, std::size_t nAsteroids);
+
+/**
+ * Advances every planet, moon and asteroid of a world by a time step.
+ *
+ * @param world World to advance.
+ * @param deltaT Time step in seconds.
+ */
+void updateWorld(World& world, float deltaT);
+
+/**
+ * Tests whether the spaceship in front of a camera touches any body of a world.
+ *
+ * @param world World to test.
+ * @param cameraPosition Position of the camera.
+ * @param cameraDirection Viewing direction of the camera.
+ * @param bounce Set to the direction pointing away from the touched body, if any.
+ * @return True if the spaceship touches a body, false otherwise.
+ */
+bool worldCollision(const World& world, const glm::vec3& cameraPosition,
+                    const glm::vec3& cameraDirection, glm::vec3& bounce);
+
+#endif
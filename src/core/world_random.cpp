@@ -0,0 +1,147 @@
+/**
+ * @file world_random.cpp
+ *
+ * Defines the random number generators used to generate the world, in the "worldRandom" namespace.
+ */
+#include "world_random.hpp"
+
+#include <cmath>
+#include <random>
+
+namespace worldRandom {
+// Redeclare constant static data members.
+constexpr unsigned int Generator::BLOCK_SIZE;
+constexpr float        Generator::FLOAT_SCALE;
+
+namespace {
+/** Number of Philox rounds per block. */
+constexpr unsigned int  N_ROUNDS       = 10;
+/** Multipliers of the Philox rounds. */
+constexpr std::uint64_t MULTIPLIERS[2] = { 0xD2511F53, 0xCD9E8D57 };
+/** Increments of the key between rounds. */
+constexpr std::uint32_t KEY_BUMPS[2]   = { 0x9E3779B9, 0xBB67AE85 };
+
+/** World seed. */
+std::uint32_t sSeed = 0;
+/** World generator. */
+Generator     sEngine;
+
+/** Generator of the calling thread's innermost scoped stream, or nullptr if it has none. */
+thread_local Generator *tCurrent = nullptr;
+}
+
+// Constructors.
+Generator::Generator(std::uint64_t seed, std::uint64_t stream) :
+		mKey{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) },
+		mStream(stream),
+		mCounter(0),
+		mBlock(),
+		mIndex(BLOCK_SIZE) { }
+
+// Mutator functions.
+void Generator::fill(float *values, std::size_t n) {
+	// Use up the buffered outputs first, then write whole blocks straight into the array.
+	std::size_t i = 0;
+	for (; i < n and mIndex < BLOCK_SIZE; ++i) {
+		values[i] = uniform();
+	}
+
+	std::size_t nBlocks = (n - i) / BLOCK_SIZE;
+	float       *out    = values + i;
+	for (std::size_t b = 0; b < nBlocks; ++b) {
+		Block outputs = block(mCounter + b);
+		for (unsigned int j = 0; j < BLOCK_SIZE; ++j) {
+			out[b * BLOCK_SIZE + j] = static_cast<float>(outputs[j] >> 8) * FLOAT_SCALE;
+		}
+	}
+	mCounter += nBlocks;
+
+	for (i += nBlocks * BLOCK_SIZE; i < n; ++i) {
+		values[i] = uniform();
+	}
+}
+
+// Helper functions.
+Generator::Block Generator::block(std::uint64_t counter) const {
+	std::uint32_t x[4] = { static_cast<std::uint32_t>(counter),
+	                       static_cast<std::uint32_t>(counter >> 32),
+	                       static_cast<std::uint32_t>(mStream),
+	                       static_cast<std::uint32_t>(mStream >> 32) };
+	std::uint32_t key[2] = { mKey[0], mKey[1] };
+	for (unsigned int round = 0; round < N_ROUNDS; ++round) {
+		std::uint64_t product0 = MULTIPLIERS[0] * x[0];
+		std::uint64_t product1 = MULTIPLIERS[1] * x[2];
+		x[0] = static_cast<std::uint32_t>(product1 >> 32) ^ x[1] ^ key[0];
+		x[1] = static_cast<std::uint32_t>(product1);
+		x[2] = static_cast<std::uint32_t>(product0 >> 32) ^ x[3] ^ key[1];
+		x[3] = static_cast<std::uint32_t>(product0);
+		key[0] += KEY_BUMPS[0];
+		key[1] += KEY_BUMPS[1];
+	}
+	return { { x[0], x[1], x[2], x[3] } };
+}
+
+void Generator::nextBlock() {
+	mBlock = block(mCounter++);
+	mIndex = 0;
+}
+
+// Constructors.
+ScopedStream::ScopedStream(std::uint64_t stream) :
+		mGenerator(sSeed, stream),
+		mPrevious(tCurrent) {
+	tCurrent = &mGenerator;
+}
+
+// Destructors.
+ScopedStream::~ScopedStream() {
+	tCurrent = mPrevious;
+}
+
+std::uint32_t randomSeed() {
+	std::random_device rd;
+	return rd();
+}
+
+void setSeed(std::uint32_t seed) {
+	sSeed   = seed;
+	sEngine = Generator(seed);
+}
+
+std::uint32_t seed() {
+	return sSeed;
+}
+
+Generator stream(std::uint64_t stream) {
+	return Generator(sSeed, stream);
+}
+
+Generator& engine() {
+	return tCurrent != nullptr ? *tCurrent : sEngine;
+}
+
+float uniform(float min, float max) {
+	return min + (max - min) * engine().uniform();
+}
+
+float normal(float mean, float sdev) {
+	// Draw the radius from (0, 1] so that its logarithm is finite, and use one value of the pair.
+	Generator& generator = engine();
+	double     radius    = 1.0 - generator.uniform();
+	double     angle     = 2.0 * M_PI * generator.uniform();
+	return mean + sdev * static_cast<float>(std::sqrt(-2.0 * std::log(radius)) * std::cos(angle));
+}
+
+std::size_t integer(std::size_t first, std::size_t last) {
+	// Scale a 32-bit output to the range, rejecting the few outputs that would favour some values
+	// (Lemire's method).
+	Generator&    generator = engine();
+	std::uint64_t range     = static_cast<std::uint64_t>(last - first) + 1;
+	std::uint64_t threshold = ((std::uint64_t(1) << 32) - range) % range;
+	std::uint64_t product   = generator() * range;
+	while ((product & 0xFFFFFFFF) < threshold) {
+		product = generator() * range;
+	}
+	return first + static_cast<std::size_t>(product >> 32);
+}
+}
@@ -0,0 +1,231 @@
+/**
+ * @file world_random.hpp
+ *
+ * Declares the random number generators used to generate the world, in the "worldRandom"
+ * namespace. Every generator derives from a single world seed, which makes world generation
+ * reproducible, including the parts generated on other threads.
+ */
+#ifndef SPACE_COWBOY_WORLD_RANDOM_HPP
+#define SPACE_COWBOY_WORLD_RANDOM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace worldRandom {
+/**
+ * Counter-based random number generator (Philox4x32-10). Each block of four outputs is a keyed
+ * bijection of its counter, which is the block's index within the generator's stream followed by
+ * the stream's index. Generators seeded alike but on different streams are thus independent, and
+ * blocks need no previous state, so that bulk fills compute them in parallel. Satisfies the
+ * uniform random bit generator requirements, so it drives the <random> distributions. Not
+ * suitable for cryptography.
+ */
+class Generator {
+public:
+	/** Type of the outputs. */
+	typedef std::uint32_t result_type;
+
+	// Constructors.
+	/**
+	 * Creates a generator at the start of a stream.
+	 *
+	 * @param seed Seed, the key of every block.
+	 * @param stream Index of the stream.
+	 */
+	explicit Generator(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+	// Accessor functions.
+	/**
+	 * Returns the smallest output.
+	 */
+	static constexpr result_type min() {
+		return 0;
+	}
+
+	/**
+	 * Returns the largest output.
+	 */
+	static constexpr result_type max() {
+		return std::numeric_limits<result_type>::max();
+	}
+
+	// Mutator functions.
+	/**
+	 * Returns the next output.
+	 *
+	 * @return Uniformly distributed 32-bit value.
+	 */
+	result_type operator()() {
+		if (mIndex == BLOCK_SIZE) {
+			nextBlock();
+		}
+		return mBlock[mIndex++];
+	}
+
+	/**
+	 * Returns a float uniformly distributed in [0, 1), from the top 24 bits of the next output.
+	 *
+	 * @return Random float.
+	 */
+	float uniform() {
+		return static_cast<float>((*this)() >> 8) * FLOAT_SCALE;
+	}
+
+	/**
+	 * Fills an array with floats uniformly distributed in [0, 1): the values that many calls to
+	 * uniform() would return. Whole blocks are computed together, which the compiler vectorizes.
+	 *
+	 * @param values Array to fill.
+	 * @param n Number of values.
+	 */
+	void fill(float *values, std::size_t n);
+
+private:
+	// Constants.
+	/** Number of outputs of a block. */
+	static constexpr unsigned int BLOCK_SIZE  = 4;
+	/** Scale from 24 random bits to [0, 1). */
+	static constexpr float        FLOAT_SCALE = 1.0f / 16777216.0f;
+
+	/** Four outputs of one counter. */
+	typedef std::array<std::uint32_t, BLOCK_SIZE> Block;
+
+	// Helper functions.
+	/**
+	 * Computes the block of a counter of the generator's stream.
+	 *
+	 * @param counter Index of the block within the stream.
+	 * @return Block.
+	 */
+	Block block(std::uint64_t counter) const;
+
+	/**
+	 * Computes the next block into the buffered outputs.
+	 */
+	void nextBlock();
+
+	// Data members.
+	/** Key of every block, from the seed. */
+	std::uint32_t mKey[2];
+	/** Index of the stream, the high half of every counter. */
+	std::uint64_t mStream;
+	/** Index of the next block to compute. */
+	std::uint64_t mCounter;
+	/** Outputs of the last block computed. */
+	Block         mBlock;
+	/** Index of the next buffered output, or BLOCK_SIZE once all are used. */
+	unsigned int  mIndex;
+};
+
+/**
+ * Makes engine() return a stream of the world seed on the calling thread while it exists, so that
+ * whatever draws from engine() meanwhile, on whichever thread, gets the same numbers on every run.
+ * Scoped streams nest; the one created last is used.
+ */
+class ScopedStream {
+public:
+	// Constructors.
+	/**
+	 * Switches the calling thread to a stream of the world seed.
+	 *
+	 * @param stream Index of the stream. Stream 0 is the world generator's.
+	 */
+	explicit ScopedStream(std::uint64_t stream);
+
+	/**
+	 * Copy constructor is disabled as each scoped stream restores the generator it replaced.
+	 */
+	ScopedStream(const ScopedStream&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as each scoped stream restores the generator it
+	 * replaced.
+	 */
+	void operator=(const ScopedStream&) = delete;
+
+	// Destructors.
+	/**
+	 * Switches the calling thread back to the generator used before.
+	 */
+	~ScopedStream();
+
+private:
+	// Data members.
+	/** Generator of the stream. */
+	Generator mGenerator;
+	/** Generator engine() returned before, or nullptr for the world generator. */
+	Generator *mPrevious;
+};
+
+/**
+ * Returns a seed drawn from the system's source of randomness.
+ *
+ * @return Random seed.
+ */
+std::uint32_t randomSeed();
+
+/**
+ * Seeds the world generator.
+ *
+ * @param seed World seed.
+ */
+void setSeed(std::uint32_t seed);
+
+/**
+ * Returns the world seed last passed to setSeed.
+ *
+ * @return World seed.
+ */
+std::uint32_t seed();
+
+/**
+ * Returns a generator on a stream of the world seed, for a task whose results should not depend on
+ * when or on which thread it runs.
+ *
+ * @param stream Index of the stream. Stream 0 is the world generator's.
+ * @return Generator at the start of the stream.
+ */
+Generator stream(std::uint64_t stream);
+
+/**
+ * Returns the generator of the calling thread: that of its innermost scoped stream, or the world
+ * generator, whose sequence depends only on the world seed and the order of calls, and which
+ * should only be used from the main thread.
+ *
+ * @return Generator.
+ */
+Generator& engine();
+
+// The helpers below draw from engine(). Unlike the <random> distributions, whose algorithms the
+// standard leaves to each library, they give the same values for the same seed on every toolchain.
+/**
+ * Returns a float uniformly distributed in [min, max).
+ *
+ * @param min Smallest value.
+ * @param max Bound of the values.
+ * @return Random float.
+ */
+float uniform(float min, float max);
+
+/**
+ * Returns a normally distributed float, drawn with the Box-Muller transform.
+ *
+ * @param mean Mean of the distribution.
+ * @param sdev Standard deviation of the distribution.
+ * @return Random float.
+ */
+float normal(float mean, float sdev);
+
+/**
+ * Returns an integer uniformly distributed in [first, last], without bias.
+ *
+ * @param first Smallest value.
+ * @param last Largest value, at most 2^32 - 1 above first.
+ * @return Random integer.
+ */
+std::size_t integer(std::size_t first, std::size_t last);
+}
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * @file depth_pyramid.cpp
+ *
+ * Implementation file for the DepthPyramid class.
+ */
+#include "depth_pyramid.hpp"
+
+#include "gl_calls.hpp"
+
+#include <algorithm>
+
+// Redeclare constant static data members.
+constexpr GLenum DepthPyramid::TEXTURE_UNIT;
+
+namespace {
+/** Path to compute shader source code. */
+constexpr char   COMPUTE_SHADER_PATH[] = "shaders/depth_pyramid_compute.shader";
+/** Width and height of the compute shader's work groups. */
+constexpr GLuint WORK_GROUP_SIZE       = 8;
+
+/**
+ * Returns the largest power of two not greater than a positive size.
+ */
+GLsizei floorPowerOfTwo(GLsizei size) {
+	GLsizei power = 1;
+	while (2 * power <= size) {
+		power *= 2;
+	}
+	return power;
+}
+}
+
+// Constructors.
+DepthPyramid::DepthPyramid() :
+		mProgram(COMPUTE_SHADER_PATH),
+		mFramebufferSize(0, 0),
+		mSize(0, 0),
+		mLevels(0),
+		mValid(false) {
+	mFramebuffer  = GlFramebuffer::generate();
+	mDepthTexture = GlTexture::generate();
+}
+
+// Accessor functions.
+bool DepthPyramid::supported() {
+	return GLEW_VERSION_4_3;
+}
+
+bool DepthPyramid::valid() const {
+	return mValid;
+}
+
+GLuint DepthPyramid::texture() const {
+	return mPyramidTexture.id();
+}
+
+GLint DepthPyramid::levels() const {
+	return mLevels;
+}
+
+glm::ivec2 DepthPyramid::size() const {
+	return mSize;
+}
+
+const glm::mat4& DepthPyramid::viewProjection() const {
+	return mViewProjection;
+}
+
+// OpenGL modifier functions.
+void DepthPyramid::update(GLsizei width, GLsizei height, const glm::mat4& viewProjection) {
+	PROFILE_SCOPE("DepthPyramid::update");
+
+	if (width != mFramebufferSize.x or height != mFramebufferSize.y) {
+		allocate(width, height);
+	}
+	if (mLevels == 0) {
+		return;
+	}
+
+	// Resolve the multisampled depth buffer of the default framebuffer.
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffer.id());
+	glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+	// Reduce the depth texture into level 0, then each level into the next. Each pass reads the
+	// previous level through a sampler and writes the next through an image.
+	mProgram.enable();
+	gl::uniform1i(mProgram.getUniformLocation("source"),
+	              static_cast<GLint>(TEXTURE_UNIT - GL_TEXTURE0));
+	GLint sourceLevelLocation     = mProgram.getUniformLocation("sourceLevel");
+	GLint sourceSizeLocation      = mProgram.getUniformLocation("sourceSize");
+	GLint destinationSizeLocation = mProgram.getUniformLocation("destinationSize");
+
+	gl::activeTexture(TEXTURE_UNIT);
+	gl::bindTexture(GL_TEXTURE_2D, mDepthTexture.id());
+	glm::ivec2 sourceSize  = mFramebufferSize;
+	GLint      sourceLevel = 0;
+	for (GLint level = 0; level < mLevels; ++level) {
+		glm::ivec2 destinationSize(std::max(mSize.x >> level, 1), std::max(mSize.y >> level, 1));
+		gl::uniform1i(sourceLevelLocation, sourceLevel);
+		gl::uniform2i(sourceSizeLocation, sourceSize.x, sourceSize.y);
+		gl::uniform2i(destinationSizeLocation, destinationSize.x, destinationSize.y);
+		glBindImageTexture(0, mPyramidTexture.id(), level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		gl::dispatchCompute((static_cast<GLuint>(destinationSize.x) + WORK_GROUP_SIZE - 1) /
+		                    WORK_GROUP_SIZE,
+		                    (static_cast<GLuint>(destinationSize.y) + WORK_GROUP_SIZE - 1) /
+		                    WORK_GROUP_SIZE, 1);
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		if (level == 0) {
+			gl::bindTexture(GL_TEXTURE_2D, mPyramidTexture.id());
+		}
+		sourceSize  = destinationSize;
+		sourceLevel = level;
+	}
+	gl::activeTexture(GL_TEXTURE0);
+
+	mViewProjection = viewProjection;
+	mValid          = true;
+}
+
+// Helper functions.
+void DepthPyramid::allocate(GLsizei width, GLsizei height) {
+	mFramebufferSize = glm::ivec2(width, height);
+	mValid           = false;
+	mLevels          = 0;
+	mPyramidTexture.reset();
+	if (width <= 0 or height <= 0) {
+		// Minimized; nothing to build until the window is restored.
+		return;
+	}
+
+	// The depth texture must match the format of the default framebuffer's depth buffer for the
+	// blit to resolve into it.
+	GLint depthBits   = 0;
+	GLint stencilBits = 0;
+	glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH,
+	                                      GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depthBits);
+	glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_STENCIL,
+	                                      GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE, &stencilBits);
+	GLenum internalFormat = GL_DEPTH_COMPONENT24;
+	GLenum format         = GL_DEPTH_COMPONENT;
+	GLenum type           = GL_UNSIGNED_INT;
+	GLenum attachment     = GL_DEPTH_ATTACHMENT;
+	if (stencilBits > 0) {
+		internalFormat = GL_DEPTH24_STENCIL8;
+		format         = GL_DEPTH_STENCIL;
+		type           = GL_UNSIGNED_INT_24_8;
+		attachment     = GL_DEPTH_STENCIL_ATTACHMENT;
+	}
+	else if (depthBits == 16) {
+		internalFormat = GL_DEPTH_COMPONENT16;
+	}
+	else if (depthBits == 32) {
+		internalFormat = GL_DEPTH_COMPONENT32F;
+		type           = GL_FLOAT;
+	}
+
+	gl::activeTexture(TEXTURE_UNIT);
+	gl::bindTexture(GL_TEXTURE_2D, mDepthTexture.id());
+	glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(internalFormat), width, height, 0, format,
+	             type, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer.id());
+	glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, mDepthTexture.id(), 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// Allocate every level of the pyramid down to a single texel.
+	mSize   = glm::ivec2(floorPowerOfTwo(width), floorPowerOfTwo(height));
+	mLevels = 1;
+	while ((std::max(mSize.x, mSize.y) >> mLevels) > 0) {
+		++mLevels;
+	}
+	mPyramidTexture = GlTexture::generate();
+	gl::bindTexture(GL_TEXTURE_2D, mPyramidTexture.id());
+	glTexStorage2D(GL_TEXTURE_2D, mLevels, GL_R32F, mSize.x, mSize.y);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	gl::activeTexture(GL_TEXTURE0);
+}
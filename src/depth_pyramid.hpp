@@ -0,0 +1,142 @@
+/**
+ * @file depth_pyramid.hpp
+ *
+ * Interface file for the DepthPyramid class.
+ */
+#ifndef SPACE_COWBOY_DEPTH_PYRAMID_HPP
+#define SPACE_COWBOY_DEPTH_PYRAMID_HPP
+
+#include "gl_object.hpp"
+#include "program.hpp"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+ * Hierarchical depth buffer of the last rendered frame, used for occlusion culling. After a frame is
+ * drawn its multisampled depth buffer is resolved by a blit into a depth texture, which a compute
+ * shader reduces into a mipmapped R32F texture, each texel holding the farthest depth of the area it
+ * covers. Level 0 is the largest power of two not greater than the framebuffer in each dimension,
+ * every texel covering its share of the framebuffer conservatively, so that an object whose nearest
+ * depth is behind the farthest depth of the few texels covering it is hidden. Requires OpenGL 4.3.
+ * A DepthPyramid should only be constructed after OpenGL has initialized.
+ */
+class DepthPyramid {
+public:
+	// Constants.
+	/** Texture unit the pyramid is bound to while it is read. */
+	static constexpr GLenum TEXTURE_UNIT = GL_TEXTURE1;
+
+	// Constructors.
+	/**
+	 * Creates an empty, invalid pyramid.
+	 */
+	DepthPyramid();
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of textures.
+	 */
+	DepthPyramid(const DepthPyramid&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of textures.
+	 */
+	void operator=(const DepthPyramid&) = delete;
+
+	/**
+	 * Move constructor, taking the objects of another pyramid and leaving it empty.
+	 */
+	DepthPyramid(DepthPyramid&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the objects of the pyramid and taking those of another.
+	 */
+	DepthPyramid& operator=(DepthPyramid&&) noexcept = default;
+
+	// Accessor functions.
+	/**
+	 * Returns whether OpenGL supports building and reading a depth pyramid.
+	 *
+	 * @return True iff compute shaders and image load/store are supported.
+	 */
+	static bool supported();
+
+	/**
+	 * Returns whether the pyramid holds the depth of a frame. The pyramid is invalid until it is
+	 * first updated, and after the framebuffer is resized.
+	 *
+	 * @return True iff the pyramid may be used for occlusion culling.
+	 */
+	bool valid() const;
+
+	/**
+	 * Returns the reference ID of the pyramid texture.
+	 *
+	 * @return Reference ID of the mipmapped pyramid texture.
+	 */
+	GLuint texture() const;
+
+	/**
+	 * Returns the number of mipmap levels of the pyramid.
+	 *
+	 * @return Number of levels, down to a single texel.
+	 */
+	GLint levels() const;
+
+	/**
+	 * Returns the size of level 0 of the pyramid.
+	 *
+	 * @return Width and height of level 0 in texels.
+	 */
+	glm::ivec2 size() const;
+
+	/**
+	 * Returns the view projection matrix of the frame the pyramid was built from.
+	 *
+	 * @return Product of the projection and view matrices of that frame.
+	 */
+	const glm::mat4& viewProjection() const;
+
+	// OpenGL modifier functions.
+	/**
+	 * Rebuilds the pyramid from the depth buffer of the default framebuffer. Should be called once
+	 * the frame's opaque objects are drawn.
+	 *
+	 * @param width Width of the framebuffer in pixels.
+	 * @param height Height of the framebuffer in pixels.
+	 * @param viewProjection View projection matrix the frame was drawn with.
+	 */
+	void update(GLsizei width, GLsizei height, const glm::mat4& viewProjection);
+
+private:
+	// Data members.
+	/** Compute shader program reducing one level into the next. */
+	Program       mProgram;
+	/** Framebuffer the depth buffer is resolved into. */
+	GlFramebuffer mFramebuffer;
+	/** Resolved depth texture. */
+	GlTexture     mDepthTexture;
+	/** Pyramid texture, or empty until allocated. */
+	GlTexture     mPyramidTexture;
+	/** Size of the framebuffer the textures were allocated for. */
+	glm::ivec2    mFramebufferSize;
+	/** Size of level 0 of the pyramid. */
+	glm::ivec2    mSize;
+	/** Number of levels of the pyramid. */
+	GLint         mLevels;
+	/** View projection matrix of the frame the pyramid was built from. */
+	glm::mat4     mViewProjection;
+	/** True iff the pyramid holds the depth of the last frame. */
+	bool          mValid;
+
+	// Helper functions.
+	/**
+	 * Reallocates the textures for a framebuffer size.
+	 *
+	 * @param width Width of the framebuffer in pixels.
+	 * @param height Height of the framebuffer in pixels.
+	 */
+	void allocate(GLsizei width, GLsizei height);
+};
+
+#endif
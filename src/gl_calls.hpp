@@ -0,0 +1,396 @@
+/**
+ * @file gl_calls.hpp
+ *
+ * Thin wrappers around the OpenGL calls made while rendering, in the "gl" namespace. Each wrapper
+ * forwards to the OpenGL function of the same name and updates the render statistics of the current
+ * frame. Draw code should call these instead of the raw OpenGL functions so that the statistics
+ * account for all submitted work.
+ *
+ * The binding wrappers also track the bound program, vertex array, buffers, textures and front face
+ * winding, and skip calls that would set what is already set. For the tracking to hold, every bind
+ * and every deletion of a program, vertex array, buffer or texture must go through these wrappers,
+ * and draw code should leave its state bound rather than unbinding it afterwards.
+ */
+#ifndef SPACE_COWBOY_GL_CALLS_HPP
+#define SPACE_COWBOY_GL_CALLS_HPP
+
+#include "render_stats.hpp"
+
+#include <GL/glew.h>
+
+namespace gl {
+/** Indirect draw command, laid out as glMultiDrawElementsIndirect reads it. */
+struct DrawElementsIndirectCommand {
+	/** Number of indices to draw. */
+	GLuint count;
+	/** Number of instances to draw. */
+	GLuint instanceCount;
+	/** Index of the first index to draw in the element buffer. */
+	GLuint firstIndex;
+	/** Value added to every index. */
+	GLint  baseVertex;
+	/** Index of the first instance, for per-instance vertex attributes. */
+	GLuint baseInstance;
+};
+
+/** Number of texture units whose bindings are tracked. */
+constexpr unsigned int N_TEXTURE_UNITS = 16;
+/** Tracked name of a binding whose state is not known. */
+constexpr GLuint       UNKNOWN         = ~0u;
+
+/** OpenGL state bound in the current context, as last set through the wrappers. */
+struct State {
+	/** Program in use. */
+	GLuint program            = 0;
+	/** Bound vertex array. */
+	GLuint vertexArray        = 0;
+	/** Buffer bound to GL_ARRAY_BUFFER. */
+	GLuint arrayBuffer        = 0;
+	/** Buffer bound to GL_ELEMENT_ARRAY_BUFFER, which is part of the bound vertex array. */
+	GLuint elementArrayBuffer = 0;
+	/** Buffer bound to GL_UNIFORM_BUFFER. */
+	GLuint uniformBuffer      = 0;
+	/** Buffer bound to GL_DRAW_INDIRECT_BUFFER. */
+	GLuint drawIndirectBuffer = 0;
+	/** Front face winding. */
+	GLenum frontFace          = GL_CCW;
+	/** Active texture unit, relative to GL_TEXTURE0. */
+	GLuint activeTexture      = 0;
+	/** Texture bound to GL_TEXTURE_2D of each unit. */
+	GLuint textures2D[N_TEXTURE_UNITS]      = {};
+	/** Texture bound to GL_TEXTURE_CUBE_MAP of each unit. */
+	GLuint texturesCubeMap[N_TEXTURE_UNITS] = {};
+};
+
+/**
+ * Returns the tracked state of the current context.
+ *
+ * @return Tracked state.
+ */
+inline State& state() {
+	static State sState;
+	return sState;
+}
+
+/**
+ * Returns the tracked binding of a buffer target, or null if the target is not tracked.
+ *
+ * @param target Buffer target.
+ * @return Tracked binding.
+ */
+inline GLuint *bufferBinding(GLenum target) {
+	switch (target) {
+		case GL_ARRAY_BUFFER:
+			return &state().arrayBuffer;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return &state().elementArrayBuffer;
+		case GL_UNIFORM_BUFFER:
+			return &state().uniformBuffer;
+		case GL_DRAW_INDIRECT_BUFFER:
+			return &state().drawIndirectBuffer;
+		default:
+			return nullptr;
+	}
+}
+
+/**
+ * Returns the tracked binding of a texture target of the active unit, or null if the target is not
+ * tracked.
+ *
+ * @param target Texture target.
+ * @return Tracked binding.
+ */
+inline GLuint *textureBinding(GLenum target) {
+	GLuint unit = state().activeTexture;
+	if (unit >= N_TEXTURE_UNITS) {
+		return nullptr;
+	}
+	switch (target) {
+		case GL_TEXTURE_2D:
+			return &state().textures2D[unit];
+		case GL_TEXTURE_CUBE_MAP:
+			return &state().texturesCubeMap[unit];
+		default:
+			return nullptr;
+	}
+}
+
+/**
+ * Records a call skipped because the state already matched and returns true, or returns false if
+ * the state does not match.
+ *
+ * @param pBinding Tracked binding, or null if untracked.
+ * @param name Name to bind.
+ * @return True if the call can be skipped.
+ */
+inline bool alreadyBound(const GLuint *pBinding, GLuint name) {
+	if (pBinding != nullptr and *pBinding == name) {
+		++renderStats::current().skippedCalls;
+		return true;
+	}
+	return false;
+}
+
+/** Wraps glUseProgram. */
+inline void useProgram(GLuint program) {
+	if (alreadyBound(&state().program, program)) {
+		return;
+	}
+	++renderStats::current().programSwitches;
+	glUseProgram(program);
+	state().program = program;
+}
+
+/** Wraps glBindVertexArray. */
+inline void bindVertexArray(GLuint vao) {
+	if (alreadyBound(&state().vertexArray, vao)) {
+		return;
+	}
+	++renderStats::current().vaoBinds;
+	glBindVertexArray(vao);
+	state().vertexArray = vao;
+
+	// The element array buffer binding belongs to the vertex array.
+	state().elementArrayBuffer = UNKNOWN;
+}
+
+/** Wraps glBindBuffer. */
+inline void bindBuffer(GLenum target, GLuint buffer) {
+	GLuint *pBinding = bufferBinding(target);
+	if (alreadyBound(pBinding, buffer)) {
+		return;
+	}
+	++renderStats::current().bufferBinds;
+	glBindBuffer(target, buffer);
+	if (pBinding != nullptr) {
+		*pBinding = buffer;
+	}
+}
+
+/** Wraps glBindBufferBase, which also binds the buffer to the generic binding of the target. */
+inline void bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+	++renderStats::current().bufferBinds;
+	glBindBufferBase(target, index, buffer);
+	GLuint *pBinding = bufferBinding(target);
+	if (pBinding != nullptr) {
+		*pBinding = buffer;
+	}
+}
+
+/** Wraps glActiveTexture. */
+inline void activeTexture(GLenum unit) {
+	GLuint index = static_cast<GLuint>(unit - GL_TEXTURE0);
+	if (alreadyBound(&state().activeTexture, index)) {
+		return;
+	}
+	glActiveTexture(unit);
+	state().activeTexture = index;
+}
+
+/** Wraps glBindTexture. */
+inline void bindTexture(GLenum target, GLuint texture) {
+	GLuint *pBinding = textureBinding(target);
+	if (alreadyBound(pBinding, texture)) {
+		return;
+	}
+	++renderStats::current().textureBinds;
+	glBindTexture(target, texture);
+	if (pBinding != nullptr) {
+		*pBinding = texture;
+	}
+}
+
+/** Wraps glFrontFace. */
+inline void frontFace(GLenum mode) {
+	if (alreadyBound(&state().frontFace, mode)) {
+		return;
+	}
+	glFrontFace(mode);
+	state().frontFace = mode;
+}
+
+/** Wraps glDeleteProgram. Deleting the program in use leaves no program tracked. */
+inline void deleteProgram(GLuint program) {
+	glDeleteProgram(program);
+	if (state().program == program) {
+		state().program = UNKNOWN;
+	}
+}
+
+/** Wraps glDeleteVertexArrays. Deleted vertex arrays are unbound. */
+inline void deleteVertexArrays(GLsizei n, const GLuint *vaos) {
+	glDeleteVertexArrays(n, vaos);
+	for (GLsizei i = 0; i < n; ++i) {
+		if (state().vertexArray == vaos[i]) {
+			state().vertexArray        = 0;
+			state().elementArrayBuffer = UNKNOWN;
+		}
+	}
+}
+
+/** Wraps glDeleteBuffers. Deleted buffers are unbound. */
+inline void deleteBuffers(GLsizei n, const GLuint *buffers) {
+	glDeleteBuffers(n, buffers);
+	for (GLsizei i = 0; i < n; ++i) {
+		for (GLuint *pBinding : { &state().arrayBuffer, &state().elementArrayBuffer,
+		                          &state().uniformBuffer, &state().drawIndirectBuffer }) {
+			if (*pBinding == buffers[i]) {
+				*pBinding = 0;
+			}
+		}
+	}
+}
+
+/** Wraps glDeleteTextures. Deleted textures are unbound from every unit. */
+inline void deleteTextures(GLsizei n, const GLuint *textures) {
+	glDeleteTextures(n, textures);
+	for (GLsizei i = 0; i < n; ++i) {
+		for (unsigned int unit = 0; unit < N_TEXTURE_UNITS; ++unit) {
+			if (state().textures2D[unit] == textures[i]) {
+				state().textures2D[unit] = 0;
+			}
+			if (state().texturesCubeMap[unit] == textures[i]) {
+				state().texturesCubeMap[unit] = 0;
+			}
+		}
+	}
+}
+
+/** Wraps glUniform1i. */
+inline void uniform1i(GLint location, GLint value) {
+	++renderStats::current().uniformUploads;
+	glUniform1i(location, value);
+}
+
+/** Wraps glUniform1ui. */
+inline void uniform1ui(GLint location, GLuint value) {
+	++renderStats::current().uniformUploads;
+	glUniform1ui(location, value);
+}
+
+/** Wraps glUniform1f. */
+inline void uniform1f(GLint location, GLfloat value) {
+	++renderStats::current().uniformUploads;
+	glUniform1f(location, value);
+}
+
+/** Wraps glUniform2i. */
+inline void uniform2i(GLint location, GLint x, GLint y) {
+	++renderStats::current().uniformUploads;
+	glUniform2i(location, x, y);
+}
+
+/** Wraps glUniform3f. */
+inline void uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z) {
+	++renderStats::current().uniformUploads;
+	glUniform3f(location, x, y, z);
+}
+
+/** Wraps glUniform4fv. */
+inline void uniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+	++renderStats::current().uniformUploads;
+	glUniform4fv(location, count, value);
+}
+
+/** Wraps glUniformMatrix4fv. */
+inline void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose,
+                             const GLfloat *value) {
+	++renderStats::current().uniformUploads;
+	glUniformMatrix4fv(location, count, transpose, value);
+}
+
+/** Wraps glBufferData. */
+inline void bufferData(GLenum target, GLsizeiptr size, const GLvoid *data, GLenum usage) {
+	renderStats::current().bytesUploaded += static_cast<std::uint64_t>(size);
+	glBufferData(target, size, data, usage);
+}
+
+/** Wraps glBufferSubData. */
+inline void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data) {
+	renderStats::current().bytesUploaded += static_cast<std::uint64_t>(size);
+	glBufferSubData(target, offset, size, data);
+}
+
+/**
+ * Returns the number of triangles drawn by a draw call.
+ *
+ * @param mode Primitive mode of the draw call.
+ * @param count Number of vertices drawn.
+ * @return Number of triangles.
+ */
+inline std::uint64_t triangleCount(GLenum mode, GLsizei count) {
+	switch (mode) {
+		case GL_TRIANGLES:
+			return static_cast<std::uint64_t>(count / 3);
+		case GL_TRIANGLE_STRIP:
+		case GL_TRIANGLE_FAN:
+			return count > 2 ? static_cast<std::uint64_t>(count - 2) : 0;
+		default:
+			return 0;
+	}
+}
+
+/** Wraps glDrawArrays. */
+inline void drawArrays(GLenum mode, GLint first, GLsizei count) {
+	renderStats::FrameStats& stats = renderStats::current();
+	++stats.drawCalls;
+	stats.triangles += triangleCount(mode, count);
+	glDrawArrays(mode, first, count);
+}
+
+/** Wraps glDrawArraysInstanced. */
+inline void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount) {
+	renderStats::FrameStats& stats = renderStats::current();
+	++stats.drawCalls;
+	stats.triangles += triangleCount(mode, count) * static_cast<std::uint64_t>(instanceCount);
+	glDrawArraysInstanced(mode, first, count, instanceCount);
+}
+
+/** Wraps glDrawElements. */
+inline void drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) {
+	renderStats::FrameStats& stats = renderStats::current();
+	++stats.drawCalls;
+	stats.triangles += triangleCount(mode, count);
+	glDrawElements(mode, count, type, indices);
+}
+
+/** Wraps glDrawElementsBaseVertex. */
+inline void drawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices,
+                                   GLint baseVertex) {
+	renderStats::FrameStats& stats = renderStats::current();
+	++stats.drawCalls;
+	stats.triangles += triangleCount(mode, count);
+	glDrawElementsBaseVertex(mode, count, type, indices, baseVertex);
+}
+
+/**
+ * Wraps glMultiDrawElementsIndirect. The commands are read from the bound draw indirect buffer, so
+ * the caller passes the total number of indices they draw for the statistics.
+ */
+inline void multiDrawElementsIndirect(GLenum mode, GLenum type, const GLvoid *indirect,
+                                      GLsizei drawCount, GLsizei stride, GLsizei nIndices) {
+	renderStats::FrameStats& stats = renderStats::current();
+	++stats.drawCalls;
+	stats.triangles += triangleCount(mode, nIndices);
+	glMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+}
+
+/**
+ * Wraps glMultiDrawElementsIndirectCountARB. Both the commands and their number are read from GPU
+ * buffers, so no triangles are counted.
+ */
+inline void multiDrawElementsIndirectCount(GLenum mode, GLenum type, const GLvoid *indirect,
+                                           GLintptr drawCount, GLsizei maxDrawCount,
+                                           GLsizei stride) {
+	++renderStats::current().drawCalls;
+	glMultiDrawElementsIndirectCountARB(mode, type, indirect, drawCount, maxDrawCount, stride);
+}
+
+/** Wraps glDispatchCompute. */
+inline void dispatchCompute(GLuint nGroupsX, GLuint nGroupsY, GLuint nGroupsZ) {
+	++renderStats::current().dispatches;
+	glDispatchCompute(nGroupsX, nGroupsY, nGroupsZ);
+}
+}
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file gl_object.hpp
+ *
+ * Declares the GlObject class template and its instances owning OpenGL buffers, vertex arrays,
+ * textures, framebuffers and programs.
+ */
+#ifndef SPACE_COWBOY_GL_OBJECT_HPP
+#define SPACE_COWBOY_GL_OBJECT_HPP
+
+#include "gl_calls.hpp"
+
+#include <utility>
+#include <GL/glew.h>
+
+/**
+ * Owner of an OpenGL object, deleting it when destroyed. Owners are move-only: moving one hands
+ * its object over and leaves it empty, so that classes holding their objects through owners get
+ * noexcept moves without writing them, and can be kept by value in growable containers. The Traits
+ * class provides static generate() and destroy(GLuint) functions, which delete through the gl
+ * wrappers so that the tracked bindings stay correct. An owner should only be used from the OpenGL
+ * thread.
+ */
+template <typename Traits>
+class GlObject {
+public:
+	// Constructors.
+	/**
+	 * Creates an empty owner.
+	 */
+	GlObject() noexcept :
+			mID(0) { }
+
+	/**
+	 * Takes ownership of an object.
+	 *
+	 * @param id Reference ID of the object, or 0 for none.
+	 */
+	explicit GlObject(GLuint id) noexcept :
+			mID(id) { }
+
+	/**
+	 * Takes the object of another owner, leaving it empty.
+	 */
+	GlObject(GlObject&& other) noexcept :
+			mID(other.mID) {
+		other.mID = 0;
+	}
+
+	/**
+	 * Deletes the object owned, then takes the object of another owner, leaving it empty.
+	 */
+	GlObject& operator=(GlObject&& other) noexcept {
+		if (this != &other) {
+			reset();
+			std::swap(mID, other.mID);
+		}
+		return *this;
+	}
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of objects.
+	 */
+	GlObject(const GlObject&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of
+	 * objects.
+	 */
+	void operator=(const GlObject&) = delete;
+
+	/**
+	 * Creates a new object.
+	 *
+	 * @return Owner of the object.
+	 */
+	static GlObject generate() {
+		return GlObject(Traits::generate());
+	}
+
+	// Destructors.
+	/**
+	 * Deletes the object owned, if any.
+	 */
+	~GlObject() {
+		reset();
+	}
+
+	// Accessor functions.
+	/**
+	 * Returns the reference ID of the object, or 0 if the owner is empty.
+	 */
+	GLuint id() const noexcept {
+		return mID;
+	}
+
+	/**
+	 * Returns true if the owner holds an object.
+	 */
+	explicit operator bool() const noexcept {
+		return mID != 0;
+	}
+
+	// Mutator functions.
+	/**
+	 * Deletes the object owned, if any, then takes ownership of another.
+	 *
+	 * @param id Reference ID of the object, or 0 to leave the owner empty.
+	 */
+	void reset(GLuint id = 0) noexcept {
+		if (mID != 0) {
+			Traits::destroy(mID);
+		}
+		mID = id;
+	}
+
+private:
+	// Data members.
+	/** Reference ID of the object, or 0 if the owner is empty. */
+	GLuint mID;
+};
+
+namespace gl {
+/** Generates and deletes buffer objects. */
+struct BufferTraits {
+	static GLuint generate() {
+		GLuint id;
+		glGenBuffers(1, &id);
+		return id;
+	}
+
+	static void destroy(GLuint id) {
+		deleteBuffers(1, &id);
+	}
+};
+
+/** Generates and deletes vertex array objects. */
+struct VertexArrayTraits {
+	static GLuint generate() {
+		GLuint id;
+		glGenVertexArrays(1, &id);
+		return id;
+	}
+
+	static void destroy(GLuint id) {
+		deleteVertexArrays(1, &id);
+	}
+};
+
+/** Generates and deletes texture objects. */
+struct TextureTraits {
+	static GLuint generate() {
+		GLuint id;
+		glGenTextures(1, &id);
+		return id;
+	}
+
+	static void destroy(GLuint id) {
+		deleteTextures(1, &id);
+	}
+};
+
+/** Generates and deletes framebuffer objects, which are not tracked. */
+struct FramebufferTraits {
+	static GLuint generate() {
+		GLuint id;
+		glGenFramebuffers(1, &id);
+		return id;
+	}
+
+	static void destroy(GLuint id) {
+		glDeleteFramebuffers(1, &id);
+	}
+};
+
+/** Creates and deletes program objects. */
+struct ProgramTraits {
+	static GLuint generate() {
+		return glCreateProgram();
+	}
+
+	static void destroy(GLuint id) {
+		deleteProgram(id);
+	}
+};
+}
+
+/** Owner of a buffer object. */
+typedef GlObject<gl::BufferTraits>      GlBuffer;
+/** Owner of a vertex array object. */
+typedef GlObject<gl::VertexArrayTraits> GlVertexArray;
+/** Owner of a texture object. */
+typedef GlObject<gl::TextureTraits>     GlTexture;
+/** Owner of a framebuffer object. */
+typedef GlObject<gl::FramebufferTraits> GlFramebuffer;
+/** Owner of a program object. */
+typedef GlObject<gl::ProgramTraits>     GlProgram;
+
+#endif
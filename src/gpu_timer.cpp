@@ -0,0 +1,181 @@
+/**
+ * @file gpu_timer.cpp
+ *
+ * Implementation file for the GpuTimer class.
+ */
+#include "gpu_timer.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// Redeclare constant static data members.
+constexpr unsigned int GpuTimer::LATENCY;
+constexpr unsigned int GpuTimer::AVERAGE_WINDOW;
+
+// Constructors.
+GpuTimer::GpuTimer() :
+		mCurrentFrame(0),
+		mSamples(),
+		mSampleSums(),
+		mSampleCounts() {
+	for (FrameQueries& frame : mFrames) {
+		glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+		frame.issued.fill(false);
+		frame.lastEnded = N_PASSES;
+	}
+
+#ifdef SPACE_COWBOY_PROFILE
+	// Relate the GPU clock to the profiler clock so GPU zones line up with CPU zones in the trace.
+	GLint64 gpuTime;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+	mClockOffset = static_cast<GLint64>(profiler::now()) - gpuTime;
+#endif
+}
+
+// Destructors.
+GpuTimer::~GpuTimer() {
+	for (FrameQueries& frame : mFrames) {
+		glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+	}
+}
+
+// Accessor functions.
+double GpuTimer::averageMilliseconds(Pass pass) const {
+	unsigned int nSamples = std::min(mSampleCounts[pass], AVERAGE_WINDOW);
+	return nSamples > 0 ? mSampleSums[pass] / nSamples : 0.0;
+}
+
+double GpuTimer::totalAverageMilliseconds() const {
+	double total = 0.0;
+	for (int pass = 0; pass < N_PASSES; ++pass) {
+		total += averageMilliseconds(static_cast<Pass>(pass));
+	}
+	return total;
+}
+
+std::string GpuTimer::summary() const {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(2) << "GPU " << totalAverageMilliseconds() << " ms";
+	for (int pass = 0; pass < N_PASSES; ++pass) {
+		out << " | " << passName(static_cast<Pass>(pass)) << ' '
+		    << averageMilliseconds(static_cast<Pass>(pass));
+	}
+	return out.str();
+}
+
+// OpenGL modifier functions.
+void GpuTimer::beginFrame() {
+	mCurrentFrame = (mCurrentFrame + 1) % LATENCY;
+	collect(mFrames[mCurrentFrame]);
+}
+
+void GpuTimer::begin(Pass pass) {
+	FrameQueries& frame = mFrames[mCurrentFrame];
+	glQueryCounter(frame.queries[2 * static_cast<std::size_t>(pass)], GL_TIMESTAMP);
+}
+
+void GpuTimer::end(Pass pass) {
+	FrameQueries& frame = mFrames[mCurrentFrame];
+	glQueryCounter(frame.queries[2 * static_cast<std::size_t>(pass) + 1], GL_TIMESTAMP);
+	frame.issued[pass] = true;
+	frame.lastEnded    = pass;
+}
+
+// Static functions.
+const char *GpuTimer::passName(Pass pass) {
+	switch (pass) {
+		case STARS:
+			return "Stars";
+		case SUN:
+			return "Sun";
+		case PLANETS:
+			return "Planets";
+		case MOONS:
+			return "Moons";
+		case ASTEROIDS:
+			return "Asteroids";
+		case IMPOSTORS:
+			return "Impostors";
+		case SPACESHIP:
+			return "Spaceship";
+		case SPACECOWBOY:
+			return "Spacecowboy";
+		case DEPTH_PYRAMID:
+			return "Depth pyramid";
+		default:
+			return "Unknown";
+	}
+}
+
+palette::rgb_t GpuTimer::passColour(Pass pass) {
+	switch (pass) {
+		case STARS:
+			return palette::PURPLE;
+		case SUN:
+			return palette::YELLOW;
+		case PLANETS:
+			return palette::GREEN;
+		case MOONS:
+			return palette::SILVER;
+		case ASTEROIDS:
+			return palette::GREY;
+		case IMPOSTORS:
+			return palette::TEAL;
+		case SPACESHIP:
+			return palette::AQUA;
+		case SPACECOWBOY:
+			return palette::RED;
+		case DEPTH_PYRAMID:
+			return palette::NAVY;
+		default:
+			return palette::WHITE;
+	}
+}
+
+// Helper functions.
+void GpuTimer::collect(FrameQueries& frame) {
+	// The end query of the last pass to end is the last query to complete. Passes are not ended in
+	// enum order since the render queue sorts them. If it is not ready, drop the frame instead of
+	// waiting for it.
+	if (frame.lastEnded == N_PASSES) {
+		return;
+	}
+
+	GLint available = 0;
+	glGetQueryObjectiv(frame.queries[2 * static_cast<std::size_t>(frame.lastEnded) + 1],
+	                   GL_QUERY_RESULT_AVAILABLE, &available);
+	frame.lastEnded = N_PASSES;
+
+	for (std::size_t pass = 0; pass < N_PASSES; ++pass) {
+		if (not frame.issued[pass]) {
+			continue;
+		}
+		frame.issued[pass] = false;
+		if (not available) {
+			continue;
+		}
+
+		GLuint64 start, end;
+		glGetQueryObjectui64v(frame.queries[2 * pass], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(frame.queries[2 * pass + 1], GL_QUERY_RESULT, &end);
+		addSample(static_cast<Pass>(pass), static_cast<double>(end - start) / 1.0e6);
+
+#ifdef SPACE_COWBOY_PROFILE
+		if (profiler::isCapturing()) {
+			profiler::recordGpu(passName(static_cast<Pass>(pass)),
+			                    static_cast<std::uint64_t>(static_cast<GLint64>(start) +
+			                                               mClockOffset),
+			                    static_cast<std::uint64_t>(static_cast<GLint64>(end) +
+			                                               mClockOffset));
+		}
+#endif
+	}
+}
+
+void GpuTimer::addSample(Pass pass, double milliseconds) {
+	double& slot = mSamples[pass][mSampleCounts[pass] % AVERAGE_WINDOW];
+	mSampleSums[pass] += milliseconds - slot;
+	slot = milliseconds;
+	++mSampleCounts[pass];
+}
@@ -0,0 +1,167 @@
+/**
+ * @file gpu_timer.hpp
+ *
+ * Interface file for the GpuTimer class.
+ */
+#ifndef SPACE_COWBOY_GPU_TIMER_HPP
+#define SPACE_COWBOY_GPU_TIMER_HPP
+
+#include "palette.hpp"
+#include "core/profiler.hpp"
+
+#include <array>
+#include <string>
+#include <GL/glew.h>
+
+/**
+ * Measures the GPU time spent in each render pass with GL_TIMESTAMP queries. Queries are issued
+ * into a ring of LATENCY frames and a frame's results are only read back once the ring wraps
+ * around to it, so reading results never stalls the pipeline. If a frame's results are still not
+ * available at that point they are dropped rather than waited for. Results are aggregated into
+ * rolling averages and, while a CPU profile is being captured, recorded on a "GPU" track of the
+ * trace. A GpuTimer should only be constructed after OpenGL has initialized.
+ */
+class GpuTimer {
+public:
+	/** Enumerated render passes. */
+	enum Pass {
+		STARS, SUN, PLANETS, MOONS, ASTEROIDS, IMPOSTORS, SPACESHIP, SPACECOWBOY, DEPTH_PYRAMID,
+		N_PASSES
+	};
+
+	/** Number of frames whose queries may be in flight at once. */
+	static constexpr unsigned int LATENCY = 3;
+	/** Number of frames the rolling averages are taken over. */
+	static constexpr unsigned int AVERAGE_WINDOW = 60;
+
+	// Constructors.
+	/**
+	 * Creates the timestamp queries for every frame in the ring.
+	 */
+	GpuTimer();
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of query objects.
+	 */
+	GpuTimer(const GpuTimer&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of query
+	 * objects.
+	 */
+	void operator=(const GpuTimer&) = delete;
+
+	// Destructors.
+	/**
+	 * Destroys the timestamp queries.
+	 */
+	~GpuTimer();
+
+	// Accessor functions.
+	/**
+	 * Returns the rolling average GPU time of a pass.
+	 *
+	 * @param pass Render pass.
+	 * @return Average GPU time of the pass in milliseconds.
+	 */
+	double averageMilliseconds(Pass pass) const;
+
+	/**
+	 * Returns the rolling average GPU time of all passes combined.
+	 *
+	 * @return Average GPU time of a frame's passes in milliseconds.
+	 */
+	double totalAverageMilliseconds() const;
+
+	/**
+	 * Returns a one-line summary of the rolling averages, suitable for a window title.
+	 *
+	 * @return Summary of the GPU time of each pass.
+	 */
+	std::string summary() const;
+
+	// OpenGL modifier functions.
+	/**
+	 * Starts a new frame. Reads back the results of the frame that last used this frame's slot in
+	 * the ring, if they are available.
+	 */
+	void beginFrame();
+
+	/**
+	 * Marks the start of a pass.
+	 *
+	 * @param pass Render pass.
+	 */
+	void begin(Pass pass);
+
+	/**
+	 * Marks the end of a pass.
+	 *
+	 * @param pass Render pass.
+	 */
+	void end(Pass pass);
+
+	// Static functions.
+	/**
+	 * Returns the name of a pass.
+	 *
+	 * @param pass Render pass.
+	 * @return Name of pass.
+	 */
+	static const char *passName(Pass pass);
+
+	/**
+	 * Returns the colour a pass is shown with in the overlay.
+	 *
+	 * @param pass Render pass.
+	 * @return Colour of pass.
+	 */
+	static palette::rgb_t passColour(Pass pass);
+
+private:
+	/** Queries of one frame in the ring. */
+	struct FrameQueries {
+		/** Start and end timestamp queries of each pass. */
+		std::array<GLuint, 2 * N_PASSES> queries;
+		/** True iff the pass was timed during the frame. */
+		std::array<bool, N_PASSES>       issued;
+		/** Pass whose end was marked last during the frame, or N_PASSES if none was. */
+		Pass                             lastEnded;
+	};
+
+	// Data members.
+	/** Ring of per-frame queries. */
+	std::array<FrameQueries, LATENCY> mFrames;
+	/** Index of the current frame in the ring. */
+	unsigned int                      mCurrentFrame;
+
+	/** Most recent samples of each pass in milliseconds. */
+	std::array<std::array<double, AVERAGE_WINDOW>, N_PASSES> mSamples;
+	/** Sum of the samples of each pass. */
+	std::array<double, N_PASSES>                             mSampleSums;
+	/** Number of samples recorded for each pass. */
+	std::array<unsigned int, N_PASSES>                       mSampleCounts;
+
+#ifdef SPACE_COWBOY_PROFILE
+	/** Difference between the profiler clock and the GPU clock in nanoseconds. */
+	GLint64 mClockOffset;
+#endif
+
+	// Helper functions.
+	/**
+	 * Reads back the results of a frame if they are available.
+	 *
+	 * @param frame Queries of the frame.
+	 */
+	void collect(FrameQueries& frame);
+
+	/**
+	 * Adds a sample to the rolling average of a pass.
+	 *
+	 * @param pass Render pass.
+	 * @param milliseconds GPU time of the pass.
+	 */
+	void addSample(Pass pass, double milliseconds);
+};
+
+#endif
@@ -1,5 +1,6 @@
 
 #include "hub.hpp"
+#include "gl_calls.hpp"
 #include <glm/glm.hpp>
 
 namespace {
@@ -42,38 +43,44 @@ Hub::Hub() :
 	};
 
 //window VAO
-glGenVertexArrays(1, &windowVAO);
-glBindVertexArray(windowVAO);
+windowVAO = GlVertexArray::generate();
+gl::bindVertexArray(windowVAO.id());
 
 //vbo for window vertices
-glGenBuffers(1, &windowVerticesVBO);
-glBindBuffer(GL_ARRAY_BUFFER, windowVerticesVBO);
-glBufferData(GL_ARRAY_BUFFER, sizeof(windowVertices), &windowVertices.front(), GL_STATIC_DRAW);
+windowVerticesVBO = GlBuffer::generate();
+gl::bindBuffer(GL_ARRAY_BUFFER, windowVerticesVBO.id());
+gl::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(GLfloat) * windowVertices.size()),
+               windowVertices.data(), GL_STATIC_DRAW);
 glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), 0);
 glEnableVertexAttribArray(0);
 
 //vbo for window UVs
-glGenBuffers(1, &windowUVsVBO);
-glBindBuffer(GL_ARRAY_BUFFER, windowUVsVBO);
-glBufferData(GL_ARRAY_BUFFER, sizeof(windowUVs), &windowUVs.front(), GL_STATIC_DRAW);
+windowUVsVBO = GlBuffer::generate();
+gl::bindBuffer(GL_ARRAY_BUFFER, windowUVsVBO.id());
+gl::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(GLfloat) * windowUVs.size()),
+               windowUVs.data(), GL_STATIC_DRAW);
 glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), 0);
 glEnableVertexAttribArray(1);
 
 //indices (EBO) for window
-glGenBuffers(1, &windowEBO);
-glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, windowEBO);
-glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(windowIndices), &windowIndices.front(), GL_STATIC_DRAW);
+windowEBO = GlBuffer::generate();
+gl::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, windowEBO.id());
+gl::bufferData(GL_ELEMENT_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(sizeof(GLuint) * windowIndices.size()), windowIndices.data(),
+               GL_STATIC_DRAW);
 
-glBindBuffer(GL_ARRAY_BUFFER, 0);
-glBindVertexArray(0);
+gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+gl::bindVertexArray(0);
 
 	//Texture HUB
 
 	//Window texture
-glActiveTexture(GL_TEXTURE4); //select texture unit 4
+PROFILE_SCOPE("Hub texture load");
+gl::activeTexture(GL_TEXTURE4); //select texture unit 4
 
-glGenTextures(1, &hub_Texture);
-glBindTexture(GL_TEXTURE_2D, hub_Texture); //bind this texture to the currently bound texture unit
+hub_Texture = GlTexture::generate();
+//bind this texture to the currently bound texture unit
+gl::bindTexture(GL_TEXTURE_2D, hub_Texture.id());
 
 // Load image, create texture and generate mipmaps
 int window_texture_width, window_texture_height;
@@ -93,34 +100,22 @@ SOIL_free_image_data(window_texture_image); //free resources
 
 //--------------------------------------------------  DRAW METHOD ----------------------------------------------------------------
 
-void Hub::draw(const Camera& camera) const {
+void Hub::draw() const {
 	// Enable program.
 	mProgram.enable();
 	//glEnable(GL_BLEND);
 	//glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	//glUniform1i(mProgram.getUniformLocation("hubTexture"), 4); //tell our uniform texture sampler to sample texture unit 4
 
-	glm::mat4 model = glm::mat4(1.0f);
-	glm::mat4 view = camera.view();
-	glm::mat4 projection = camera.projection();
+	// The hub is drawn in world space; the camera matrices come from the shared camera uniform
+	// buffer.
 
-	glm::mat4 MVP = projection * view * model;
-	glUniformMatrix4fv(mProgram.getUniformLocation("MVP"), 1, GL_FALSE, glm::value_ptr(MVP));
+	// Bind vertex array object, which holds the element buffer object, to current context.
+	gl::bindVertexArray(windowVAO.id());
 
-	// Bind vertex array object and element buffer object to current context.
-	glBindVertexArray(windowVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, windowUVsVBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, windowEBO);
-
-	glBindTexture(GL_TEXTURE_2D, hub_Texture);
+	gl::bindTexture(GL_TEXTURE_2D, hub_Texture.id());
 
 	// Draw.
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT,
+	gl::drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT,
 		0);
-
-	// Disable program and unbind vertex array object and element buffer object.
-	mProgram.disable();
-	glBindVertexArray(0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -6,8 +6,10 @@
 #ifndef SPACE_COWBOY_HUB_HPP
 #define SPACE_COWBOY_HUB_HPP
 
-#include "camera.hpp"
+#include "core/camera.hpp"
+#include "gl_object.hpp"
 #include "palette.hpp"
+#include "core/profiler.hpp"
 #include "program.hpp"
 
 #include <vector>
@@ -27,25 +29,35 @@ public:
 	*/
 	Hub();
 
-	void draw(const Camera& camera) const;
+	/**
+	 * Move constructor, taking the objects of another hub and leaving it empty.
+	 */
+	Hub(Hub&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the objects of the hub and taking those of another.
+	 */
+	Hub& operator=(Hub&&) noexcept = default;
+
+	void draw() const;
 
 
 private:
 	// Data members.
 	/** Shader program. */
-	Program mProgram;
-	/** Reference ID of vertex array buffer. */
-	GLuint  windowVAO;
-	/** Reference ID of vertex buffer object. */
-	GLuint  windowVerticesVBO;
-	/** Reference ID of element buffer object. */
-	GLuint  windowEBO;
-
-	/** Reference ID of vertex uv buffer. */
-	GLuint  windowUVsVBO;
-
-	/*Reference ID of hud texture*/
-	GLuint hub_Texture;
+	Program       mProgram;
+	/** Vertex array object. */
+	GlVertexArray windowVAO;
+	/** Vertex buffer object. */
+	GlBuffer      windowVerticesVBO;
+	/** Element buffer object. */
+	GlBuffer      windowEBO;
+
+	/** Vertex uv buffer. */
+	GlBuffer      windowUVsVBO;
+
+	/*hud texture*/
+	GlTexture     hub_Texture;
 	
 	std::vector<GLfloat> windowVertices;
 
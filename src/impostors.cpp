@@ -0,0 +1,151 @@
+/**
+ * @file impostors.cpp
+ *
+ * Implementation file for the Impostors class.
+ */
+#include "impostors.hpp"
+
+#include "gl_calls.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+// Shader program file paths.
+/** Path to vertex shader source code of the quads. */
+constexpr char QUAD_VERTEX_SHADER_PATH[]    = "shaders/impostor_vertex.shader";
+/** Path to fragment shader source code of the quads. */
+constexpr char QUAD_FRAGMENT_SHADER_PATH[]  = "shaders/impostor_fragment.shader";
+/** Path to vertex shader source code of the points. */
+constexpr char POINT_VERTEX_SHADER_PATH[]   = "shaders/impostor_point_vertex.shader";
+/** Path to fragment shader source code of the points. */
+constexpr char POINT_FRAGMENT_SHADER_PATH[] = "shaders/impostor_point_fragment.shader";
+
+// Vertex attribute locations.
+/** Location of the corner of the quad. */
+constexpr GLuint CORNER_ATTRIBUTE = 0;
+/** Location of the per-instance centre and radius. */
+constexpr GLuint SPHERE_ATTRIBUTE = 1;
+/** Location of the per-instance colour. */
+constexpr GLuint COLOUR_ATTRIBUTE = 2;
+
+/** Corners of a quad as a triangle strip, counter-clockwise when facing the camera. */
+constexpr GLfloat QUAD_CORNERS[] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+
+/** Projected radius in pixels below which a body is drawn as a point. */
+constexpr float MAX_POINT_PIXEL_RADIUS = 0.5f;
+}
+
+// Constructors.
+Impostors::Impostors(std::size_t capacity, float maxPixelRadius) :
+		mQuadProgram(QUAD_VERTEX_SHADER_PATH, QUAD_FRAGMENT_SHADER_PATH),
+		mPointProgram(POINT_VERTEX_SHADER_PATH, POINT_FRAGMENT_SHADER_PATH),
+		mCapacity(capacity),
+		mMaxPixelRadius(maxPixelRadius),
+		mInstances(new StreamBuffer(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(
+				std::max<std::size_t>(capacity, 1) * sizeof(Instance)))),
+		mCamera(nullptr),
+		mPixelScale(0.0f),
+		mNearestDepth(0.0f) {
+	mQuadVAO   = GlVertexArray::generate();
+	mPointVAO  = GlVertexArray::generate();
+	mCornerVBO = GlBuffer::generate();
+
+	// Quads are drawn instanced: the corners advance per vertex and the bodies per instance.
+	gl::bindVertexArray(mQuadVAO.id());
+	gl::bindBuffer(GL_ARRAY_BUFFER, mCornerVBO.id());
+	gl::bufferData(GL_ARRAY_BUFFER, sizeof(QUAD_CORNERS), QUAD_CORNERS, GL_STATIC_DRAW);
+	glVertexAttribPointer(CORNER_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
+	                      reinterpret_cast<GLvoid *>(0));
+	glEnableVertexAttribArray(CORNER_ATTRIBUTE);
+	glEnableVertexAttribArray(SPHERE_ATTRIBUTE);
+	glEnableVertexAttribArray(COLOUR_ATTRIBUTE);
+	glVertexAttribDivisor(SPHERE_ATTRIBUTE, 1);
+	glVertexAttribDivisor(COLOUR_ATTRIBUTE, 1);
+
+	// Points are drawn one vertex per body.
+	gl::bindVertexArray(mPointVAO.id());
+	glEnableVertexAttribArray(SPHERE_ATTRIBUTE);
+	glEnableVertexAttribArray(COLOUR_ATTRIBUTE);
+}
+
+// Mutator functions.
+void Impostors::clear(const CameraBlock& camera, float viewportHeight) {
+	mCamera       = &camera;
+	mPixelScale   = camera.projection[1][1] * 0.5f * viewportHeight;
+	mNearestDepth = std::numeric_limits<float>::max();
+	mQuads.clear();
+	mPoints.clear();
+}
+
+bool Impostors::add(const glm::vec3& centre, float radius, const glm::vec3& colour) {
+	if (mMaxPixelRadius <= 0.0f or mQuads.size() + mPoints.size() >= mCapacity) {
+		return false;
+	}
+
+	float depth = mCamera->viewDepth(centre);
+	if (depth - radius <= 0.0f) {
+		return false;
+	}
+	float pixelRadius = mPixelScale * radius / depth;
+	if (pixelRadius >= mMaxPixelRadius) {
+		return false;
+	}
+
+	Instance instance = { glm::vec4(centre, radius), glm::vec4(colour, 1.0f) };
+	if (pixelRadius < MAX_POINT_PIXEL_RADIUS) {
+		// Dim the point by the fraction of its pixel the body covers, as it would be blended with
+		// the black sky.
+		instance.colour.w = std::min(static_cast<float>(M_PI) * pixelRadius * pixelRadius, 1.0f);
+		mPoints.push_back(instance);
+	}
+	else {
+		mQuads.push_back(instance);
+	}
+	mNearestDepth = std::min(mNearestDepth, depth - radius);
+	return true;
+}
+
+// OpenGL modifier functions.
+void Impostors::submit(RenderQueue& queue) const {
+	if (mQuads.empty() and mPoints.empty()) {
+		return;
+	}
+	queue.submit(queue.key(RenderQueue::OPAQUE, mQuadProgram.id(), 0, GL_CCW, mNearestDepth), *this,
+	             0, GpuTimer::IMPOSTORS);
+}
+
+void Impostors::drawItem(std::uint32_t) const {
+	// Stream the quads followed by the points.
+	Instance *instances = static_cast<Instance *>(mInstances->beginRegion());
+	std::copy(mQuads.begin(), mQuads.end(), instances);
+	std::copy(mPoints.begin(), mPoints.end(), instances + mQuads.size());
+	mInstances->endRegion(
+			static_cast<GLsizeiptr>((mQuads.size() + mPoints.size()) * sizeof(Instance)));
+
+	if (not mQuads.empty()) {
+		mQuadProgram.enable();
+		gl::bindVertexArray(mQuadVAO.id());
+		setInstanceAttributes(mInstances->regionOffset());
+		gl::drawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(mQuads.size()));
+	}
+	if (not mPoints.empty()) {
+		mPointProgram.enable();
+		gl::bindVertexArray(mPointVAO.id());
+		setInstanceAttributes(mInstances->regionOffset() +
+		                      static_cast<GLintptr>(mQuads.size() * sizeof(Instance)));
+		gl::drawArrays(GL_POINTS, 0, static_cast<GLsizei>(mPoints.size()));
+	}
+	mInstances->fenceRegion();
+}
+
+// Helper functions.
+void Impostors::setInstanceAttributes(GLintptr offset) const {
+	gl::bindBuffer(GL_ARRAY_BUFFER, mInstances->id());
+	glVertexAttribPointer(SPHERE_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+	                      reinterpret_cast<GLvoid *>(offset));
+	glVertexAttribPointer(COLOUR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+	                      reinterpret_cast<GLvoid *>(offset +
+	                                                 static_cast<GLintptr>(sizeof(glm::vec4))));
+}
@@ -0,0 +1,146 @@
+/**
+ * @file impostors.hpp
+ *
+ * Interface file for the Impostors class.
+ */
+#ifndef SPACE_COWBOY_IMPOSTORS_HPP
+#define SPACE_COWBOY_IMPOSTORS_HPP
+
+#include "core/camera.hpp"
+#include "gl_object.hpp"
+#include "program.hpp"
+#include "render_queue.hpp"
+#include "stream_buffer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+ * Draws distant bodies without their meshes. A body whose projection is smaller than a threshold is
+ * drawn as a camera-facing quad bounding its silhouette, on which the fragment shader intersects the
+ * view ray with the sphere and lights the hit point like the planet shader, writing the sphere's
+ * depth. A body smaller than a pixel is drawn as a single point, dimmed by the fraction of the pixel
+ * it covers. The body is coloured with the mean colour of its mesh. Every impostor of the frame is
+ * gathered into one stream buffer and drawn with one instanced call for the quads and one for the
+ * points. An Impostors object should only be constructed after OpenGL has initialized.
+ */
+class Impostors : public Drawable {
+public:
+	// Constructors.
+	/**
+	 * Creates the programs and buffers for a number of impostors.
+	 *
+	 * @param capacity Largest number of impostors drawn in a frame.
+	 * @param maxPixelRadius Projected radius in pixels below which bodies are drawn as impostors.
+	 *                       Zero disables impostors.
+	 */
+	Impostors(std::size_t capacity, float maxPixelRadius);
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	Impostors(const Impostors&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const Impostors&) = delete;
+
+	/**
+	 * Move constructor, taking the objects of another renderer and leaving it empty.
+	 */
+	Impostors(Impostors&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the objects of the renderer and taking those of another.
+	 */
+	Impostors& operator=(Impostors&&) noexcept = default;
+
+	// Mutator functions.
+	/**
+	 * Starts gathering the impostors of a frame.
+	 *
+	 * @param camera Camera block of the frame.
+	 * @param viewportHeight Height of the viewport in pixels.
+	 */
+	void clear(const CameraBlock& camera, float viewportHeight);
+
+	/**
+	 * Adds a body as an impostor if its projection is small enough.
+	 *
+	 * @param centre Centre of the body in world space.
+	 * @param radius Radius of the body.
+	 * @param colour Mean colour of the body.
+	 * @return True if the body will be drawn as an impostor, false if it should be drawn as a mesh.
+	 */
+	bool add(const glm::vec3& centre, float radius, const glm::vec3& colour);
+
+	// OpenGL modifier functions.
+	/**
+	 * Submits the gathered impostors to a render queue as a single draw item.
+	 *
+	 * @param queue Render queue of the frame.
+	 */
+	void submit(RenderQueue& queue) const;
+
+	/**
+	 * Renders the gathered impostors.
+	 *
+	 * @param index Unused; the impostors are submitted as a single item.
+	 */
+	void drawItem(std::uint32_t index) const override;
+
+private:
+	/** Impostor as the vertex shaders read it. */
+	struct Instance {
+		/** Centre and radius of the body. */
+		glm::vec4 sphere;
+		/** Colour of the body, with the fraction of a pixel it covers for points. */
+		glm::vec4 colour;
+	};
+
+	// Data members.
+	/** Shader program of the quads. */
+	Program       mQuadProgram;
+	/** Shader program of the points. */
+	Program       mPointProgram;
+	/** Vertex array object of the quads. */
+	GlVertexArray mQuadVAO;
+	/** Vertex array object of the points. */
+	GlVertexArray mPointVAO;
+	/** Vertex buffer holding the corners of a quad. */
+	GlBuffer      mCornerVBO;
+	/** Largest number of impostors drawn in a frame. */
+	std::size_t   mCapacity;
+	/** Projected radius in pixels below which bodies are drawn as impostors. */
+	float         mMaxPixelRadius;
+
+	/** Per-frame instances, the quads followed by the points. */
+	std::unique_ptr<StreamBuffer> mInstances;
+
+	/** Camera block of the current frame. */
+	const CameraBlock     *mCamera;
+	/** Scale from a body's radius over its depth to its projected radius in pixels. */
+	float                 mPixelScale;
+	/** Quads of the current frame. */
+	std::vector<Instance> mQuads;
+	/** Points of the current frame. */
+	std::vector<Instance> mPoints;
+	/** Depth of the nearest impostor of the current frame. */
+	float                 mNearestDepth;
+
+	// Helper functions.
+	/**
+	 * Points the instance attributes of the bound vertex array object at an offset into the
+	 * instance stream buffer.
+	 *
+	 * @param offset Offset of the first instance in bytes.
+	 */
+	void setInstanceAttributes(GLintptr offset) const;
+};
+
+#endif
@@ -7,12 +7,123 @@
 
 /**
  * Main entry point of the program.
+ *
+ * Supported command line options:
+ *   --profile-frames N   Capture a CPU profile of loading and the first N frames (requires a
+ *                        build with SPACE_COWBOY_PROFILING enabled).
+ *   --profile-output F   Write the captured profile to F instead of the default trace path.
+ *   --benchmark-frames N Record the frame time and render statistics of the first N frames,
+ *                        write them to a JSON file and exit.
+ *   --benchmark-output F Write the benchmark to F instead of the default benchmark path.
+ *   --seed N             Generate the world from seed N instead of a random seed.
+ *   --record F           Record the world seed, tick durations and input events to F.
+ *   --replay F           Replay the session recorded in F and exit when it ends.
+ *   --gpu-culling        Cull planets, moons and asteroids on the GPU against the viewing frustum
+ *                        and the previous frame's depth (requires OpenGL 4.3; falls back to CPU
+ *                        frustum culling otherwise).
+ *   --stress N           Add a belt of N asteroids to the world to stress culling and drawing.
+ *   --no-occlusion       Draw bodies hidden behind the sun, planets and moons instead of skipping
+ *                        them with the software occlusion buffer.
+ *   --impostor-size N    Draw planets, moons and asteroids whose projected radius is below N pixels
+ *                        as impostors instead of meshes (default 8; 0 draws every body's mesh).
+ *   --compact-vertices   Upload meshes with quantized positions, octahedral normals, RGBA8 colours
+ *                        or half float texture coordinates, and 16-bit indices where they fit.
+ *   --pack F             Load the cooked models and textures from the asset pack F instead of the
+ *                        default pack path, which is only loaded if it exists. Assets missing from
+ *                        the pack are loaded from their sources.
+ *   --no-pack            Load every model and texture from its source.
+ *   --list-assets        List the loaded meshes, textures and shader programs, with their
+ *                        references and GPU data sizes, once loading is done.
  */
-int main() {
+int main(int argc, char *argv[]) {
+
+	// Parse command line options.
+	unsigned int  profileFrames   = 0;
+	std::string   profileOutput   = profiler::DEFAULT_TRACE_PATH;
+	unsigned int  benchmarkFrames = 0;
+	std::string   benchmarkOutput = Benchmark::DEFAULT_OUTPUT_PATH;
+	std::uint32_t seed            = worldRandom::randomSeed();
+	std::string   recordPath;
+	std::string   replayPath;
+	bool          gpuCulling      = false;
+	std::size_t   nAsteroids      = 0;
+	bool          occlusion       = true;
+	float         impostorSize    = DEFAULT_IMPOSTOR_SIZE;
+	bool          compactVertices = false;
+	std::string   packPath        = AssetPack::DEFAULT_PATH;
+	bool          usePack         = true;
+	bool          listAssets      = false;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--profile-frames") == 0 and i + 1 < argc) {
+			profileFrames = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--profile-output") == 0 and i + 1 < argc) {
+			profileOutput = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--benchmark-frames") == 0 and i + 1 < argc) {
+			benchmarkFrames = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--benchmark-output") == 0 and i + 1 < argc) {
+			benchmarkOutput = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 and i + 1 < argc) {
+			seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--record") == 0 and i + 1 < argc) {
+			recordPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--replay") == 0 and i + 1 < argc) {
+			replayPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--gpu-culling") == 0) {
+			gpuCulling = true;
+		}
+		else if (std::strcmp(argv[i], "--stress") == 0 and i + 1 < argc) {
+			nAsteroids = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--no-occlusion") == 0) {
+			occlusion = false;
+		}
+		else if (std::strcmp(argv[i], "--impostor-size") == 0 and i + 1 < argc) {
+			impostorSize = std::strtof(argv[++i], nullptr);
+		}
+		else if (std::strcmp(argv[i], "--compact-vertices") == 0) {
+			compactVertices = true;
+		}
+		else if (std::strcmp(argv[i], "--pack") == 0 and i + 1 < argc) {
+			packPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--no-pack") == 0) {
+			usePack = false;
+		}
+		else if (std::strcmp(argv[i], "--list-assets") == 0) {
+			listAssets = true;
+		}
+		else {
+			std::cerr << "Warning: Ignoring unknown option " << argv[i] << "." << std::endl;
+		}
+	}
 
-	srand(time(NULL));//seed random num generator
+	PROFILE_THREAD_NAME("Main");
+	if (profileFrames > 0) {
+		PROFILE_CAPTURE(profileFrames, profileOutput);
+	}
 
 	try {
+		// Record or replay the session. A replay brings its own world seed.
+		InputRecorder inputRecorder;
+		if (not replayPath.empty()) {
+			inputRecorder.startReplay(replayPath);
+			seed = inputRecorder.seed();
+		}
+		else if (not recordPath.empty()) {
+			inputRecorder.startRecording(recordPath, seed);
+		}
+
+		// Seed world generation so that the same seed always generates the same world.
+		worldRandom::setSeed(seed);
+		std::cout << "World seed: " << seed << std::endl;
+
 		// Create an OpenGL context by initializing GLFW. Note that this step exploits RAII: the
 		// constructor for the GLFWGuard class calls the various GLFW initialization functions,
 		// while GLFWGuard's destructor calls glfwTerminate to terminate GLFW. This ensures that
@@ -41,162 +152,301 @@ int main() {
 		Camera camera(FIELD_OF_VIEW, window.aspectRatio(), NEAR_CLIPPING_PLANE, FAR_CLIPPING_PLANE,
 		              INITIAL_CAMERA_POSITION, INITIAL_CAMERA_FRONT, INITIAL_UP);
 
-		// Pass camera object to window.
+		// Pass camera object and input recorder to window.
 		window.setCamera(&camera);
+		window.setInputRecorder(&inputRecorder);
 
-		Stars stars;
-
-		// Create Sun. Scale.
-		Sun sun;
-		sun.scale(SUN_SIZE);
+		// Generate the world: the sun, planets and moons, and the asteroids of a stress scene. The
+		// simulation state lives in the core library; the renderers below only hold GL objects.
+		World       world = generateWorld();
+		if (nAsteroids > 0) {
+			generateAsteroids(world, nAsteroids);
+		}
+		ShipState   ship;
+		CowboyState cowboy;
+
+		// Open the asset pack to load the cooked models and textures from. The default pack only
+		// exists once sc_cook has been run, so the sources are loaded quietly without it.
+		std::unique_ptr<AssetPack> assetPack;
+		if (usePack and (packPath != AssetPack::DEFAULT_PATH or std::ifstream(packPath))) {
+			try {
+				assetPack.reset(new AssetPack(packPath));
+			}
+			catch (const std::runtime_error& error) {
+				std::cerr << "Warning: " << error.what() << " Loading the sources instead."
+				          << std::endl;
+			}
+		}
 
-		// Create planets using procedural generation.
-		std::vector<Planet> rockyPlanets = generatePlanets(Planet::ROCKY, 0);
-		std::vector<Planet> gaseousPlanets = generatePlanets(Planet::GASEOUS, glm::length(rockyPlanets.back().position()));
+		// Stream the textures and the body meshes through the upload service, which carries out the
+		// uploads requested while loading before the first frame, and any later ones between frames.
+		UploadService uploads;
+
+		// Decode every texture on worker threads while the objects below are created. Each object
+		// allocates its textures on this thread, waiting only for those not decoded yet.
+		TextureLoader textureLoader(assetPack.get(), &uploads);
+		Stars::requestTextures(textureLoader);
+		Sun::requestTextures(textureLoader);
+		Spaceship::requestTextures(textureLoader);
+		Spacecowboy::requestTextures(textureLoader);
+
+		// Share the meshes, textures and shader programs loaded from files between the objects.
+		AssetRegistry assets;
+		Stars         stars(assets, textureLoader);
+		Sun           sun(assets, textureLoader);
+
+		// Upload the planet, moon and asteroid meshes, then release the CPU copies. The renderers
+		// keep their own copies until uploaded.
+		Planet planetRenderer(assets, compactVertices, &uploads);
+		planetRenderer.setMeshes(world.planetMeshes);
+		Planet moonRenderer(assets, compactVertices, &uploads);
+		moonRenderer.setMeshes(world.moonMeshes);
+		Planet asteroidRenderer(assets, compactVertices, &uploads);
+		asteroidRenderer.setMeshes({ world.asteroidMesh },
+		                           std::vector<std::uint32_t>(world.asteroids.size(), 0));
+		std::vector<BodyMesh>().swap(world.planetMeshes);
+		std::vector<BodyMesh>().swap(world.moonMeshes);
+		world.asteroidMesh = BodyMesh();
+
+		// Cull the bodies on the GPU if requested and supported, against a depth pyramid built from
+		// each frame for the next.
+		std::unique_ptr<DepthPyramid> depthPyramid;
+		if (gpuCulling and not BodyCuller::supported()) {
+			std::cerr << "Warning: GPU culling requires OpenGL 4.3; culling on the CPU instead."
+			          << std::endl;
+		}
+		else if (gpuCulling) {
+			depthPyramid.reset(new DepthPyramid());
+			planetRenderer.enableGpuCulling(depthPyramid.get());
+			moonRenderer.enableGpuCulling(depthPyramid.get());
+			asteroidRenderer.enableGpuCulling(depthPyramid.get());
+		}
 
-		// Create moons for the planets using procedural generation.
-		std::vector<Moon> rockyMoons = generateMoons(rockyPlanets);
-		std::vector<Moon> gaseousMoons = generateMoons(gaseousPlanets);
+		// Draw distant bodies culled on the CPU as impostors, batched into one draw item.
+		Impostors impostors(world.planets.size() + world.moons.size() + world.asteroids.size(),
+		                    impostorSize);
+		planetRenderer.setImpostors(&impostors);
+		moonRenderer.setImpostors(&impostors);
+		asteroidRenderer.setImpostors(&impostors);
 
 		// Create spaceship and spacecowboy.
-		Spaceship   spaceship;
-		Spacecowboy spacecowboy;
+		Spaceship   spaceship(assets, textureLoader, compactVertices, assetPack.get());
+		Spacecowboy spacecowboy(assets, textureLoader, compactVertices, assetPack.get());
+		uploads.finish();
+		if (listAssets) {
+			assets.report(std::cout);
+		}
 
-		//choose random planet on which to spawn spacecowboy
-		int randomPlanet = rand() % gaseousPlanets.size();
+		// Report the size of the uploaded meshes, to compare the vertex layouts.
+		std::size_t meshBytes = planetRenderer.meshBytes() + moonRenderer.meshBytes() +
+		                        asteroidRenderer.meshBytes() + spaceship.meshBytes() +
+		                        spacecowboy.meshBytes();
+		std::cout << "Mesh data: " << meshBytes / 1024 << " KiB ("
+		          << (compactVertices ? "compact" : "float") << " vertex layout)" << std::endl;
+
+		// Create the camera uniform buffer shared by all shader programs, and the render queue the
+		// objects submit their draws to.
+		CameraUniforms  cameraUniforms;
+		RenderQueue     renderQueue(NEAR_CLIPPING_PLANE, FAR_CLIPPING_PLANE);
+		OcclusionBuffer occlusionBuffer;
+
+		// Create GPU pass timer, performance overlay and benchmark recorder.
+		GpuTimer  gpuTimer;
+		Overlay   overlay;
+		Benchmark benchmark(benchmarkFrames, benchmarkOutput);
+		benchmark.setMeshBytes(meshBytes);
+		double    timeFrameStart      = glfwGetTime();
+		double    timeLastTick        = timeFrameStart;
+		double    timeLastTitleUpdate = 0.0;
+		bool      titleShowsStats     = false;
+		double    deltaT              = 0.0;
 
 		#if PLAY_MUSIC
 			system("mplayer ./music/interstellar.mp3  </dev/null >/dev/null 2>&1 &");
 		#endif
 
 		// Game loop.
-		while (not window.shouldClose()) {
-			// Set time difference between last and current frame
-			window.updateDeltaTime();
-			window.updatePosition();
-
-			// Clear the screen and poll for event triggers.
-			window.clear();
-			window.pollEvents();
-
-			// Adjust camera's aspect ratio and the window's viewport in case window dimensions
-			// changed.
-			camera.setAspectRatio(window.aspectRatio());
-			window.setViewport();
+		while (not window.shouldClose() and not benchmark.finished() and
+		       not inputRecorder.replayFinished()) {
+			PROFILE_FRAME_BEGIN();
+
+			// Start counting the render statistics of this frame.
+			renderStats::beginFrame();
+
+			{
+				PROFILE_SCOPE("Input");
+
+				// Advance the simulation clock by one tick. When replaying, the recorded tick
+				// duration is used instead of the measured one.
+				double timeTick = glfwGetTime();
+				deltaT       = inputRecorder.beginTick(timeTick - timeLastTick);
+				timeLastTick = timeTick;
+				simClock::advance(deltaT);
+
+				// Set time difference between last and current frame
+				window.updateDeltaTime();
+				window.updatePosition();
+
+				// Clear the screen and poll for event triggers.
+				window.clear();
+				window.pollEvents();
+				if (inputRecorder.replaying()) {
+					window.replayEvents(inputRecorder.tickEvents());
+				}
 
+				// Adjust camera's aspect ratio and the window's viewport in case window dimensions
+				// changed.
+				camera.setAspectRatio(window.aspectRatio());
+				window.setViewport();
+			}
 
 			// Update all Positions and states of Objects in the game
+			{
+				PROFILE_SCOPE("Update");
 
-			// Update planet's state.
-			for (Planet& planet : rockyPlanets) {
-				planet.updateState();
-			}
-			for (Planet& planet : gaseousPlanets) {
-				planet.updateState();
-			}
-
-			// Update moons.
-			for (Moon& moon : rockyMoons) {
-				moon.updateState();
-			}
-			for (Moon& moon : gaseousMoons) {
-				moon.updateState();
+				updateWorld(world, static_cast<float>(deltaT));
+				updateShip(ship, camera);
+				updateCowboy(cowboy, world.planets[world.cowboyPlanet]);
 			}
 
-			// Update spaceships's and spacecowboy's state.
-			spaceship.updateState(camera);
-			spacecowboy.updateState(camera, gaseousPlanets[randomPlanet]);
-
-			//Check for collisions with planets
-			for (Planet& planet : rockyPlanets) {
-				if (planet.planetCollision(camera)) {
+			//Check for collisions with the sun, planets and moons
+			{
+				PROFILE_SCOPE("Collision");
 
+				glm::vec3 bounce;
+				if (worldCollision(world, camera.position(), camera.direction(), bounce)) {
 					window.setCollisison(true);
-					window.setBounce(glm::normalize(glm::vec3(camera.position() - planet.position()) * 2.0f));
-					break;
+					window.setBounce(bounce);
 				}
-				//window.setCollisison(false);
 			}
 
-			for (Planet& planet : gaseousPlanets) {
-				if (planet.planetCollision(camera)) {
+			{
+				PROFILE_SCOPE("Draw");
+
+				// Read back the GPU timings of an earlier frame.
+				gpuTimer.beginFrame();
+
+				// Carry out the uploads requested since the last frame, within the frame's budget.
+				uploads.process();
+
+				// Upload the frame's camera block once; every shader reads it from the camera
+				// uniform buffer.
+				const CameraBlock& cameraBlock = camera.block();
+				cameraUniforms.update(cameraBlock, simClock::now());
+
+				// Rasterize the sun, planets and moons into the occlusion buffer, so that bodies
+				// hidden behind them are not submitted.
+				const OcclusionBuffer *pOcclusionBuffer = nullptr;
+				if (occlusion) {
+					PROFILE_SCOPE("Occlusion");
+
+					occlusionBuffer.clear(cameraBlock);
+					occlusionBuffer.addOccluder(world.sun.position(), world.sun.size());
+					for (const Body& planet : world.planets) {
+						occlusionBuffer.addOccluder(planet.position(),
+						                            MIN_TERRAIN_RADIUS * planet.size());
+					}
+					for (const Body& moon : world.moons) {
+						occlusionBuffer.addOccluder(moon.position(), MIN_TERRAIN_RADIUS * moon.size());
+					}
+					occlusionBuffer.buildHierarchy();
+					pOcclusionBuffer = &occlusionBuffer;
+				}
 
-					window.setCollisison(true);
-					window.setBounce(glm::normalize(glm::vec3(camera.position() - planet.position()) * 2.0f));
-					break;
+				// Submit every object to the render queue. The queue sorts the draws by pass,
+				// program, texture, winding and depth, drawing opaque objects front to back and the
+				// stars last, behind everything else.
+				renderQueue.clear();
+				impostors.clear(cameraBlock, static_cast<float>(window.height()));
+				stars.submit(renderQueue);
+				sun.submit(renderQueue, world.sun, cameraBlock);
+				planetRenderer.submit(renderQueue, world.planets, cameraBlock, pOcclusionBuffer,
+				                      GpuTimer::PLANETS);
+				moonRenderer.submit(renderQueue, world.moons, cameraBlock, pOcclusionBuffer,
+				                    GpuTimer::MOONS);
+				asteroidRenderer.submit(renderQueue, world.asteroids, cameraBlock, pOcclusionBuffer,
+				                        GpuTimer::ASTEROIDS);
+				impostors.submit(renderQueue);
+				spaceship.submit(renderQueue, ship, cameraBlock);
+				spacecowboy.submit(renderQueue, cowboy, cameraBlock);
+
+				renderQueue.sort();
+				renderQueue.execute(gpuTimer);
+
+				// Build the depth pyramid the next frame is culled against.
+				if (depthPyramid) {
+					gpuTimer.begin(GpuTimer::DEPTH_PYRAMID);
+					depthPyramid->update(window.width(), window.height(),
+					                     cameraBlock.viewProjection);
+					gpuTimer.end(GpuTimer::DEPTH_PYRAMID);
 				}
-				//window.setCollisison(false);
 			}
 
-			for (Moon& moon : rockyMoons) {
-				if (moon.moonCollision(camera)) {
-
-					window.setCollisison(true);
-					window.setBounce(glm::normalize(
-						glm::vec3(camera.position() - moon.position()) * 2.0f));
-					break;
+			// Draw the performance overlay: one bar per pass, relative to a 60 Hz frame, followed by
+			// the previous frame's render statistics relative to their budgets. The exact numbers are
+			// shown in the window title.
+			if (window.overlayVisible()) {
+				PROFILE_SCOPE("Overlay");
+
+				overlay.clear();
+				for (int pass = 0; pass < GpuTimer::N_PASSES; ++pass) {
+					GpuTimer::Pass gpuPass = static_cast<GpuTimer::Pass>(pass);
+					overlay.addBar(static_cast<float>(gpuTimer.averageMilliseconds(gpuPass) /
+					                                  OVERLAY_FRAME_BUDGET_MS),
+					               GpuTimer::passColour(gpuPass));
 				}
-				//window.setCollisison(false);
-			}
-			for (Moon& moon : gaseousMoons) {
-				if (moon.moonCollision(camera)) {
 
-					window.setCollisison(true);
-					window.setBounce(glm::normalize(
-							glm::vec3(camera.position() - moon.position()) * 2.0f));
-					break;
+				const renderStats::FrameStats& stats = renderStats::previous();
+				overlay.addSeparator();
+				overlay.addBar(static_cast<float>(stats.drawCalls) / OVERLAY_DRAW_CALL_BUDGET,
+				               palette::WHITE);
+				overlay.addBar(static_cast<float>(stats.programSwitches + stats.vaoBinds +
+				                                  stats.textureBinds + stats.bufferBinds) /
+				               OVERLAY_STATE_CHANGE_BUDGET,
+				               palette::OLIVE);
+				overlay.addBar(static_cast<float>(stats.uniformUploads) / OVERLAY_UNIFORM_BUDGET,
+				               palette::TEAL);
+				overlay.addBar(static_cast<float>(stats.triangles) / OVERLAY_TRIANGLE_BUDGET,
+				               palette::FUCHSIA);
+				overlay.draw();
+
+				if (glfwGetTime() - timeLastTitleUpdate > OVERLAY_TITLE_INTERVAL) {
+					window.setTitle(std::string(WINDOW_TITLE) + " - " + gpuTimer.summary() + " - " +
+					                renderStats::summary(stats));
+					timeLastTitleUpdate = glfwGetTime();
+					titleShowsStats     = true;
 				}
-				//window.setCollisison(false);
 			}
-
-			// Test for sun collision
-			if (sun.sunCollision(camera)) {
-				window.setCollisison(true);
-				window.setBounce(glm::normalize(glm::vec3(camera.position()) * 2.0f));
+			else if (titleShowsStats) {
+				window.setTitle(WINDOW_TITLE);
+				titleShowsStats = false;
 			}
 
-			// Draw stars.
-			stars.draw(camera);
-
-			// Sun and Planets created from same sphere algorithm therefore same culling orientation
-			glEnable(GL_CULL_FACE);
-			glFrontFace(GL_CW);
-
-			// Draw the Sun.
-			sun.draw(camera);
+			{
+				PROFILE_SCOPE("SwapBuffers");
 
-			// Draw the planets.
-			for (const Planet& planet : rockyPlanets) {
-				planet.draw(camera);
+				// Swap the front and back buffers.
+				window.swapBuffers();
 			}
-			for (const Planet& planet : gaseousPlanets) {
-				planet.draw(camera);
-			}
-
-			// Draw the moons.
-			for (const Moon& moon : rockyMoons) {
-				moon.draw(camera);
-			}
-			for (const Moon& moon : gaseousMoons) {
-				moon.draw(camera);
-			}
-
-			//Assets (Space Ship & DeadPool) loaded with a CCW orientation
-			glFrontFace(GL_CCW);
 
-			// Draw the spaceship.
-			spaceship.draw(camera);
+			// Delete the assets released during the frame, now that its draws are executed.
+			assets.collect();
 
-			// Draw the spacecowboy.
-			spacecowboy.draw(camera);
+			// Record the frame for the benchmark.
+			double timeFrameEnd = glfwGetTime();
+			benchmark.recordFrame(1000.0 * (timeFrameEnd - timeFrameStart),
+			                      gpuTimer.totalAverageMilliseconds(), renderStats::current());
+			timeFrameStart = timeFrameEnd;
 
-			// Swap the front and back buffers.
-			window.swapBuffers();
+			PROFILE_FRAME_END();
 		}
 		#if PLAY_MUSIC
 			system("kill -9 $(pgrep -f \"mplayer\")");
 		#endif
 
+		// Write the recording, if any.
+		inputRecorder.finish();
+
 	}
 	catch (const std::exception& e) {
 		// Print error message to stderr and exit.
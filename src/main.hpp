@@ -4,21 +4,45 @@
  * Main header file. Includes header files necessary for the program's main function, along with
  * useful program constants.
  */
-#include "camera.hpp"
+#include "core/asset_pack.hpp"
+#include "asset_registry.hpp"
+#include "benchmark.hpp"
+#include "body_culler.hpp"
+#include "core/camera.hpp"
+#include "camera_uniforms.hpp"
+#include "depth_pyramid.hpp"
 #include "glfw_guard.hpp"
-#include "moon.hpp"
+#include "core/input_recorder.hpp"
+#include "core/occlusion_buffer.hpp"
+#include "gpu_timer.hpp"
+#include "impostors.hpp"
+#include "overlay.hpp"
 #include "palette.hpp"
 #include "planet.hpp"
+#include "core/profiler.hpp"
 #include "program.hpp"
+#include "render_queue.hpp"
+#include "render_stats.hpp"
+#include "core/ship.hpp"
+#include "core/sim_clock.hpp"
 #include "stars.hpp"
 #include "sun.hpp"
+#include "texture_loader.hpp"
+#include "upload_service.hpp"
 #include "window.hpp"
-#include "planetGenerator.hpp"
+#include "core/world.hpp"
+#include "core/world_random.hpp"
 #include "spacecowboy.hpp"
 #include "spaceship.hpp"
 
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -35,6 +59,20 @@ constexpr char WINDOW_TITLE[] = "Space Cowboy";
 /** Window background colour. */
 constexpr palette::rgb_t WINDOW_BG_COLOUR = palette::BLACK;
 
+// Overlay properties.
+/** Frame time in milliseconds represented by a full overlay bar. */
+constexpr double OVERLAY_FRAME_BUDGET_MS     = 1000.0 / 60.0;
+/** Seconds between updates of the statistics shown in the window title. */
+constexpr double OVERLAY_TITLE_INTERVAL      = 0.5;
+/** Draw calls per frame represented by a full overlay bar. */
+constexpr float  OVERLAY_DRAW_CALL_BUDGET    = 200.0f;
+/** Program, vertex array and texture binds per frame represented by a full overlay bar. */
+constexpr float  OVERLAY_STATE_CHANGE_BUDGET = 600.0f;
+/** Uniform uploads per frame represented by a full overlay bar. */
+constexpr float  OVERLAY_UNIFORM_BUDGET      = 800.0f;
+/** Triangles per frame represented by a full overlay bar. */
+constexpr float  OVERLAY_TRIANGLE_BUDGET     = 4000000.0f;
+
 // Camera properties.
 /** Field of view in radians. */
 constexpr float FIELD_OF_VIEW       = 1.2f;
@@ -50,17 +88,6 @@ const glm::vec3 INITIAL_CAMERA_POSITION = { 0, 0, 1300.0f };
 /** Upwards direction of camera view. */
 const glm::vec3 INITIAL_UP              = { 0, 1.0f, 0 };
 
-// Sun properties.
-/** Size of Sun. */
-constexpr float SUN_SIZE = 800.5f;
-
-// Planet properties.
-/** Size of planet. */
-constexpr float PLANET_SIZE  = 0.5f;
-/** Orbital radius. */
-constexpr float ORBIT_RADIUS = 2.5f;
-
-/** Planet's angular velocity. */
-const glm::vec3 PLANET_ANGULAR_VELOCITY         = { 0, 0.0f, 0 };
-/** Planet's orbital angular velocity. */
-const glm::vec3 PLANET_ORBITAL_ANGULAR_VELOCITY = { 0, 0.0f, 0 };
+// Impostor properties.
+/** Default projected radius in pixels below which bodies are drawn as impostors. */
+constexpr float DEFAULT_IMPOSTOR_SIZE = 8.0f;
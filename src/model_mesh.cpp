@@ -0,0 +1,236 @@
+/**
+ * @file model_mesh.cpp
+ *
+ * Implementation file for the ModelMesh class.
+ */
+#include "model_mesh.hpp"
+
+#include "core/asset_cook.hpp"
+#include "core/objloader.hpp"
+#include "core/vertex_format.hpp"
+#include "gl_calls.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * Projected radius of a model's bounding sphere, as a fraction of half the viewport height, below
+ * which each level of detail after the first is used.
+ */
+constexpr float LEVEL_SCREEN_SIZES[assetCook::MODEL_LEVELS - 1] = { 0.2f, 0.1f, 0.05f };
+
+/**
+ * Views the cooked model in place in an asset pack if the pack holds it, and cooks the OBJ file
+ * otherwise.
+ *
+ * @param model View of the cooked model.
+ * @param cooked Payload of the model cooked from the OBJ file, which the view then points into.
+ * @return Entry of the model in the pack, or nullptr if the OBJ file was cooked.
+ * @throws std::runtime_error if the OBJ file cannot be loaded.
+ */
+const AssetPack::Entry *loadModel(const char *path, const AssetPack *pack,
+                                  assetCook::ModelView& model, std::vector<std::uint8_t>& cooked) {
+	const AssetPack::Entry *entry = pack == nullptr ? nullptr : pack->find(path, AssetPack::MODEL);
+	if (entry != nullptr) {
+		try {
+			model = assetCook::viewModel(pack->payload(*entry), entry->size);
+			return entry;
+		}
+		catch (const std::runtime_error& error) {
+			std::cerr << "Warning: " << error.what() << " Loading " << path << " instead."
+			          << std::endl;
+		}
+	}
+
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> UVs;
+	if (not loadOBJ(path, vertices, normals, UVs) or vertices.empty()) {
+		throw std::runtime_error(std::string("Model ") + path + " cannot be loaded.");
+	}
+	cooked = assetCook::serialize(assetCook::cookModel(vertices, normals, UVs,
+	                                                   assetCook::MODEL_LEVELS));
+	model  = assetCook::viewModel(cooked.data(), cooked.size());
+	return nullptr;
+}
+}
+
+// Redeclare constant static data members.
+constexpr char ModelMesh::COMPACT_VERTEX_SHADER_PATH[];
+
+// Constructors.
+ModelMesh::ModelMesh(const char *path, bool compactVertices, const AssetPack *pack) :
+		mIndexType(GL_UNSIGNED_INT),
+		mIndexSize(sizeof(std::uint32_t)),
+		mMeshMatrix(1.0f),
+		mMeshBytes(0) {
+	// Upload the model straight from the mapped asset pack, or from the cooked OBJ file.
+	assetCook::ModelView      model;
+	std::vector<std::uint8_t> cooked;
+	const AssetPack::Entry   *entry = loadModel(path, pack, model, cooked);
+	mBoundsCentre = model.boundsCentre;
+	mBoundsRadius = model.boundsRadius;
+
+	std::cout << "Model " << path << " levels of detail:";
+	for (std::size_t level = 0; level < model.levelCounts.size; ++level) {
+		mLevelOffsets.push_back(model.levelOffsets.data[level]);
+		mLevelCounts.push_back(static_cast<GLsizei>(model.levelCounts.data[level]));
+
+		std::cout << (level == 0 ? " " : ", ") << model.levelCounts.data[level] / 3;
+		if (level > 0) {
+			double reduction = 1.0 - static_cast<double>(model.levelCounts.data[level]) /
+			                         model.levelCounts.data[0];
+			std::cout << " (-" << std::lround(100.0 * reduction) << "%)";
+		}
+	}
+	std::cout << " triangles" << std::endl;
+
+	mVAO = GlVertexArray::generate();
+	mVBO = GlBuffer::generate();
+	mEBO = GlBuffer::generate();
+	gl::bindVertexArray(mVAO.id());
+
+	std::size_t nVertices = model.vertices.size;
+	if (compactVertices) {
+		// Pass the cooked vertices into the vertex buffer object as they are: quantized positions
+		// and octahedral normals normalized by the GPU, and half float texture coordinates.
+		mMeshMatrix = vertexFormat::dequantization(model.quantization);
+
+		GLsizei stride = sizeof(vertexFormat::ModelVertex);
+		mMeshBytes     = sizeof(vertexFormat::ModelVertex) * nVertices;
+		gl::bindBuffer(GL_ARRAY_BUFFER, mVBO.id());
+		gl::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mMeshBytes), model.vertices.data,
+		               GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, stride,
+		                      reinterpret_cast<GLvoid *>(offsetof(vertexFormat::ModelVertex,
+		                                                          position)));
+		glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride,
+		                      reinterpret_cast<GLvoid *>(offsetof(vertexFormat::ModelVertex,
+		                                                          normal)));
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+		                      reinterpret_cast<GLvoid *>(offsetof(vertexFormat::ModelVertex, uv)));
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+	}
+	else {
+		// Decode the cooked vertices back to floats.
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> UVs;
+		for (const vertexFormat::ModelVertex& vertex : model.vertices) {
+			positions.push_back(vertexFormat::dequantizePosition(vertex.position,
+			                                                     model.quantization));
+			normals.push_back(vertexFormat::decodeOctahedral(vertex.normal));
+			UVs.push_back(glm::vec2(vertexFormat::fromHalf(vertex.uv[0]),
+			                        vertexFormat::fromHalf(vertex.uv[1])));
+		}
+
+		mNormalVBO = GlBuffer::generate();
+		mUVVBO     = GlBuffer::generate();
+
+		// Bind and buffer the vertices into the VBO and enable position 0.
+		gl::bindBuffer(GL_ARRAY_BUFFER, mVBO.id());
+		gl::bufferData(GL_ARRAY_BUFFER,
+		               static_cast<GLsizeiptr>(sizeof(glm::vec3) * positions.size()),
+		               positions.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3),
+		                      reinterpret_cast<GLvoid *>(0));
+		glEnableVertexAttribArray(0);
+
+		// Bind and buffer the normals into the normal VBO and put them at location 1.
+		gl::bindBuffer(GL_ARRAY_BUFFER, mNormalVBO.id());
+		gl::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(glm::vec3) * normals.size()),
+		               normals.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3),
+		                      reinterpret_cast<GLvoid *>(0));
+		glEnableVertexAttribArray(1);
+
+		// Bind and buffer the UVs into the UV VBO at location 2.
+		gl::bindBuffer(GL_ARRAY_BUFFER, mUVVBO.id());
+		gl::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(glm::vec2) * UVs.size()),
+		               UVs.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2),
+		                      reinterpret_cast<GLvoid *>(0));
+		glEnableVertexAttribArray(2);
+		mMeshBytes = (2 * sizeof(glm::vec3) + sizeof(glm::vec2)) * nVertices;
+	}
+
+	// Pass the indices of all levels into the element buffer object: as cooked in the compact
+	// layout, 16-bit if the model has few enough vertices, and widened to 32 bits otherwise.
+	gl::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO.id());
+	if (compactVertices) {
+		mIndexSize = model.indexSize;
+		mIndexType = mIndexSize == sizeof(std::uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		gl::bufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(model.indices.size),
+		               model.indices.data, GL_STATIC_DRAW);
+	}
+	else {
+		std::vector<std::uint32_t> indices(model.nIndices());
+		for (std::size_t i = 0; i < indices.size(); ++i) {
+			indices[i] = model.index(i);
+		}
+		gl::bufferData(GL_ELEMENT_ARRAY_BUFFER,
+		               static_cast<GLsizeiptr>(mIndexSize * indices.size()), indices.data(),
+		               GL_STATIC_DRAW);
+	}
+	mMeshBytes += mIndexSize * model.nIndices();
+
+	// Unbind everything for safety, and let the OS drop the uploaded payload's pages.
+	gl::bindVertexArray(0);
+	gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+	if (entry != nullptr) {
+		pack->release(*entry);
+	}
+}
+
+// Accessor functions.
+const glm::mat4& ModelMesh::meshMatrix() const {
+	return mMeshMatrix;
+}
+
+std::size_t ModelMesh::meshBytes() const {
+	return mMeshBytes;
+}
+
+std::size_t ModelMesh::nLevels() const {
+	return mLevelCounts.size();
+}
+
+std::size_t ModelMesh::levelTriangles(std::size_t level) const {
+	return static_cast<std::size_t>(mLevelCounts[level]) / 3;
+}
+
+std::size_t ModelMesh::selectLevel(const glm::mat4& model, const CameraBlock& camera) const {
+	// Transform the bounding sphere, scaling its radius by the model's largest axis scale.
+	glm::vec3 centre = glm::vec3(model * glm::vec4(mBoundsCentre, 1.0f));
+	float     scale  = std::max(std::max(glm::length(glm::vec3(model[0])),
+	                                     glm::length(glm::vec3(model[1]))),
+	                            glm::length(glm::vec3(model[2])));
+	float     radius = scale * mBoundsRadius;
+	float     depth  = camera.viewDepth(centre);
+	if (depth <= radius) {
+		return 0;
+	}
+
+	float       screenSize = camera.projection[1][1] * radius / depth;
+	std::size_t level      = 0;
+	std::size_t nLevels    = std::min(mLevelCounts.size(), assetCook::MODEL_LEVELS);
+	while (level + 1 < nLevels and screenSize < LEVEL_SCREEN_SIZES[level]) {
+		++level;
+	}
+	return level;
+}
+
+// OpenGL modifier functions.
+void ModelMesh::draw(std::size_t level) const {
+	gl::bindVertexArray(mVAO.id());
+	gl::drawElements(GL_TRIANGLES, mLevelCounts[level], mIndexType,
+	                 reinterpret_cast<GLvoid *>(mLevelOffsets[level] * mIndexSize));
+}
@@ -0,0 +1,147 @@
+/**
+ * @file model_mesh.hpp
+ *
+ * Interface file for the ModelMesh class.
+ */
+#ifndef SPACE_COWBOY_MODEL_MESH_HPP
+#define SPACE_COWBOY_MODEL_MESH_HPP
+
+#include "core/asset_pack.hpp"
+#include "core/camera.hpp"
+#include "gl_object.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+ * Vertex array of a textured model, with positions at attribute location 0, normals at 1 and
+ * texture coordinates at 2. The model is cooked by assetCook, either ahead of time into an asset
+ * pack or from its OBJ file when loaded: identical vertices are merged and indexed, and the model
+ * is simplified into a chain of levels of detail whose indices follow each other in one element
+ * buffer, ordered for the vertex cache. In the float layout each attribute has its own buffer. In
+ * the compact layout of vertexFormat the cooked vertices and indices are uploaded as they are,
+ * straight from the mapped pack, with 16-bit indices when few enough vertices remain, and the
+ * shader program must be built from COMPACT_VERTEX_SHADER_PATH. A ModelMesh should only be
+ * constructed after OpenGL has initialized.
+ */
+class ModelMesh {
+public:
+	// Constants.
+	/** Path to the vertex shader source code of models in the compact layout. */
+	static constexpr char COMPACT_VERTEX_SHADER_PATH[] = "shaders/model_compact_vertex.shader";
+
+	// Constructors.
+	/**
+	 * Loads a cooked model from an asset pack, or cooks it from its OBJ file if the pack does not
+	 * hold it, and uploads it. Prints the triangle count of each level of detail.
+	 *
+	 * @param path Path to the OBJ file, which names the cooked model.
+	 * @param compactVertices True to upload the model in the compact vertex layout.
+	 * @param pack Asset pack to load the cooked model from, or nullptr to cook the OBJ file.
+	 * @throws std::runtime_error if the model cannot be loaded.
+	 */
+	ModelMesh(const char *path, bool compactVertices, const AssetPack *pack = nullptr);
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	ModelMesh(const ModelMesh&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const ModelMesh&) = delete;
+
+	/**
+	 * Move constructor, taking the objects of another mesh and leaving it empty.
+	 */
+	ModelMesh(ModelMesh&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the objects of the mesh and taking those of another.
+	 */
+	ModelMesh& operator=(ModelMesh&&) noexcept = default;
+
+	// Accessor functions.
+	/**
+	 * Returns the matrix to post-multiply into the model matrix, which undoes the position
+	 * quantization of the compact layout.
+	 *
+	 * @return Dequantization matrix, or the identity in the float layout.
+	 */
+	const glm::mat4& meshMatrix() const;
+
+	/**
+	 * Returns the size of the uploaded vertex and index data.
+	 *
+	 * @return Size of the mesh data in bytes.
+	 */
+	std::size_t meshBytes() const;
+
+	/**
+	 * Returns the number of levels of detail.
+	 *
+	 * @return Number of levels, including the full detail one.
+	 */
+	std::size_t nLevels() const;
+
+	/**
+	 * Returns the number of triangles of a level of detail.
+	 *
+	 * @param level Level, 0 being the full detail one.
+	 * @return Number of triangles.
+	 */
+	std::size_t levelTriangles(std::size_t level) const;
+
+	/**
+	 * Selects the level of detail to draw the model with from the size of its bounding sphere on
+	 * the screen, each level being used once the sphere shrinks below a fraction of the screen.
+	 *
+	 * @param model Model matrix of the model, without the mesh matrix.
+	 * @param camera Camera block of the frame.
+	 * @return Level of detail.
+	 */
+	std::size_t selectLevel(const glm::mat4& model, const CameraBlock& camera) const;
+
+	// OpenGL modifier functions.
+	/**
+	 * Binds the vertex array and draws the model with the enabled program.
+	 *
+	 * @param level Level of detail to draw.
+	 */
+	void draw(std::size_t level = 0) const;
+
+private:
+	// Data members.
+	/** Vertex array object. */
+	GlVertexArray            mVAO;
+	/** Position buffer, or interleaved vertices if compact. */
+	GlBuffer                 mVBO;
+	/** Normal buffer. Empty in the compact layout. */
+	GlBuffer                 mNormalVBO;
+	/** Texture coordinate buffer. Empty in the compact layout. */
+	GlBuffer                 mUVVBO;
+	/** Element buffer object. */
+	GlBuffer                 mEBO;
+	/** Type of the indices. */
+	GLenum                   mIndexType;
+	/** Size of an index in bytes. */
+	std::size_t              mIndexSize;
+	/** First index of each level of detail in the element buffer. */
+	std::vector<std::size_t> mLevelOffsets;
+	/** Number of indices of each level of detail. */
+	std::vector<GLsizei>     mLevelCounts;
+	/** Centre of the model's bounding sphere in model space. */
+	glm::vec3                mBoundsCentre;
+	/** Radius of the model's bounding sphere in model space. */
+	float                    mBoundsRadius;
+	/** Dequantization matrix of the positions. */
+	glm::mat4                mMeshMatrix;
+	/** Size of the uploaded vertex and index data in bytes. */
+	std::size_t              mMeshBytes;
+};
+
+#endif
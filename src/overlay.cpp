@@ -0,0 +1,106 @@
+/**
+ * @file overlay.cpp
+ *
+ * Implementation file for the Overlay class.
+ */
+#include "overlay.hpp"
+
+#include "gl_calls.hpp"
+
+#include <algorithm>
+
+namespace {
+// Shader program file paths.
+/** Path to vertex shader source code. */
+constexpr char VERTEX_SHADER_PATH[]   = "shaders/overlay_vertex.shader";
+/** Path to fragment shader source code. */
+constexpr char FRAGMENT_SHADER_PATH[] = "shaders/overlay_fragment.shader";
+
+// Layout in normalized device coordinates.
+/** Left edge of the bars. */
+constexpr float LEFT       = -0.98f;
+/** Top edge of the first bar. */
+constexpr float TOP        = 0.96f;
+/** Length of a full bar. */
+constexpr float MAX_LENGTH = 0.6f;
+/** Height of a bar. */
+constexpr float BAR_HEIGHT = 0.025f;
+/** Vertical distance between the tops of consecutive bars. */
+constexpr float ROW_HEIGHT = 0.035f;
+
+/** Number of floats per vertex: two for position and three for colour. */
+constexpr unsigned int VERTEX_SIZE = 5;
+}
+
+// Constructors.
+Overlay::Overlay() :
+		mProgram(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH),
+		mNRows(0) {
+	// Create vertex array buffer and vertex buffer object and bind them to current OpenGL context.
+	mVAO = GlVertexArray::generate();
+	mVBO = GlBuffer::generate();
+	gl::bindVertexArray(mVAO.id());
+	gl::bindBuffer(GL_ARRAY_BUFFER, mVBO.id());
+
+	// Create and enable vertex attributes for position and colour data.
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),
+	                      reinterpret_cast<GLvoid *>(0));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(GLfloat),
+	                      reinterpret_cast<GLvoid *>(2 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(1);
+
+	// Unbind vertex array buffer and vertex buffer object.
+	gl::bindVertexArray(0);
+	gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Mutator functions.
+void Overlay::clear() {
+	mVertices.clear();
+	mNRows = 0;
+}
+
+void Overlay::addBar(float fraction, const palette::rgb_t& colour) {
+	float length = MAX_LENGTH * std::min(std::max(fraction, 0.0f), 1.0f);
+	float top    = TOP - ROW_HEIGHT * mNRows;
+	++mNRows;
+
+	// Two triangles per bar.
+	const GLfloat corners[6][2] = {
+			{ LEFT, top }, { LEFT, top - BAR_HEIGHT }, { LEFT + length, top - BAR_HEIGHT },
+			{ LEFT + length, top - BAR_HEIGHT }, { LEFT + length, top }, { LEFT, top }
+	};
+	for (const auto& corner : corners) {
+		mVertices.insert(mVertices.end(), { corner[0], corner[1], colour[0], colour[1],
+		                                    colour[2] });
+	}
+}
+
+void Overlay::addSeparator() {
+	++mNRows;
+}
+
+// OpenGL modifier functions.
+void Overlay::draw() {
+	if (mVertices.empty()) {
+		return;
+	}
+
+	// The overlay is drawn on top of everything else.
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_CULL_FACE);
+
+	mProgram.enable();
+	gl::bindVertexArray(mVAO.id());
+	gl::bindBuffer(GL_ARRAY_BUFFER, mVBO.id());
+
+	// Orphan the previous frame's buffer and upload this frame's bars.
+	gl::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(GLfloat) * mVertices.size()),
+	               mVertices.data(), GL_STREAM_DRAW);
+
+	gl::drawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mVertices.size() / VERTEX_SIZE));
+
+	// Restore state. The program and buffers stay bound; the state cache skips rebinding them.
+	glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file overlay.hpp
+ *
+ * Interface file for the Overlay class.
+ */
+#ifndef SPACE_COWBOY_OVERLAY_HPP
+#define SPACE_COWBOY_OVERLAY_HPP
+
+#include "gl_object.hpp"
+#include "palette.hpp"
+#include "program.hpp"
+
+#include <vector>
+#include <GL/glew.h>
+
+/**
+ * Draws a column of horizontal bars in the top left corner of the screen, on top of the scene. Each
+ * bar's length is a fraction of the maximum bar length, which makes the overlay suitable for
+ * showing timings and counters relative to a budget. Bars are added every frame and discarded by
+ * clear.
+ */
+class Overlay {
+public:
+	// Constructors.
+	/**
+	 * Creates an empty overlay.
+	 */
+	Overlay();
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	Overlay(const Overlay&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const Overlay&) = delete;
+
+	/**
+	 * Move constructor, taking the objects of another overlay and leaving it empty.
+	 */
+	Overlay(Overlay&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the objects of the overlay and taking those of another.
+	 */
+	Overlay& operator=(Overlay&&) noexcept = default;
+
+	// Mutator functions.
+	/**
+	 * Removes all bars.
+	 */
+	void clear();
+
+	/**
+	 * Adds a bar below the previously added bars.
+	 *
+	 * @param fraction Length of the bar as a fraction of the maximum length. Clamped to [0, 1].
+	 * @param colour Colour of the bar.
+	 */
+	void addBar(float fraction, const palette::rgb_t& colour);
+
+	/**
+	 * Adds an empty row, which separates groups of bars.
+	 */
+	void addSeparator();
+
+	// OpenGL modifier functions.
+	/**
+	 * Renders the bars.
+	 */
+	void draw();
+
+private:
+	// Data members.
+	/** Shader program. */
+	Program       mProgram;
+	/** Vertex array object. */
+	GlVertexArray mVAO;
+	/** Vertex buffer object. */
+	GlBuffer      mVBO;
+
+	/** Interleaved position and colour of each bar vertex. */
+	std::vector<GLfloat> mVertices;
+	/** Number of rows added since the last clear. */
+	unsigned int         mNRows;
+};
+
+#endif
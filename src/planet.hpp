@@ -6,34 +6,63 @@
 #ifndef SPACE_COWBOY_PLANET_HPP
 #define SPACE_COWBOY_PLANET_HPP
 
-#include "camera.hpp"
-#include "palette.hpp"
+#include "asset_registry.hpp"
+#include "body_culler.hpp"
+#include "core/body.hpp"
+#include "core/camera.hpp"
+#include "core/occlusion_buffer.hpp"
+#include "core/radix_sort.hpp"
+#include "core/vertex_format.hpp"
+#include "core/world.hpp"
+#include "depth_pyramid.hpp"
+#include "gl_object.hpp"
+#include "gpu_timer.hpp"
+#include "impostors.hpp"
 #include "program.hpp"
-#include "sphere.hpp"
+#include "render_queue.hpp"
+#include "stream_buffer.hpp"
+#include "upload_service.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <GL/glew.h>
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-#include <cmath>
 
 /**
- * Represents a planet.
+ * Renders a group of planets, moons or asteroids with one shader program. The meshes of all bodies
+ * share one vertex array, vertex buffer and element buffer, and several bodies may share a mesh.
+ * Vertices are either floats, with colours in their own buffer, or in the compact interleaved
+ * layout of vertexFormat with 16-bit indices where the meshes are small enough; the compact
+ * layout's position quantization is undone by each mesh's dequantization matrix, folded into the
+ * model matrices.
+ * Each frame the visible bodies' model matrices are streamed into a per-instance vertex attribute,
+ * in front-to-back order. When multi-draw indirect is
+ * supported (OpenGL 4.3, or ARB_multi_draw_indirect and ARB_base_instance), one indirect command per
+ * visible body is streamed as well and the whole group is drawn with a single
+ * glMultiDrawElementsIndirect, each command selecting its model matrix through its base instance.
+ * Otherwise each body is drawn with its own glDrawElementsBaseVertex. When GPU culling is enabled
+ * the bodies are instead culled and drawn by a BodyCuller, without being sorted. Otherwise bodies
+ * projecting small enough may be handed to an Impostors batch instead of drawn. The bodies' state
+ * is simulated by the core library and passed in when submitting.
+ * Given an upload service, meshes are streamed through it rather than uploaded at once, and the
+ * group is not drawn until they are in place, so that replacing them never stalls a frame.
  */
-class Planet {
+class Planet : public Drawable {
 public:
-	/** Enumerated texture types. */
-	enum TERRAIN_TYPE {
-		ROCKY, GASEOUS, EARTH_LIKE
-	};
-
 	// Constructors.
 	/**
-	 * Creates a unit sphere centred at the origin.
+	 * Creates a renderer without meshes. Set the meshes before submitting.
+	 *
+	 * @param assets Asset registry sharing the program.
+	 * @param compactVertices True to upload meshes in the compact vertex layout.
+	 * @param uploads Upload service streaming the meshes, or nullptr to upload them at once. Must
+	 *                outlive the renderer, and complete the uploads it holds for it before the
+	 *                renderer is destroyed.
 	 */
-	Planet();
+	explicit Planet(AssetRegistry& assets, bool compactVertices = false,
+	                UploadService *uploads = nullptr);
 
 	/**
 	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
@@ -46,247 +75,165 @@ public:
 	 */
 	Planet& operator=(const Planet& other) = delete;
 
-	// Destructors.
-	/**
-	 * Destroys the vertex array object, vertex buffer object, and element buffer object.
-	 */
-	~Planet();
-
-	// Accessor functions.
-	/**
-	 * Returns the planet's angular velocity.
-	 *
-	 * @return Planet's angular velocity.
-	 */
-	glm::vec3 angularVelocity() const;
-
-	/**
-	 * Returns the model matrix of the planet.
-	 *
-	 * @return Planet's model matrix.
-	 */
-	glm::mat4 modelMatrix() const;
-
-	/**
-	 * Returns the planet's orbital angular velocity.
-	 *
-	 * @return Planet's orbital angular velocity.
-	 */
-	glm::vec3 orbitalAngularVelocity() const;
-
 	/**
-	 * Returns the planet's position.
-	 *
-	 * @return Planet's position.
-	 */
-	glm::vec3 position() const;
-
-	/**
-     * Returns the planet's size.
-     *
-     * @return Planet's size.
-     */
-	float size() const;
-
-	// Planet modifier functions.
-	/**
-	 * Rotates the planet.
-	 *
-	 * @param angle Angle to rotate by, in radians.
-	 * @param rotationAxis Axis to rotate around.
-	 */
-	void rotate(float angle, const glm::vec3& rotationAxis);
-
-	/**
-	 * Rotates the planet.
-	 *
-	 * @param angle Angle to rotate by, in radians.
-	 * @param nx x component of rotation axis.
-	 * @param ny y component of rotation axis.
-	 * @param nz z component of rotation axis.
-	 */
-	void rotate(float angle, float nx, float ny, float nz);
-
-	/**
-	 * Rotates the planet around the origin.
-	 *
-	 * @param angle Angle to rotate by, in radians.
-	 * @param rotationAxis Axis to rotate around.
-	 */
-	void rotateAroundOrigin(float angle, const glm::vec3& rotationAxis);
-
-	/**
-	 * Rotates the planet around the origin.
-	 *
-	 * @param angle Angle to rotate by, in radians.
-	 * @param nx x component of rotation axis.
-	 * @param ny y component of rotation axis.
-	 * @param nz z component of rotation axis.
+	 * Move constructor, taking the objects of another planet and leaving it empty. Uploads still
+	 * pending are counted for the new planet. A renderer must not move between submitting a frame
+	 * and executing its draws, as the render queue refers to it.
 	 */
-	void rotateAroundOrigin(float angle, float nx, float ny, float nz);
+	Planet(Planet&&) noexcept = default;
 
 	/**
-	 * Scales the planet uniformly.
-	 *
-	 * @param scaleFactor Scale factor.
+	 * Move assignment operator, deleting the objects of the planet and taking those of another.
 	 */
-	void scale(float scaleFactor);
+	Planet& operator=(Planet&&) noexcept = default;
 
+	// Accessor functions.
 	/**
-	 * Sets the planet's angular velocity.
+	 * Returns the size of the uploaded vertex and index data.
 	 *
-	 * @param angularVelocity Planet's new angular velocity.
+	 * @return Size of the mesh data in bytes.
 	 */
-	void setAngularVelocity(const glm::vec3& angularVelocity);
+	std::size_t meshBytes() const;
 
+	// OpenGL modifier functions.
 	/**
-	 * Sets the planet's angular velocity.
+	 * Uploads the generated meshes of the bodies, replacing any previous ones. Meshes are drawn with
+	 * the bodies of the same index.
 	 *
-	 * @param angularVelocity_x x component of planet's new angular velocity.
-	 * @param angularVelocity_y y component of planet's new angular velocity.
-	 * @param angularVelocity_z z component of planet's new angular velocity.
+	 * @param meshes Meshes to upload.
 	 */
-	void setAngularVelocity(float angularVelocity_x, float angularVelocity_y,
-	                        float angularVelocity_z);
+	void setMeshes(const std::vector<BodyMesh>& meshes);
 
 	/**
-	 * Sets the planet's orbital angular velocity about the world's origin.
+	 * Uploads meshes shared between bodies, replacing any previous ones.
 	 *
-	 * @param orbitalAngularVelocity Planet's new orbital angular velocity.
+	 * @param meshes Meshes to upload.
+	 * @param bodyMeshes Index of each body's mesh.
 	 */
-	void setOrbitalAngularVelocity(const glm::vec3& orbitalAngularVelocity);
+	void setMeshes(const std::vector<BodyMesh>& meshes,
+	               const std::vector<std::uint32_t>& bodyMeshes);
 
 	/**
-	 * Sets the planet's orbital angular velocity about the world's origin.
+	 * Culls and draws the bodies on the GPU from now on instead of culling and sorting them on the
+	 * CPU. Must be called after the meshes are set, and only if BodyCuller::supported().
 	 *
-	 * @param orbitalAV_x x component of planet's new orbital angular velocity.
-	 * @param orbitalAV_y y component of planet's new orbital angular velocity.
-	 * @param orbitalAV_z z component of planet's new orbital angular velocity.
+	 * @param depthPyramid Depth pyramid of the previous frame to cull occluded bodies against, or
+	 *                     null to only cull against the viewing frustum. Must outlive the renderer.
 	 */
-	void setOrbitalAngularVelocity(float orbitalAV_x, float orbitalAV_y, float orbitalAV_z);
+	void enableGpuCulling(const DepthPyramid *depthPyramid);
 
 	/**
-	 * Translates the planet in space.
+	 * Hands the bodies that project small enough to an impostor batch instead of drawing their
+	 * meshes. Unused when culling on the GPU.
 	 *
-	 * @param displacement Cube displacement.
+	 * @param impostors Impostor batch, or null to always draw meshes. Must outlive the renderer.
 	 */
-	void translate(const glm::vec3& displacement);
+	void setImpostors(Impostors *impostors);
 
 	/**
-	 * Translates the planet in space.
+	 * Submits the visible bodies to a render queue as a single draw item. The bodies must stay alive
+	 * until the queue is executed.
 	 *
-	 * @param x Displacement in x direction.
-	 * @param y Displacement in y direction.
-	 * @param z Displacement in z direction.
-	 */
-	void translate(GLfloat x, GLfloat y, GLfloat z);
-
-	/**
-	 * Update's the planet's state based on its state of motion.
+	 * @param queue Render queue of the frame.
+	 * @param bodies Simulation state of the bodies.
+	 * @param camera Camera block of the frame.
+	 * @param occlusionBuffer Occlusion buffer of the frame to skip hidden bodies with, or null.
+	 *                        Unused when culling on the GPU.
+	 * @param timerPass GPU timer pass the bodies are timed in.
 	 */
-	void updateState();
+	void submit(RenderQueue& queue, const std::vector<Body>& bodies, const CameraBlock& camera,
+	            const OcclusionBuffer *occlusionBuffer, GpuTimer::Pass timerPass) const;
 
-	// OpenGL modifier functions.
 	/**
-	 * Renders the planet.
+	 * Renders the bodies visible in the last submission.
 	 *
-	 * @param camera Camera object used to render the planet.
-	 */
-	void draw(const Camera& camera) const;
-
-	bool planetCollision(const Camera& camera);
-
-	/**
-	 * Changes the planet texture based on an enumerated type.
-	 * Then updates the VBO
-	 */
-	void setPlanetTextureType(TERRAIN_TYPE terrain);
-
-	/**
-	 * Changes the planet texture to rocky.
-	 * Color VBO must be updated immediately after.
-	 */
-	void setRockyTexture();
-
-	/**
-	 * Changes the planet texture to gaseous.
-	 * Color VBO must be updated immediately after.
-	 */
-	void setGaseousTexture();
-
-	/**
-	 * Changes the planet texture to earth like.
-	 * Color VBO must be updated immediately after.
+	 * @param index Unused; the bodies are submitted as a single item.
 	 */
-	void setEarthLikeTexture();
+	void drawItem(std::uint32_t index) const override;
 
-	/**
-	 * Generates the texture of the planet based on input parameters
-	 * Color VBO must be updated immediately after.
-	 */
-	void        generateTexture(glm::vec3 brightColor, glm::vec3 darkColor, double xPeriod,
-	                            double yPeriod,
-	                            double turbPower, double trubSize);
-
-	/**
-	 * Cheap hack turn rockyness off for gaseous planets.
-	 */
-	static bool makeRocky;
+private:
+	/** Range of one mesh in the shared buffers. */
+	struct MeshRange {
+		/** Index of the mesh's first index in the element buffer. */
+		GLuint firstIndex;
+		/** Number of indices of the mesh. */
+		GLuint nIndices;
+		/** Index of the mesh's first vertex in the vertex buffers. */
+		GLint  baseVertex;
+	};
 
-protected:
 	// Data members.
 	/** Shader program. */
-	Program mProgram;
-	/** Reference ID of vertex array buffer. */
-	GLuint  mVAO;
-	/** Reference ID of vertex buffer object. */
-	GLuint  mVBO;
-	/** Reference ID of vertex buffer object. */
-	GLuint  mColorVBO;
-	/** Reference ID of element buffer object. */
-	GLuint  mEBO;
-
-	/** Number of vertices in the planet's mesh data. */
-	unsigned int mNVertices;
-	/** Number of indices in the planet's element buffer. */
-	unsigned int mNIndices;
-	/** Number of colors in the planet's array buffer. */
-	unsigned int mNColors;
-
-	/** Color of each vertex in the sphere */
-	std::vector<GLfloat> mVertexColors;
-
-	/** Scale matrix. */
-	glm::mat4 mScale;
-	/** Rotation matrix. */
-	glm::mat4 mRotation;
-	/** Translation matrix. */
-	glm::mat4 mTranslation;
-
-	/** Planet's angular velocity about its own centre. */
-	glm::vec3 mAngularVelocity;
-	/** Planet's orbital angular velocity about the centre of the world. */
-	glm::vec3 mOrbitalAngularVelocity;
-	/** Time in seconds since last state update. */
-	double    mTimeLastStateUpdate;
-
-	// Functions
-	/** Update buffers related to the planet */
-	void updateBuffers();
+	ProgramHandle          mProgram;
+	/** Vertex array object. */
+	GlVertexArray          mVAO;
+	/** Vertex buffer object. */
+	GlBuffer               mVBO;
+	/** Colour vertex buffer object. */
+	GlBuffer               mColorVBO;
+	/** Element buffer object. */
+	GlBuffer               mEBO;
+	/** True iff meshes are uploaded in the compact vertex layout. */
+	bool                   mCompactVertices;
+	/** Type of the indices in the element buffer object. */
+	GLenum                 mIndexType;
+	/** Size of one index in bytes. */
+	std::size_t            mIndexSize;
+	/** Size of the uploaded vertex and index data in bytes. */
+	std::size_t            mMeshBytes;
+	/** Ranges of the meshes. */
+	std::vector<MeshRange>     mMeshes;
+	/** Index of each body's mesh. */
+	std::vector<std::uint32_t> mBodyMeshes;
+	/** Mean vertex colour of each mesh, for impostors. */
+	std::vector<glm::vec3>     mMeshColours;
+	/** Dequantization matrix of each mesh in the compact layout, or empty in the float layout. */
+	std::vector<glm::mat4>     mMeshMatrices;
+	/** True iff the group is drawn with a single multi-draw indirect call. */
+	bool                       mMultiDrawIndirect;
+	/** Upload service streaming the meshes, or null. */
+	UploadService             *mUploads;
+	/** Number of mesh buffers requested from the upload service and not yet filled. */
+	std::shared_ptr<std::size_t> mPendingUploads;
+
+	/** Per-frame model matrices of the visible bodies. */
+	std::unique_ptr<StreamBuffer> mModels;
+	/** Per-frame indirect draw commands of the visible bodies, if multi-draw indirect is used. */
+	std::unique_ptr<StreamBuffer> mCommands;
+	/** GPU culler of the bodies, or null if they are culled on the CPU. */
+	std::unique_ptr<BodyCuller>   mCuller;
+	/** Depth pyramid the GPU culler tests against, or null. */
+	const DepthPyramid           *mDepthPyramid;
+	/** Impostor batch distant bodies are handed to, or null. */
+	Impostors                    *mImpostors;
+
+	/** Bodies submitted for the current frame. */
+	mutable const std::vector<Body> *mBodies;
+	/** Camera block of the current frame, for GPU culling. */
+	mutable const CameraBlock       *mCamera;
+	/** Indices of the bodies visible in the current frame, keyed and sorted by depth. */
+	mutable std::vector<SortEntry>   mVisible;
+	/** Scratch buffer for sorting the visible bodies. */
+	mutable std::vector<SortEntry>   mScratch;
+
+	// Helper functions.
+	/**
+	 * Points the per-instance model matrix attribute at an offset into a buffer of model matrices.
+	 *
+	 * @param buffer Reference ID of the buffer.
+	 * @param offset Offset of the first matrix in bytes.
+	 */
+	void setModelAttribute(GLuint buffer, GLintptr offset) const;
+
+	/**
+	 * Fills a mesh buffer, bound to its target, with data, at once or through the upload service.
+	 *
+	 * @param target Target the buffer is bound to.
+	 * @param buffer Reference ID of the buffer.
+	 * @param data Data to fill the buffer with.
+	 */
+	template <typename T>
+	void uploadBuffer(GLenum target, GLuint buffer, std::vector<T> data);
 };
 
-float smoothNoise(float x, float y,
-                  const std::vector<std::vector<GLfloat>>& noise);
-
-std::vector<std::vector<GLfloat>> generateNoiseMatrix();
-
-double turbulence(double x, double y, double size,
-                  const std::vector<std::vector<GLfloat>>& noise);
-
-
-glm::vec3 getBrightColor();
-
-glm::vec3 getDarkColor();
-
 #endif
-
@@ -5,26 +5,27 @@
  */
 #include "program.hpp"
 
+#include "camera_uniforms.hpp"
+#include "gl_calls.hpp"
+
 // Constructors.
-Program::Program() :
-		mProgramID(0) { }
+Program::Program() { }
 
 Program::Program(const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
-	// Read vertex shader source code and fragment shader source code.
-	const std::string vertexShaderSourceCode   = utility::readFile(vertexShaderPath);
-	const std::string fragmentShaderSourceCode = utility::readFile(fragmentShaderPath);
+	PROFILE_SCOPE("Program::Program");
+
+	// Map vertex shader source code and fragment shader source code.
+	const utility::MappedFile vertexShaderSourceCode(vertexShaderPath);
+	const utility::MappedFile fragmentShaderSourceCode(fragmentShaderPath);
 
 	// Create vertex shader and fragment shader objects.
 	GLuint vertexShaderID   = glCreateShader(GL_VERTEX_SHADER);
 	GLuint fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
 
-	// Attach shader source code to their respective shader objects and compile.
-	// Note that source code must be converted into a C string so that the address of a C string can
-	// be passed to glShaderSource.
-	const char *vertexShaderSourceCode_cstr   = vertexShaderSourceCode.c_str();
-	const char *fragmentShaderSourceCode_cstr = fragmentShaderSourceCode.c_str();
-	glShaderSource(vertexShaderID, 1, &vertexShaderSourceCode_cstr, nullptr);
-	glShaderSource(fragmentShaderID, 1, &fragmentShaderSourceCode_cstr, nullptr);
+	// Attach shader source code to their respective shader objects and compile. The mapped source
+	// code is not null-terminated, so its length is passed along with it.
+	attachSource(vertexShaderID, vertexShaderSourceCode);
+	attachSource(fragmentShaderID, fragmentShaderSourceCode);
 	glCompileShader(vertexShaderID);
 	glCompileShader(fragmentShaderID);
 
@@ -39,10 +40,10 @@ Program::Program(const std::string& vertexShaderPath, const std::string& fragmen
 	}
 
 	// Link vertex shader and fragment shader objects.
-	mProgramID = glCreateProgram();
-	glAttachShader(mProgramID, vertexShaderID);
-	glAttachShader(mProgramID, fragmentShaderID);
-	glLinkProgram(mProgramID);
+	mProgramID = GlProgram::generate();
+	glAttachShader(mProgramID.id(), vertexShaderID);
+	glAttachShader(mProgramID.id(), fragmentShaderID);
+	glLinkProgram(mProgramID.id());
 
 	// Delete shader objects.
 	glDeleteShader(vertexShaderID);
@@ -50,21 +51,53 @@ Program::Program(const std::string& vertexShaderPath, const std::string& fragmen
 
 	// Throw exception if program did not link correctly.
 	GLint success;
-	glGetProgramiv(mProgramID, GL_LINK_STATUS, &success);
+	glGetProgramiv(mProgramID.id(), GL_LINK_STATUS, &success);
 	if (not success) {
 		std::string exceptionMessage = "Shader program failed to link.";
 		throw std::runtime_error(exceptionMessage);
 	}
+
+	// Bind the program's camera block, if it has one, to the shared camera uniform buffer.
+	GLuint cameraBlockIndex = glGetUniformBlockIndex(mProgramID.id(), CameraUniforms::BLOCK_NAME);
+	if (cameraBlockIndex != GL_INVALID_INDEX) {
+		glUniformBlockBinding(mProgramID.id(), cameraBlockIndex, CameraUniforms::BINDING);
+	}
 }
 
-// Destructor.
-Program::~Program() {
-	glDeleteProgram(mProgramID);
+Program::Program(const std::string& computeShaderPath) {
+	PROFILE_SCOPE("Program::Program (compute)");
+
+	// Map, attach and compile compute shader source code.
+	const utility::MappedFile computeShaderSourceCode(computeShaderPath);
+	GLuint computeShaderID = glCreateShader(GL_COMPUTE_SHADER);
+	attachSource(computeShaderID, computeShaderSourceCode);
+	glCompileShader(computeShaderID);
+
+	// Throw exception if compilation was unsuccessful.
+	if (not compilationSuccessful(computeShaderID)) {
+		glDeleteShader(computeShaderID);
+		std::string exceptionMessage = "Compute shader failed to compile.";
+		throw std::runtime_error(exceptionMessage);
+	}
+
+	// Link compute shader object and delete it.
+	mProgramID = GlProgram::generate();
+	glAttachShader(mProgramID.id(), computeShaderID);
+	glLinkProgram(mProgramID.id());
+	glDeleteShader(computeShaderID);
+
+	// Throw exception if program did not link correctly.
+	GLint success;
+	glGetProgramiv(mProgramID.id(), GL_LINK_STATUS, &success);
+	if (not success) {
+		std::string exceptionMessage = "Shader program failed to link.";
+		throw std::runtime_error(exceptionMessage);
+	}
 }
 
 // Accessor functions.
 GLint Program::getUniformLocation(const std::string& uniformName) const {
-	GLint uniformLocation = glGetUniformLocation(mProgramID, uniformName.c_str());
+	GLint uniformLocation = glGetUniformLocation(mProgramID.id(), uniformName.c_str());
 	if (uniformLocation == -1) {
 		std::string errorMessage = "Uniform with name \"" + uniformName + "\" does not exist.";
 		throw std::runtime_error(errorMessage);
@@ -72,13 +105,17 @@ GLint Program::getUniformLocation(const std::string& uniformName) const {
 	return uniformLocation;
 }
 
+GLuint Program::id() const {
+	return mProgramID.id();
+}
+
 // OpenGL modifiers.
 void Program::enable() const {
-	glUseProgram(mProgramID);
+	gl::useProgram(mProgramID.id());
 }
 
 void Program::disable() const {
-	glUseProgram(0);
+	gl::useProgram(0);
 }
 
 // Static helper functions.
@@ -87,3 +124,9 @@ bool Program::compilationSuccessful(GLuint shaderID) {
 	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success);
 	return success != 0;
 }
+
+void Program::attachSource(GLuint shaderID, const utility::MappedFile& sourceCode) {
+	const GLchar *source = sourceCode.data();
+	GLint         length = static_cast<GLint>(sourceCode.size());
+	glShaderSource(shaderID, 1, &source, &length);
+}
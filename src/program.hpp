@@ -6,7 +6,9 @@
 #ifndef SPACE_COWBOY_PROGRAM_HPP
 #define SPACE_COWBOY_PROGRAM_HPP
 
-#include "utility.hpp"
+#include "core/profiler.hpp"
+#include "core/utility.hpp"
+#include "gl_object.hpp"
 
 #include <stdexcept>
 #include <string>
@@ -33,6 +35,15 @@ public:
 	 */
 	Program(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
 
+	/**
+	 * Creates a compute shader program from the compute shader whose source code is contained in the
+	 * provided file path. Requires OpenGL 4.3.
+	 *
+	 * @param computeShaderPath Path to compute shader source code.
+	 * @throws std::runtime_error if Program cannot be constructed.
+	 */
+	explicit Program(const std::string& computeShaderPath);
+
 	/**
 	 * Disallow copy constructor. OpenGL does not provide any mechanism for shallow copying of
 	 * shader programs.
@@ -45,11 +56,15 @@ public:
 	 */
 	void operator=(const Program&) = delete;
 
-	// Destructor.
 	/**
-	 * Destroys the shader program.
+	 * Move constructor, taking the program object of another program and leaving it null.
 	 */
-	~Program();
+	Program(Program&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the program object and taking that of another program.
+	 */
+	Program& operator=(Program&&) noexcept = default;
 
 	// Accessor functions.
 	/**
@@ -61,6 +76,13 @@ public:
 	 */
 	GLint getUniformLocation(const std::string& uniformName) const;
 
+	/**
+	 * Returns the reference ID of the program.
+	 *
+	 * @return Reference ID of the program.
+	 */
+	GLuint id() const;
+
 	// OpenGL modifiers.
 	/**
 	 * Binds shader program to current OpenGL context.
@@ -75,8 +97,8 @@ public:
 
 private:
 	// Data members.
-	/** Reference ID for the program. */
-	GLuint mProgramID;
+	/** Program object. */
+	GlProgram mProgramID;
 
 	// Static helper functions.
 	/**
@@ -86,6 +108,14 @@ private:
 	 * @return True iff shader object's source code compiled correctly.
 	 */
 	static bool compilationSuccessful(GLuint shaderID);
+
+	/**
+	 * Attaches mapped source code to a shader object.
+	 *
+	 * @param shaderID Reference ID of shader object.
+	 * @param sourceCode Source code, which need not be null-terminated.
+	 */
+	static void attachSource(GLuint shaderID, const utility::MappedFile& sourceCode);
 };
 
 #endif
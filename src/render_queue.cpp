@@ -0,0 +1,103 @@
+/**
+ * @file render_queue.cpp
+ *
+ * Implementation file for the RenderQueue class.
+ */
+#include "render_queue.hpp"
+
+#include "gl_calls.hpp"
+#include "core/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Sort key layout, from the most significant bits down.
+/** Position of the 2-bit pass. */
+constexpr unsigned int PASS_SHIFT       = 62;
+/** Position of the 12-bit shader program. */
+constexpr unsigned int PROGRAM_SHIFT    = 50;
+/** Position of the 16-bit texture. */
+constexpr unsigned int TEXTURE_SHIFT    = 34;
+/** Position of the front face bit, set for clockwise winding. */
+constexpr unsigned int FRONT_FACE_SHIFT = 33;
+/** Number of bits of the quantized depth, which occupies the least significant bits. */
+constexpr unsigned int DEPTH_BITS       = 24;
+
+/** Mask of the shader program. */
+constexpr std::uint64_t PROGRAM_MASK = (std::uint64_t(1) << 12) - 1;
+/** Mask of the texture. */
+constexpr std::uint64_t TEXTURE_MASK = (std::uint64_t(1) << 16) - 1;
+/** Largest quantized depth. */
+constexpr std::uint64_t MAX_DEPTH    = (std::uint64_t(1) << DEPTH_BITS) - 1;
+}
+
+// Constructors.
+RenderQueue::RenderQueue(float nearDepth, float farDepth) :
+		mLogNearDepth(std::log(nearDepth)),
+		mDepthScale(MAX_DEPTH / (std::log(farDepth) - std::log(nearDepth))) {
+}
+
+// Accessor functions.
+std::size_t RenderQueue::size() const {
+	return mItems.size();
+}
+
+std::uint64_t RenderQueue::key(Pass pass, GLuint program, GLuint texture, GLenum frontFace,
+                               float depth) const {
+	// Quantize the depth logarithmically so that nearby objects, which matter most for early depth
+	// rejection, are told apart finely across the whole depth range.
+	float         logDepth       = (std::log(std::max(depth, 1e-6f)) - mLogNearDepth) * mDepthScale;
+	std::uint64_t quantizedDepth = static_cast<std::uint64_t>(
+			std::min(std::max(logDepth, 0.0f), static_cast<float>(MAX_DEPTH)));
+
+	return (static_cast<std::uint64_t>(pass) << PASS_SHIFT) |
+	       ((program & PROGRAM_MASK) << PROGRAM_SHIFT) |
+	       ((texture & TEXTURE_MASK) << TEXTURE_SHIFT) |
+	       (static_cast<std::uint64_t>(frontFace == GL_CW) << FRONT_FACE_SHIFT) |
+	       quantizedDepth;
+}
+
+// Mutator functions.
+void RenderQueue::clear() {
+	mItems.clear();
+	mOrder.clear();
+}
+
+void RenderQueue::submit(std::uint64_t key, const Drawable& drawable, std::uint32_t index,
+                         GpuTimer::Pass timerPass) {
+	mOrder.push_back({ key, static_cast<std::uint32_t>(mItems.size()) });
+	mItems.push_back({ &drawable, index, timerPass });
+}
+
+void RenderQueue::sort() {
+	PROFILE_SCOPE("RenderQueue::sort");
+	radixSort(mOrder, mScratch);
+}
+
+// OpenGL modifier functions.
+void RenderQueue::execute(GpuTimer& gpuTimer) const {
+	PROFILE_SCOPE("RenderQueue::execute");
+
+	glEnable(GL_CULL_FACE);
+
+	// N_PASSES marks that no timer pass is running.
+	GpuTimer::Pass timerPass = GpuTimer::N_PASSES;
+	for (const SortEntry& entry : mOrder) {
+		const DrawItem& item = mItems[entry.value];
+
+		if (item.timerPass != timerPass) {
+			if (timerPass != GpuTimer::N_PASSES) {
+				gpuTimer.end(timerPass);
+			}
+			timerPass = item.timerPass;
+			gpuTimer.begin(timerPass);
+		}
+
+		gl::frontFace(((entry.key >> FRONT_FACE_SHIFT) & 1) != 0 ? GL_CW : GL_CCW);
+		item.drawable->drawItem(item.index);
+	}
+	if (timerPass != GpuTimer::N_PASSES) {
+		gpuTimer.end(timerPass);
+	}
+}
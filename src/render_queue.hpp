@@ -0,0 +1,140 @@
+/**
+ * @file render_queue.hpp
+ *
+ * Interface file for the RenderQueue class and the Drawable interface of the objects it draws.
+ */
+#ifndef SPACE_COWBOY_RENDER_QUEUE_HPP
+#define SPACE_COWBOY_RENDER_QUEUE_HPP
+
+#include "core/radix_sort.hpp"
+#include "gpu_timer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <GL/glew.h>
+
+/**
+ * Object that submits draw items to a render queue and draws them when the queue executes.
+ */
+class Drawable {
+public:
+	// Destructors.
+	/**
+	 * Destroys the drawable.
+	 */
+	virtual ~Drawable() = default;
+
+	// OpenGL modifier functions.
+	/**
+	 * Draws one of the items the object submitted.
+	 *
+	 * @param index Index the item was submitted with.
+	 */
+	virtual void drawItem(std::uint32_t index) const = 0;
+};
+
+/**
+ * Collects the draw items of a frame, sorts them by a 64-bit key and draws them in key order. The key
+ * holds, from the most significant bits down, the pass, shader program, texture, front face winding
+ * and quantized view depth, so that sorting groups items sharing state and orders the opaque items
+ * of each group front to back for early depth rejection.
+ */
+class RenderQueue {
+public:
+	/** Passes, drawn in this order. */
+	enum Pass {
+		/** Opaque geometry. */
+		OPAQUE,
+		/** Skybox, drawn behind the opaque geometry at the far plane with depth testing. */
+		SKYBOX
+	};
+
+	// Constructors.
+	/**
+	 * Creates an empty queue quantizing view depths between the given distances.
+	 *
+	 * @param nearDepth Smallest view depth told apart, typically the near clipping plane.
+	 * @param farDepth Largest view depth told apart, typically the far clipping plane.
+	 */
+	RenderQueue(float nearDepth, float farDepth);
+
+	// Accessor functions.
+	/**
+	 * Returns the number of items in the queue.
+	 *
+	 * @return Number of items.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * Returns the sort key of an item.
+	 *
+	 * @param pass Pass of the item.
+	 * @param program Reference ID of the item's shader program.
+	 * @param texture Reference ID of the item's texture, or 0 if it is untextured.
+	 * @param frontFace Front face winding of the item's triangles, GL_CW or GL_CCW.
+	 * @param depth Distance of the item from the camera along the view direction.
+	 * @return Sort key.
+	 */
+	std::uint64_t key(Pass pass, GLuint program, GLuint texture, GLenum frontFace,
+	                  float depth) const;
+
+	// Mutator functions.
+	/**
+	 * Removes all items. Should be called once per frame before submitting.
+	 */
+	void clear();
+
+	/**
+	 * Adds a draw item.
+	 *
+	 * @param key Sort key of the item, from key().
+	 * @param drawable Object drawing the item. Must outlive the execution of the queue.
+	 * @param index Index passed back to the drawable.
+	 * @param timerPass GPU timer pass the item is timed in.
+	 */
+	void submit(std::uint64_t key, const Drawable& drawable, std::uint32_t index,
+	            GpuTimer::Pass timerPass);
+
+	/**
+	 * Sorts the items by key.
+	 */
+	void sort();
+
+	// OpenGL modifier functions.
+	/**
+	 * Draws the items in sorted order, setting the front face winding from each item's key. Each run
+	 * of items in the same GPU timer pass is timed; items of one timer pass are expected to share a
+	 * program so that they form a single run.
+	 *
+	 * @param gpuTimer GPU pass timer.
+	 */
+	void execute(GpuTimer& gpuTimer) const;
+
+private:
+	/** Item submitted for drawing. */
+	struct DrawItem {
+		/** Object drawing the item. */
+		const Drawable *drawable;
+		/** Index passed back to the drawable. */
+		std::uint32_t  index;
+		/** GPU timer pass the item is timed in. */
+		GpuTimer::Pass timerPass;
+	};
+
+	// Data members.
+	/** Logarithm of the smallest view depth told apart. */
+	float mLogNearDepth;
+	/** Scale from logarithmic view depth to quantized depth. */
+	float mDepthScale;
+
+	/** Items in submission order. */
+	std::vector<DrawItem>  mItems;
+	/** Sort keys of the items and their indices in mItems, in draw order once sorted. */
+	std::vector<SortEntry> mOrder;
+	/** Scratch buffer of the sort. */
+	std::vector<SortEntry> mScratch;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @file render_stats.cpp
+ *
+ * Defines per-frame render statistics in the "renderStats" namespace.
+ */
+#include "render_stats.hpp"
+
+#include <sstream>
+
+namespace renderStats {
+namespace {
+/** Counters of the frame in progress. */
+FrameStats sCurrent;
+/** Counters of the last completed frame. */
+FrameStats sPrevious;
+}
+
+FrameStats& current() {
+	return sCurrent;
+}
+
+const FrameStats& previous() {
+	return sPrevious;
+}
+
+void beginFrame() {
+	sPrevious = sCurrent;
+	sCurrent  = FrameStats();
+}
+
+std::string summary(const FrameStats& stats) {
+	std::ostringstream out;
+	out << "Draws " << stats.drawCalls
+	    << " | Dispatches " << stats.dispatches
+	    << " | Programs " << stats.programSwitches
+	    << " | VAOs " << stats.vaoBinds
+	    << " | Textures " << stats.textureBinds
+	    << " | Buffers " << stats.bufferBinds
+	    << " | Skipped " << stats.skippedCalls
+	    << " | Occluded " << stats.occludedObjects
+	    << " | Uniforms " << stats.uniformUploads
+	    << " | Triangles " << stats.triangles
+	    << " | Uploaded " << stats.bytesUploaded << " B";
+	return out.str();
+}
+}
@@ -0,0 +1,69 @@
+/**
+ * @file render_stats.hpp
+ *
+ * Declares per-frame render statistics in the "renderStats" namespace. The counters are incremented
+ * by the OpenGL call wrappers in gl_calls.hpp, which every draw function goes through.
+ */
+#ifndef SPACE_COWBOY_RENDER_STATS_HPP
+#define SPACE_COWBOY_RENDER_STATS_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace renderStats {
+/** Counters of the OpenGL work submitted during one frame. */
+struct FrameStats {
+	/** Number of draw calls. */
+	unsigned int  drawCalls       = 0;
+	/** Number of compute dispatches. */
+	unsigned int  dispatches      = 0;
+	/** Number of glUseProgram calls. */
+	unsigned int  programSwitches = 0;
+	/** Number of glBindVertexArray calls. */
+	unsigned int  vaoBinds        = 0;
+	/** Number of glBindTexture calls. */
+	unsigned int  textureBinds    = 0;
+	/** Number of glBindBuffer and glBindBufferBase calls. */
+	unsigned int  bufferBinds     = 0;
+	/** Number of binds and program switches skipped because the state already matched. */
+	unsigned int  skippedCalls    = 0;
+	/** Number of objects skipped because the occlusion buffer showed them hidden. */
+	unsigned int  occludedObjects = 0;
+	/** Number of glUniform* calls. */
+	unsigned int  uniformUploads  = 0;
+	/** Number of triangles submitted by draw calls. */
+	std::uint64_t triangles       = 0;
+	/** Number of bytes uploaded into buffer objects. */
+	std::uint64_t bytesUploaded   = 0;
+};
+
+/**
+ * Returns the counters of the frame in progress.
+ *
+ * @return Counters of the current frame.
+ */
+FrameStats& current();
+
+/**
+ * Returns the counters of the last completed frame.
+ *
+ * @return Counters of the previous frame.
+ */
+const FrameStats& previous();
+
+/**
+ * Completes the current frame and resets the counters. Should be called once per frame, before any
+ * drawing.
+ */
+void beginFrame();
+
+/**
+ * Returns a one-line summary of the counters, suitable for a window title.
+ *
+ * @param stats Counters to summarize.
+ * @return Summary of the counters.
+ */
+std::string summary(const FrameStats& stats);
+}
+
+#endif
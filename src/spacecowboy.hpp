@@ -6,6 +6,8 @@
 #ifndef SPACE_COWBOY_SPACECOWBOY_HPP
 #define SPACE_COWBOY_SPACECOWBOY_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -13,48 +15,55 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <SOIL/SOIL.h>
 
-#include "objloader.hpp"
-#include "camera.hpp"
+#include "asset_registry.hpp"
+#include "core/asset_pack.hpp"
+#include "core/objloader.hpp"
+#include "core/camera.hpp"
+#include "core/profiler.hpp"
+#include "core/ship.hpp"
+#include "model_mesh.hpp"
 #include "program.hpp"
 #include "palette.hpp"
-#include "planet.hpp"
+#include "render_queue.hpp"
+#include "texture_loader.hpp"
 
 /**
-* Represents a spacecowboy.
+* Renders the spacecowboy. The spacecowboy's state is simulated by the core library and passed in
+* when submitting.
 */
-class Spacecowboy {
+class Spacecowboy : public Drawable {
 public:
 	// Constructors.
 	/**
-	 * Creates a stationary spacecowboy.
-	 */
-	Spacecowboy();
-
-	// Accessor functions.
-	/**
-	 * Returns the position of the spacecowboy.
+	 * Loads the spacecowboy model and texture.
 	 *
-	 * @return Position of spacecowboy.
+	 * @param assets Asset registry sharing the program, model and texture.
+	 * @param textures Texture loader decoding the texture.
+	 * @param compactVertices True to upload the model in the compact vertex layout.
+	 * @param pack Asset pack to load the cooked model from, or nullptr to load its source file.
 	 */
-	glm::vec3 position() const;
+	Spacecowboy(AssetRegistry& assets, TextureLoader& textures, bool compactVertices = false,
+	            const AssetPack *pack = nullptr);
 
+	// Accessor functions.
 	/**
-	 * Returns the velocity of the spacecowboy.
+	 * Returns the size of the uploaded vertex and index data.
 	 *
-	 * @return Velocity of spacecowboy.
+	 * @return Size of the mesh data in bytes.
 	 */
-	glm::vec3 velocity() const;
+	std::size_t meshBytes() const;
 
 	// Mutator functions.
 	/**
-	 * Sets the velocity of the spacecowboy.
+	 * Starts decoding the spacecowboy's texture, so that it decodes while other objects are created.
 	 *
-	 * @param velocity New spacecowboy velocity.
+	 * @param textures Texture loader decoding the texture.
 	 */
-	void setVelocity(const glm::vec3& velocity);
+	static void requestTextures(TextureLoader& textures);
 
+	// OpenGL modifier functions.
 	/**
-	 * Sets the colour of the Planet in RGB colour space.
+	 * Sets the colour of the spacecowboy in RGB colour space.
 	 *
 	 * @param r Red value. Should be between 0.0 and 1.0.
 	 * @param g Green value. Should be between 0.0 and 1.0.
@@ -63,7 +72,7 @@ public:
 	void setColour(GLfloat r, GLfloat g, GLfloat b) const;
 
 	/**
-	 * Sets the colour of the Planet in RGB colour space.
+	 * Sets the colour of the spacecowboy in RGB colour space.
 	 *
 	 * @param colour RGB values.
 	 */
@@ -77,84 +86,36 @@ public:
 	void setOpacity(GLfloat alpha) const;
 
 	/**
-	 * Translates the spacecowboy in space.
-	 *
-	 * @param displacement spacecowboy displacement.
-	 */
-	void translate(const glm::vec3& displacement);
-
-	/**
-	 * Sets the spacecowboy's position.
+	 * Submits the spacecowboy to a render queue. The state must stay alive until the queue is executed.
+	 * The level of detail is selected from the spacecowboy's size on the screen.
 	 *
-	 * @param position spacecowboy's new position.
+	 * @param queue Render queue of the frame.
+	 * @param cowboy Simulation state of the spacecowboy.
+	 * @param camera Camera block of the frame.
 	 */
-	void setPosition(const glm::vec3& position);
+	void submit(RenderQueue& queue, const CowboyState& cowboy, const CameraBlock& camera) const;
 
-	/**
-	 * Scales the spacecowboy uniformly.
-	 *
-	 * @param scaleFactor Scale factor.
-	 */
-	void scale(float scaleFactor);
-
-	/**
-	 * Updates the spacecowboy state based on its state of motion.
-	 * Spacecowboy is drawn orbiting around random planet
-	 */
-	void updateState(const Camera& camera, const Planet& planet);
 	/**
 	 * Renders the spacecowboy.
 	 *
-	 * @param camera Camera object used to render the spacecowboy.
+	 * @param index Unused; the spacecowboy submits a single item.
 	 */
-	void draw(const Camera& camera) const;
-
-	/**
-	 * Returns the model matrix of the spacecowboy.
-	 *
-	 * @return spacecowboy's model matrix.
-	 */
-	glm::mat4 modelMatrix() const;
-
-
+	void drawItem(std::uint32_t index) const override;
 
 private:
 	// Data members.
 
 	/** Shader program. */
-	Program mProgram;
-	/** Reference ID of vertex array buffer. */
-	GLuint  mVAO;
-	/** Reference ID of vertex buffer object. */
-	GLuint  mVBO;
-
-	/** Reference ID of vertex uv buffer. */
-	GLuint  mUV_VBO;
-	/**Reference ID of vertex normal buffer*/
-	GLuint mN_VBO;
-
-	/**Reference ID of ship texture*/
-	GLuint spacecowboy_texture;
-
-	/** Number of vertices in the spacecowboy's mesh data. */
-	unsigned int mNVertices;
-	/** Number of indices in the spacecowboy's element buffer. */
-	unsigned int mNIndices;
-
-	/** Scale matrix. */
-	glm::mat4 mScale;
-	/** Rotation matrix. */
-	glm::mat4 mRotation;
-	/** Translation matrix. */
-	glm::mat4 mTranslation;
-
-
-	/** Position of the spacecowboy. */
-	glm::vec3 mPosition;
-	/** Velocity of the spacecowboy. */
-	glm::vec3 mVelocity;
-	/** Time in seconds of last frame. */
-	double    mTimeLastFrame;
+	ProgramHandle mProgram;
+	/** Vertex data of the spacecowboy's model. */
+	MeshHandle    mMesh;
+	/** Spacecowboy texture. */
+	TextureHandle mTexture;
+
+	/** State submitted for the current frame. */
+	mutable const CowboyState *mCowboy;
+	/** Level of detail selected for the current frame. */
+	mutable std::size_t mLevel;
 };
 
 #endif
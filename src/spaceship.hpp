@@ -6,6 +6,8 @@
 #ifndef SPACE_COWBOY_SPACESHIP_HPP
 #define SPACE_COWBOY_SPACESHIP_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -13,131 +15,83 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <SOIL/SOIL.h>
 
-#include "objloader.hpp"
-#include "camera.hpp"
+#include "asset_registry.hpp"
+#include "core/asset_pack.hpp"
+#include "core/objloader.hpp"
+#include "core/camera.hpp"
+#include "core/profiler.hpp"
+#include "core/ship.hpp"
+#include "model_mesh.hpp"
 #include "program.hpp"
 #include "palette.hpp"
+#include "render_queue.hpp"
+#include "texture_loader.hpp"
 
 /**
- * Represents a user-controlled spaceship.
+ * Renders the user-controlled spaceship. The spaceship's state is simulated by the core library and
+ * passed in when submitting.
  */
-class Spaceship {
+class Spaceship : public Drawable {
 public:
 	// Constructors.
 	/**
-	 * Creates a stationary spaceship centred at the origin.
-	 */
-	Spaceship();
-
-	// Accessor functions.
-	/**
-	 * Returns the position of the spaceship.
+	 * Loads the spaceship model and texture.
 	 *
-	 * @return Position of spaceship.
+	 * @param assets Asset registry sharing the program, model and texture.
+	 * @param textures Texture loader decoding the texture.
+	 * @param compactVertices True to upload the model in the compact vertex layout.
+	 * @param pack Asset pack to load the cooked model from, or nullptr to load its source file.
 	 */
-	glm::vec3 position() const;
+	Spaceship(AssetRegistry& assets, TextureLoader& textures, bool compactVertices = false,
+	          const AssetPack *pack = nullptr);
 
+	// Accessor functions.
 	/**
-	 * Returns the velocity of the spaceship.
+	 * Returns the size of the uploaded vertex and index data.
 	 *
-	 * @return Velocity of spaceship.
+	 * @return Size of the mesh data in bytes.
 	 */
-	glm::vec3 velocity() const;
+	std::size_t meshBytes() const;
 
 	// Mutator functions.
 	/**
-	 * Sets the velocity of the spaceship.
-	 *
-	 * @param velocity New spaceship velocity.
-	 */
-	void setVelocity(const glm::vec3& velocity);
-
-	/**
-	 * Translates the spaceship in space.
+	 * Starts decoding the spaceship's texture, so that it decodes while other objects are created.
 	 *
-	 * @param displacement Spaceship displacement.
+	 * @param textures Texture loader decoding the texture.
 	 */
-	void translate(const glm::vec3& displacement);
+	static void requestTextures(TextureLoader& textures);
 
+	// OpenGL modifier functions.
 	/**
-	 * Sets the spaceship's position.
+	 * Submits the spaceship to a render queue. The state must stay alive until the queue is
+	 * executed. The level of detail is selected from the spaceship's size on the screen.
 	 *
-	 * @param position spaceships's new position.
+	 * @param queue Render queue of the frame.
+	 * @param ship Simulation state of the spaceship.
+	 * @param camera Camera block of the frame.
 	 */
-	void setPosition(const glm::vec3& position);
+	void submit(RenderQueue& queue, const ShipState& ship, const CameraBlock& camera) const;
 
-	/**
-	 * Scales the spaceship uniformly.
-	 *
-	 * @param scaleFactor Scale factor.
-	 */
-	void scale(float scaleFactor);
-
-	/**
-	 * Updates the spaceships state based on its state of motion.
-	 */
-	void updateState(const Camera& camera);
 	/**
 	 * Renders the spaceship.
 	 *
-	 * @param camera Camera object used to render the spaceship.
+	 * @param index Unused; the spaceship submits a single item.
 	 */
-	void draw(const Camera& camera) const;
-
-	/**
-	 * Returns the model matrix of the spaceship.
-	 *
-	 * @return Spaceship's model matrix.
-	 */
-	glm::mat4 modelMatrix() const;
-
-	void updateRotations( const Camera &camera);
+	void drawItem(std::uint32_t index) const override;
 
 private:
 	// Data members.
 	/** Shader program. */
-	Program mProgram;
-	/** Reference ID of vertex array buffer. */
-	GLuint  mVAO;
-	/** Reference ID of vertex buffer object. */
-	GLuint  mVBO;
-	/** Reference ID of element buffer object. */
-	GLuint  mEBO;
-
-	/** Reference ID of vertex uv buffer. */
-	GLuint  mUV_VBO;
-
-	GLuint mN_VBO;
-	/**Reference ID of ship texture*/
-	GLuint ship_texture;
-
-	/** Number of vertices in the planet's mesh data. */
-	unsigned int mNVertices;
-	/** Number of indices in the planet's element buffer. */
-	unsigned int mNIndices;
-
-	/** Scale matrix. */
-	glm::mat4 mScale;
-	/** Rotation matrix. */
-	glm::mat4 mRotation;
-	/** Translation matrix. */
-	glm::mat4 mTranslation;
-
-
-	/** Position of the spaceship. */
-	glm::vec3 mPosition;
-	/** Velocity of the spaceship. */
-	glm::vec3 mVelocity;
-	/** Time in seconds of last frame. */
-	double    mTimeLastFrame;
-	float tiltDegree;
-	glm::vec3 mOldCamDir;
-	glm::vec3 mNewCamDir;
-	
-	glm::mat4 mTilt_Rotation;
-	glm::mat4 mY_Rotation;
-	glm::mat4 mXZ_Rotation;
-
+	ProgramHandle mProgram;
+	/** Vertex data of the spaceship's model. */
+	MeshHandle    mMesh;
+	/** Spaceship texture. */
+	TextureHandle mTexture;
+
+	/** State submitted for the current frame. */
+	mutable const ShipState *mShip;
+	/** Level of detail selected for the current frame. */
+	mutable std::size_t mLevel;
 };
 
 #endif
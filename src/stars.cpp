@@ -5,6 +5,11 @@
  */
 #include "stars.hpp"
 
+#include "gl_calls.hpp"
+#include "texture.hpp"
+
+#include <algorithm>
+
 namespace {
 /** Array of file paths to the texture image for each of the skybox's faces in the following order:
  *  right, left, up, down, back, front. */
@@ -25,17 +30,20 @@ constexpr char FRAGMENT_SHADER_PATH[] = "shaders/stars_fragment.shader";
 constexpr std::array<GLfloat, 108> Stars::sVertices;
 
 // Constructors.
-Stars::Stars() :
-		mTextureID(createTexture()),
-		mProgram(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH) {
+Stars::Stars(AssetRegistry& assets, TextureLoader& textures) :
+		mTexture(assets.texture(TEXTURE_FACES.front() + " (cube map)",
+		                        [&textures](std::size_t& bytes) {
+			return createTexture(textures, bytes);
+		})),
+		mProgram(assets.program(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH)) {
 	// Create vertex array buffer and vertex buffer object and bind them to current OpenGL context.
-	glGenVertexArrays(1, &mVAO);
-	glGenBuffers(1, &mVBO);
-	glBindVertexArray(mVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+	mVAO = GlVertexArray::generate();
+	mVBO = GlBuffer::generate();
+	gl::bindVertexArray(mVAO.id());
+	gl::bindBuffer(GL_ARRAY_BUFFER, mVBO.id());
 
 	// Pass vertex data into vertex buffer object.
-	glBufferData(GL_ARRAY_BUFFER, sizeof(sVertices), sVertices.data(), GL_STATIC_DRAW);
+	gl::bufferData(GL_ARRAY_BUFFER, sizeof(sVertices), sVertices.data(), GL_STATIC_DRAW);
 
 	// Create and enable vertex attribute for vertex data.
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat),
@@ -43,73 +51,84 @@ Stars::Stars() :
 	glEnableVertexAttribArray(0);
 
 	// Unbind vertex array buffer and vertex buffer object.
-	glBindVertexArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	gl::bindVertexArray(0);
+	gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Mutator functions.
+void Stars::requestTextures(TextureLoader& textures) {
+	for (const std::string& face : TEXTURE_FACES) {
+		textures.request(face);
+	}
 }
 
-void Stars::draw(const Camera& camera) const {
-	// Disable depth writing so that skybox appears as background.
+// OpenGL modifier functions.
+void Stars::submit(RenderQueue& queue) const {
+	queue.submit(queue.key(RenderQueue::SKYBOX, mProgram->id(), mTexture->id(), GL_CCW, 0.0f),
+	             *this, 0, GpuTimer::STARS);
+}
+
+void Stars::drawItem(std::uint32_t) const {
+	// The skybox is drawn at the far plane after the opaque geometry. Disable depth writing and pass
+	// the depth test at the far plane itself, so that it only covers the background. The cube is
+	// viewed from inside, so face culling is disabled.
 	glDepthMask(GL_FALSE);
+	glDepthFunc(GL_LEQUAL);
+	glDisable(GL_CULL_FACE);
 
 	// Enable shader program.
-	mProgram.enable();
-	glUniform1i(mProgram.getUniformLocation("skybox"), 0);
-	// Set view and projection matrices.
-	glm::mat4 projection = camera.projection();
-	glm::mat4 view       = glm::mat4(glm::mat3(camera.view()));
-	glUniformMatrix4fv(mProgram.getUniformLocation("projection"), 1, GL_FALSE,
-	                   glm::value_ptr(projection));
-	glUniformMatrix4fv(mProgram.getUniformLocation("view"), 1, GL_FALSE, glm::value_ptr(view));
-
-	
+	mProgram->enable();
+	gl::uniform1i(mProgram->getUniformLocation("skybox"), 0);
+	// The view and projection matrices come from the shared camera uniform buffer.
+
 	// Bind the vertex array buffer and texture to current context.
-	glBindVertexArray(mVAO);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, mTextureID);
+	gl::bindVertexArray(mVAO.id());
+	gl::bindTexture(GL_TEXTURE_CUBE_MAP, mTexture->id());
 
 	// Draw.
-	glDrawArrays(GL_TRIANGLES, 0, sVertices.size());
+	gl::drawArrays(GL_TRIANGLES, 0, sVertices.size());
 
-	// Unbind vertex array buffer and texture and re-enable depth writing. Disable program.
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	// Restore depth writing, the depth test and face culling.
 	glDepthMask(GL_TRUE);
-	mProgram.disable();
+	glDepthFunc(GL_LESS);
+	glEnable(GL_CULL_FACE);
 }
 
 // Helper functions.
-GLuint Stars::createTexture() {
-	// Generate texture ID for cubemap and bind it to the current OpenGL context.
-	GLuint textureID;
-	glGenTextures(1, &textureID);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+GlTexture Stars::createTexture(TextureLoader& textures, std::size_t& bytes) {
+	PROFILE_SCOPE("Stars::createTexture");
 
-	// Load image for each face and bind to cubemap texture. Throw exception if image cannot be
-	// loaded.
+	// Decode every face at once, in case they are not requested yet.
+	requestTextures(textures);
+
+	// Generate texture ID for cubemap and bind it to the current OpenGL context.
+	GlTexture texture = GlTexture::generate();
+	gl::activeTexture(GL_TEXTURE0);
+	gl::bindTexture(GL_TEXTURE_CUBE_MAP, texture.id());
+
+	// Upload the image of each face to the cubemap texture. Throw exception if image cannot be
+	// loaded. Only sample the mip levels every face has.
+	GLint nLevels = 0;
+	bytes = 0;
 	for (GLuint i = 0; i < TEXTURE_FACES.size(); ++i) {
-		int           texture_width, texture_height;
-		unsigned char *image;
-
-		image = SOIL_load_image(TEXTURE_FACES[i].c_str(), &texture_width, &texture_height, 0,
-		                        SOIL_LOAD_RGB);
-		if (image == nullptr) {
-			throw std::runtime_error(
-					"Failed to locate image " + std::string(TEXTURE_FACES[i]) + ".");
-		}
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, texture_width, texture_height,
-		             0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		SOIL_free_image_data(image);
+		std::size_t faceBytes;
+		GLint       nFaceLevels = textures.upload(texture.id(),
+		                                          GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+		                                          TEXTURE_FACES[i], &faceBytes);
+		nLevels = i == 0 ? nFaceLevels : std::min(nLevels, nFaceLevels);
+		bytes  += faceBytes;
 	}
 
 	// Set texture parameters.
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, texture::minFilter(nLevels));
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, nLevels - 1);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
 	// Unbind texture.
-	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	gl::bindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
-	return textureID;
+	return texture;
 }
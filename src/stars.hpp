@@ -6,8 +6,15 @@
 #ifndef SPACE_COWBOY_STARS_HPP
 #define SPACE_COWBOY_STARS_HPP
 
-#include "camera.hpp"
+#include "asset_registry.hpp"
+#include "core/camera.hpp"
+#include "core/profiler.hpp"
+#include "gl_object.hpp"
 #include "program.hpp"
+#include "render_queue.hpp"
+#include "texture_loader.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <array>
 #include <stdexcept>
@@ -20,35 +27,76 @@
 #include <SOIL/SOIL.h>
 
 /**
- * Produces a procedurally generated skybox depicting many stars.
+ * Produces a procedurally generated skybox depicting many stars. The skybox is drawn after the opaque
+ * geometry at the far plane, so only the pixels no object covered are shaded.
  */
-class Stars {
+class Stars : public Drawable {
 public:
 	// Constructors.
 	/**
 	 * Loads the texture files for the skybox.
+	 *
+	 * @param assets Asset registry sharing the program and texture.
+	 * @param textures Texture loader decoding the textures.
+	 */
+	Stars(AssetRegistry& assets, TextureLoader& textures);
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	Stars(const Stars&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const Stars&) = delete;
+
+	/**
+	 * Move constructor, taking the objects of another skybox and leaving it empty.
+	 */
+	Stars(Stars&&) noexcept = default;
+
+	/**
+	 * Move assignment operator, deleting the objects of the skybox and taking those of another.
+	 */
+	Stars& operator=(Stars&&) noexcept = default;
+
+	// Mutator functions.
+	/**
+	 * Starts decoding the texture files for the skybox, so that they decode while other objects
+	 * are created.
+	 *
+	 * @param textures Texture loader decoding the textures.
 	 */
-	Stars();
+	static void requestTextures(TextureLoader& textures);
 
 	// OpenGL modifier functions.
 	/**
-	 * Renders the stars.
+	 * Submits the stars to a render queue.
 	 *
-	 * @param camera Camera used to render the stars.
+	 * @param queue Render queue of the frame.
 	 */
-	void draw(const Camera& camera) const;
+	void submit(RenderQueue& queue) const;
+
+	/**
+	 * Renders the stars. The camera matrices come from the shared camera uniform buffer.
+	 *
+	 * @param index Unused; the stars submit a single item.
+	 */
+	void drawItem(std::uint32_t index) const override;
 
 private:
 	// Data members.
-	/** Reference ID for the texture. */
-	GLuint mTextureID;
+	/** Cube map texture. */
+	TextureHandle mTexture;
 
 	/** Shader program. */
-	Program mProgram;
-	/** Reference ID of vertex array buffer. */
-	GLuint  mVAO;
-	/** Reference ID of vertex buffer object. */
-	GLuint  mVBO;
+	ProgramHandle mProgram;
+	/** Vertex array object. */
+	GlVertexArray mVAO;
+	/** Vertex buffer object. */
+	GlBuffer      mVBO;
 
 	// Static data members.
 	/** Skybox vertices. */
@@ -102,10 +150,14 @@ private:
 
 	// Helper functions.
 	/**
-	 * Creates a texture for a cube from the appropriate image files and returns the reference ID to
-	 * the texture. Throws std::runtime_error if image files cannot be found.
+	 * Creates a texture for a cube from the appropriate image files, or their cooked copies in an
+	 * asset pack, and returns it. The six faces decode concurrently.
+	 * Throws std::runtime_error if image files cannot be found.
+	 *
+	 * @param textures Texture loader decoding the textures.
+	 * @param bytes Set to the size of the texture's levels in bytes.
 	 */
-	static GLuint createTexture();
+	static GlTexture createTexture(TextureLoader& textures, std::size_t& bytes);
 };
 
 #endif
@@ -0,0 +1,152 @@
+/**
+ * @file stream_buffer.cpp
+ *
+ * Implementation file for the StreamBuffer class.
+ */
+#include "stream_buffer.hpp"
+
+#include "gl_calls.hpp"
+#include "core/profiler.hpp"
+
+#include <cstdint>
+#include <utility>
+
+// Redeclare constant static data members.
+constexpr unsigned int StreamBuffer::N_REGIONS;
+
+namespace {
+/** Nanoseconds to wait for a fence before checking it again. */
+constexpr GLuint64 FENCE_TIMEOUT = 1000000;
+}
+
+// Constructors.
+StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr regionSize) :
+		mTarget(target),
+		mRegionSize(regionSize),
+		mRegion(N_REGIONS - 1),
+		mMapped(nullptr),
+		mFences() {
+	mBuffer = GlBuffer::generate();
+	gl::bindBuffer(mTarget, mBuffer.id());
+
+	GLsizeiptr size = mRegionSize * N_REGIONS;
+	if (GLEW_VERSION_4_4 or GLEW_ARB_buffer_storage) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(mTarget, size, nullptr, flags);
+		mMapped = static_cast<char *>(glMapBufferRange(mTarget, 0, size, flags));
+	}
+	else {
+		gl::bufferData(mTarget, size, nullptr, GL_STREAM_DRAW);
+		mStaging.resize(static_cast<std::size_t>(mRegionSize));
+	}
+}
+
+StreamBuffer::StreamBuffer(StreamBuffer&& other) noexcept :
+		mTarget(other.mTarget),
+		mRegionSize(other.mRegionSize),
+		mBuffer(std::move(other.mBuffer)),
+		mRegion(other.mRegion),
+		mMapped(other.mMapped),
+		mFences(other.mFences),
+		mStaging(std::move(other.mStaging)) {
+	other.mMapped = nullptr;
+	other.mFences.fill(nullptr);
+}
+
+StreamBuffer& StreamBuffer::operator=(StreamBuffer&& other) noexcept {
+	if (this != &other) {
+		destroy();
+		mTarget     = other.mTarget;
+		mRegionSize = other.mRegionSize;
+		mBuffer     = std::move(other.mBuffer);
+		mRegion     = other.mRegion;
+		mMapped     = other.mMapped;
+		mFences     = other.mFences;
+		mStaging    = std::move(other.mStaging);
+		other.mMapped = nullptr;
+		other.mFences.fill(nullptr);
+	}
+	return *this;
+}
+
+// Destructors.
+StreamBuffer::~StreamBuffer() {
+	destroy();
+}
+
+// Accessor functions.
+GLuint StreamBuffer::id() const {
+	return mBuffer.id();
+}
+
+GLsizeiptr StreamBuffer::regionSize() const {
+	return mRegionSize;
+}
+
+unsigned int StreamBuffer::region() const {
+	return mRegion;
+}
+
+GLintptr StreamBuffer::regionOffset() const {
+	return static_cast<GLintptr>(mRegion) * mRegionSize;
+}
+
+// OpenGL modifier functions.
+void *StreamBuffer::beginRegion() {
+	mRegion = (mRegion + 1) % N_REGIONS;
+	if (mMapped == nullptr) {
+		return mStaging.data();
+	}
+
+	// Wait for the GPU to finish with the region. With N_REGIONS frames of latency this rarely
+	// blocks.
+	GLsync& fence = mFences[mRegion];
+	if (fence != nullptr) {
+		PROFILE_SCOPE("StreamBuffer wait");
+		GLenum status;
+		do {
+			status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+		} while (status == GL_TIMEOUT_EXPIRED);
+		if (status == GL_WAIT_FAILED) {
+			// The fence can't tell whether the GPU is done with the region, so wait for all
+			// commands to complete.
+			glFinish();
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+	return mMapped + regionOffset();
+}
+
+void StreamBuffer::endRegion(GLsizeiptr size) {
+	if (mMapped == nullptr) {
+		gl::bindBuffer(mTarget, mBuffer.id());
+		gl::bufferSubData(mTarget, regionOffset(), size, mStaging.data());
+	}
+	else {
+		// The mapping is coherent, so the writes need no flush; count them as uploaded.
+		renderStats::current().bytesUploaded += static_cast<std::uint64_t>(size);
+	}
+}
+
+void StreamBuffer::fenceRegion() {
+	if (mMapped != nullptr) {
+		mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+// Helper functions.
+void StreamBuffer::destroy() {
+	for (GLsync& fence : mFences) {
+		if (fence != nullptr) {
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	if (mMapped != nullptr) {
+		gl::bindBuffer(mTarget, mBuffer.id());
+		glUnmapBuffer(mTarget);
+		mMapped = nullptr;
+	}
+	mBuffer.reset();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file stream_buffer.hpp
+ *
+ * Interface file for the StreamBuffer class.
+ */
+#ifndef SPACE_COWBOY_STREAM_BUFFER_HPP
+#define SPACE_COWBOY_STREAM_BUFFER_HPP
+
+#include "gl_object.hpp"
+
+#include <array>
+#include <vector>
+#include <GL/glew.h>
+
+/**
+ * Buffer object rewritten by the CPU every frame. The buffer is split into N_REGIONS regions used in
+ * turn, so that the CPU writes one frame's data while the GPU may still read earlier frames'. When
+ * buffer storage is supported (OpenGL 4.4 or ARB_buffer_storage) the buffer is persistently mapped
+ * and written in place, with a fence per region so that a region is only rewritten once the GPU is
+ * done with it. Otherwise the data is staged in CPU memory and uploaded with glBufferSubData into the
+ * current region. A StreamBuffer should only be constructed after OpenGL has initialized.
+ */
+class StreamBuffer {
+public:
+	// Constants.
+	/** Number of regions, one per frame that may be in flight. */
+	static constexpr unsigned int N_REGIONS = 3;
+
+	// Constructors.
+	/**
+	 * Creates a stream buffer.
+	 *
+	 * @param target Target the buffer is bound to when uploading.
+	 * @param regionSize Size of each region in bytes.
+	 */
+	StreamBuffer(GLenum target, GLsizeiptr regionSize);
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	StreamBuffer(const StreamBuffer&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const StreamBuffer&) = delete;
+
+	/**
+	 * Move constructor, taking the buffer, mapping and fences of another stream buffer and leaving
+	 * it empty.
+	 */
+	StreamBuffer(StreamBuffer&& other) noexcept;
+
+	/**
+	 * Move assignment operator, deleting the buffer and fences, then taking those of another stream
+	 * buffer and leaving it empty.
+	 */
+	StreamBuffer& operator=(StreamBuffer&& other) noexcept;
+
+	// Destructors.
+	/**
+	 * Destroys the buffer and its fences.
+	 */
+	~StreamBuffer();
+
+	// Accessor functions.
+	/**
+	 * Returns the reference ID of the buffer.
+	 *
+	 * @return Reference ID of the buffer.
+	 */
+	GLuint id() const;
+
+	/**
+	 * Returns the size of each region.
+	 *
+	 * @return Size of each region in bytes.
+	 */
+	GLsizeiptr regionSize() const;
+
+	/**
+	 * Returns the index of the region being written.
+	 *
+	 * @return Index of the current region.
+	 */
+	unsigned int region() const;
+
+	/**
+	 * Returns the offset of the region being written from the start of the buffer.
+	 *
+	 * @return Offset of the current region in bytes.
+	 */
+	GLintptr regionOffset() const;
+
+	// OpenGL modifier functions.
+	/**
+	 * Moves on to the next region and returns where its data should be written. Waits for the GPU to
+	 * finish reading the region if it has not yet.
+	 *
+	 * @return Pointer to regionSize() writable bytes.
+	 */
+	void *beginRegion();
+
+	/**
+	 * Makes the data written into the current region visible to the GPU.
+	 *
+	 * @param size Number of bytes written from the start of the region.
+	 */
+	void endRegion(GLsizeiptr size);
+
+	/**
+	 * Marks the current region as in use by the commands issued so far. Should be called after the
+	 * last command reading the region.
+	 */
+	void fenceRegion();
+
+private:
+	// Data members.
+	/** Target the buffer is bound to when uploading. */
+	GLenum       mTarget;
+	/** Size of each region in bytes. */
+	GLsizeiptr   mRegionSize;
+	/** Buffer object. */
+	GlBuffer     mBuffer;
+	/** Index of the current region. */
+	unsigned int mRegion;
+
+	/** Persistently mapped contents of the buffer, or null if the buffer is not mapped. */
+	char                          *mMapped;
+	/** Fence of each region, or null if the region is not in use. */
+	std::array<GLsync, N_REGIONS> mFences;
+	/** CPU copy of the current region, used when the buffer is not mapped. */
+	std::vector<char>             mStaging;
+
+	// Helper functions.
+	/**
+	 * Deletes the fences, unmaps the buffer and deletes it, leaving the stream buffer empty.
+	 */
+	void destroy();
+};
+
+#endif
@@ -5,6 +5,8 @@
  */
 #include "sun.hpp"
 
+#include "gl_calls.hpp"
+
 namespace {
 // Shader program file paths.
 /** Path to vertex shader source code. */
@@ -22,9 +24,10 @@ constexpr unsigned int N_LONGITUDE = 240;
 }
 
 // Constructors.
-Sun::Sun() :
-		mProgram(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH),
-		mScale() {
+Sun::Sun(AssetRegistry& assets, TextureLoader& textures) :
+		mProgram(assets.program(VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH)),
+		mTexture(assets.texture2D(SUN_TEXTURE, textures)),
+		mBody(nullptr) {
 	// Create the Sphere object which holds the sun's vertex, normal, and index data. Record the
 	// number of vertex components and indices.
 	Sphere sphere(1.0f, N_LATITUDE, N_LONGITUDE);
@@ -33,22 +36,21 @@ Sun::Sun() :
 
 	// Create vertex array buffer, vertex buffer object, and element buffer objects and bind
 	// them to current OpenGL context.
-	glGenVertexArrays(1, &sVAO);
-	glGenBuffers(1, &sVBO);
-	glGenBuffers(1, &sEBO);
-	glGenBuffers(1, &mUV_VBO);
+	sVAO = GlVertexArray::generate();
+	sVBO = GlBuffer::generate();
+	sEBO = GlBuffer::generate();
 
-	glBindVertexArray(sVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, sVBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sEBO);
+	gl::bindVertexArray(sVAO.id());
+	gl::bindBuffer(GL_ARRAY_BUFFER, sVBO.id());
+	gl::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, sEBO.id());
 
 	// Pass vertex data into vertex buffer object.
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * mNVertices,
-	             static_cast<GLvoid *>(sphere.vertices.data()), GL_STATIC_DRAW);
+	gl::bufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * mNVertices,
+	               static_cast<GLvoid *>(sphere.vertices.data()), GL_STATIC_DRAW);
 
 	// Pass index data into element buffer object.
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mNIndices,
-	             static_cast<GLvoid *>(sphere.indices.data()), GL_STATIC_DRAW);
+	gl::bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mNIndices,
+	               static_cast<GLvoid *>(sphere.indices.data()), GL_STATIC_DRAW);
 
 	// Create and enable vertex attribute.
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat),
@@ -56,87 +58,49 @@ Sun::Sun() :
 	glEnableVertexAttribArray(0);
 
 	//create uv buffer object and add data to it give in location of 2 in shaders
-	glGenBuffers(1, &mUV_VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mUV_VBO);
-	glBufferData(GL_ARRAY_BUFFER, sphere.uvs.size() * sizeof(GLfloat), &sphere.uvs.front(),
-	             GL_STATIC_DRAW);
+	mUV_VBO = GlBuffer::generate();
+	gl::bindBuffer(GL_ARRAY_BUFFER, mUV_VBO.id());
+	gl::bufferData(GL_ARRAY_BUFFER, sphere.uvs.size() * sizeof(GLfloat), &sphere.uvs.front(),
+	               GL_STATIC_DRAW);
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
 	                      reinterpret_cast<GLvoid *>(0));
 	glEnableVertexAttribArray(1);
 
 	// Unbind vertex array buffer, vertex buffer object, and element buffer objects.
-	glBindVertexArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-
-	sphere.textureSphere(SUN_TEXTURE, sun_texture);
-}
-
-// Destructors.
-Sun::~Sun() {
-	glDeleteVertexArrays(1, &sVAO);
-	glDeleteBuffers(1, &sVBO);
-	glDeleteBuffers(1, &sEBO);
-}
-
-// Accessor functions.
-glm::mat4 Sun::modelMatrix() const {
-	return mScale;
-}
-
-// Modifier functions.
-void Sun::scale(float scaleFactor) {
-	mScale = glm::scale(mScale, glm::vec3(scaleFactor, scaleFactor, scaleFactor));
+	gl::bindVertexArray(0);
+	gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+	gl::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-bool Sun::sunCollision(const Camera& camera) {
-
-	glm::vec3 cameraPosition = camera.position();
-	glm::vec3 camDir         = camera.direction();
-	glm::vec3 sunCenter      = glm::vec3(0.0f);
-	float     sunRadius      = glm::length(mScale * glm::vec4(1.0f, 0.0f, 0.0f, 0.0f));
-
-	if (glm::length(glm::vec3(cameraPosition.x, cameraPosition.y - 4.0f, cameraPosition.z)
-	                + glm::vec3(25 * camDir.x, 25 * camDir.y, 25 * camDir.z) - sunCenter) <=
-	    sunRadius * 1.1f) {
-		return true;
-	}
-
-	return false;
-
-
+// Mutator functions.
+void Sun::requestTextures(TextureLoader& textures) {
+	textures.request(SUN_TEXTURE);
 }
 
 // OpenGL modifiers.
-void Sun::draw(const Camera& camera) const {
+void Sun::submit(RenderQueue& queue, const Body& body, const CameraBlock& camera) const {
+	mBody = &body;
+	float depth = camera.viewDepth(body.position()) - body.size();
+	queue.submit(queue.key(RenderQueue::OPAQUE, mProgram->id(), mTexture->id(), GL_CW, depth),
+	             *this, 0, GpuTimer::SUN);
+}
 
+void Sun::drawItem(std::uint32_t) const {
 	// Enable program.
-	mProgram.enable();
-
-	// Calculate the model-view-projection matrix and set the corresponding uniform.
-	glm::mat4 model      = modelMatrix();
-	glm::mat4 view       = camera.view();
-	glm::mat4 projection = camera.projection();
+	mProgram->enable();
 
-	glm::mat4 MVP = projection * view * model;
+	// Set the model uniform. The camera matrices come from the shared camera uniform buffer.
+	glm::mat4 model = mBody->modelMatrix();
+	gl::uniformMatrix4fv(mProgram->getUniformLocation("model"), 1, GL_FALSE, glm::value_ptr(model));
 
-	glUniformMatrix4fv(mProgram.getUniformLocation("MVP"), 1, GL_FALSE, glm::value_ptr(MVP));
+	gl::uniform1i(mProgram->getUniformLocation("sunTexture"), 0);
 
-	glUniform1i(mProgram.getUniformLocation("sunTexture"), 0);
+	gl::bindTexture(GL_TEXTURE_2D, mTexture->id());
 
-	glBindTexture(GL_TEXTURE_2D, sun_texture);
-
-	// Bind vertex array object and element buffer object to current context.
-	glBindVertexArray(sVAO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sEBO);
+	// Bind vertex array object, which holds the element buffer object, to current context.
+	gl::bindVertexArray(sVAO.id());
 
 	// Draw.
-	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mNIndices), GL_UNSIGNED_INT,
-	               static_cast<GLvoid *>(0));
-
-	// Disable program and unbind vertex array object and element buffer object.
-	mProgram.disable();
-	glBindVertexArray(0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	gl::drawElements(GL_TRIANGLES, static_cast<GLsizei>(mNIndices), GL_UNSIGNED_INT,
+	                 static_cast<GLvoid *>(0));
 }
\ No newline at end of file
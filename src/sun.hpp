@@ -6,11 +6,17 @@
 #ifndef SPACE_COWBOY_SUN_HPP
 #define SPACE_COWBOY_SUN_HPP
 
-#include "camera.hpp"
+#include "asset_registry.hpp"
+#include "core/body.hpp"
+#include "core/camera.hpp"
+#include "gl_object.hpp"
 #include "palette.hpp"
 #include "program.hpp"
-#include "sphere.hpp"
+#include "render_queue.hpp"
+#include "texture_loader.hpp"
+#include "core/sphere.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -19,17 +25,19 @@
 #include <glm/gtc/type_ptr.hpp>
 
 /**
- * Represents a Sun. Serves as a central source of illumination for the solar system. Note that the
- * camera used to render the sun must be with the function setCamera, or else the sun will not
- * render.
+ * Renders the Sun, the central source of illumination for the solar system. The sun's state is
+ * simulated by the core library and passed in when submitting.
  */
-class Sun {
+class Sun : public Drawable {
 public:
 	// Constructors.
 	/**
 	 * Constructs a sphere of unit size centred at the origin.
+	 *
+	 * @param assets Asset registry sharing the program and texture.
+	 * @param textures Texture loader decoding the texture.
 	 */
-	Sun();
+	Sun(AssetRegistry& assets, TextureLoader& textures);
 
 	/**
 	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
@@ -42,61 +50,66 @@ public:
 	 */
 	Sun& operator=(const Sun& other) = delete;
 
-	// Destructors.
 	/**
-	 * Destroys the vertex array object, vertex buffer object, and element buffer object.
+	 * Move constructor, taking the objects of another sun and leaving it empty.
 	 */
-	~Sun();
+	Sun(Sun&&) noexcept = default;
 
-	// Accessor functions.
 	/**
-	 * Returns the model matrix for the sun.
-	 *
-	 * @return Sun's model matrix.
+	 * Move assignment operator, deleting the objects of the sun and taking those of another.
 	 */
-	glm::mat4 modelMatrix() const;
+	Sun& operator=(Sun&&) noexcept = default;
 
 	// Mutator functions.
 	/**
-	 * Scale the sun.
+	 * Starts decoding the sun's texture, so that it decodes while other objects are created.
 	 *
-	 * @param scaleFactor Scale factor.
+	 * @param textures Texture loader decoding the texture.
 	 */
-	void scale(float scaleFactor);
+	static void requestTextures(TextureLoader& textures);
 
 	// OpenGL modifiers.
 	/**
-	 * Renders the sun.
+	 * Submits the sun to a render queue. The body must stay alive until the queue is executed.
 	 *
-	 * @param camera Camera object used to render the sun.
+	 * @param queue Render queue of the frame.
+	 * @param body Simulation state of the sun.
+	 * @param camera Camera block of the frame.
 	 */
-	void draw(const Camera& camera) const;
+	void submit(RenderQueue& queue, const Body& body, const CameraBlock& camera) const;
 
-	bool sunCollision(const Camera &camera);
+	/**
+	 * Renders the sun.
+	 *
+	 * @param index Unused; the sun submits a single item.
+	 */
+	void drawItem(std::uint32_t index) const override;
 
 public:
 	// Data members.
 	/** Shader program. */
-	Program mProgram;
+	ProgramHandle mProgram;
 
-	/** Scale matrix. */
-	glm::mat4 mScale;
+	/** Vertex array object. */
+	GlVertexArray sVAO;
+	/** Vertex buffer object. */
+	GlBuffer      sVBO;
+	/** Element buffer object. */
+	GlBuffer      sEBO;
 
-	/** Reference ID of vertex array buffer. */
-	GLuint sVAO;
-	/** Reference ID of vertex buffer object. */
-	GLuint sVBO;
-	/** Reference ID of element buffer object. */
-	GLuint sEBO;
+	/** Texture coordinate buffer object. */
+	GlBuffer      mUV_VBO;
 
-	GLuint mUV_VBO;
-
-	GLuint sun_texture;
+	/** Sun texture. */
+	TextureHandle mTexture;
 
 	/** Number of vertices in the sun's mesh data. */
 	unsigned int mNVertices;
 	/** Number of indices in the sun's element buffer. */
 	unsigned int mNIndices;
+
+	/** Body submitted for the current frame. */
+	mutable const Body *mBody;
 };
 
 #endif
@@ -0,0 +1,277 @@
+/**
+ * @file texture.cpp
+ *
+ * Defines texture loading functions in the "texture" namespace.
+ */
+#include "texture.hpp"
+
+#include "gl_calls.hpp"
+#include "texture_loader.hpp"
+#include "core/image.hpp"
+#include "core/profiler.hpp"
+#include "core/utility.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <SOIL/SOIL.h>
+
+namespace {
+/** Frees pixels decoded by SOIL. */
+struct PixelsDeleter {
+	void operator()(unsigned char *pixels) const {
+		SOIL_free_image_data(pixels);
+	}
+};
+
+/** Level of a decoded image, as specified to OpenGL. */
+struct ImageLevel {
+	/** Width of the level in pixels. */
+	GLsizei     width;
+	/** Height of the level in pixels. */
+	GLsizei     height;
+	/** Internal format of the level. */
+	GLenum      internalFormat;
+	/** Pixel format of the data. */
+	GLenum      format;
+	/** Type of the pixel components, or 0 if the data is compressed. */
+	GLenum      type;
+	/** Data of the level. */
+	const void *data;
+	/** Size of the data in bytes. */
+	GLsizeiptr  size;
+};
+
+/**
+ * Lists the levels of a decoded image's cooked mip chain.
+ */
+std::vector<ImageLevel> imageLevels(const texture::DecodedImage& image) {
+	std::vector<ImageLevel> levels;
+	const assetCook::TextureView& cooked = image.cooked;
+	for (std::size_t level = 0; level < cooked.levels.size(); ++level) {
+		ImageLevel imageLevel;
+		imageLevel.width  = static_cast<GLsizei>(std::max<std::uint32_t>(cooked.width >> level, 1));
+		imageLevel.height = static_cast<GLsizei>(std::max<std::uint32_t>(cooked.height >> level, 1));
+		imageLevel.data   = cooked.levels[level].data;
+		imageLevel.size   = static_cast<GLsizeiptr>(cooked.levels[level].size);
+		switch (cooked.format) {
+			case assetCook::CookedTexture::BC1:
+				imageLevel.internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+				imageLevel.format         = GL_RGB;
+				imageLevel.type           = 0;
+				break;
+			case assetCook::CookedTexture::RGBA8:
+				imageLevel.internalFormat = GL_RGBA;
+				imageLevel.format         = GL_RGBA;
+				imageLevel.type           = GL_UNSIGNED_BYTE;
+				break;
+			default:
+				imageLevel.internalFormat = GL_RGB;
+				imageLevel.format         = GL_RGB;
+				imageLevel.type           = GL_UNSIGNED_BYTE;
+				break;
+		}
+		levels.push_back(imageLevel);
+	}
+	return levels;
+}
+
+/**
+ * Specifies a level of the bound texture, with its data or, if null, with undefined contents.
+ */
+void specifyLevel(GLenum target, GLint glLevel, const ImageLevel& level, const void *data) {
+	if (level.type == 0) {
+		glCompressedTexImage2D(target, glLevel, level.internalFormat, level.width, level.height, 0,
+		                       static_cast<GLsizei>(level.size), data);
+	}
+	else {
+		glTexImage2D(target, glLevel, static_cast<GLint>(level.internalFormat), level.width,
+		             level.height, 0, level.format, level.type, data);
+	}
+}
+}
+
+namespace texture {
+DecodedImage decodeImage(const std::string& path, const AssetPack *pack,
+                         bool compressionSupported) {
+	PROFILE_SCOPE("texture::decodeImage");
+
+	DecodedImage image;
+	image.pack  = nullptr;
+	image.entry = nullptr;
+
+	// Read the cooked copy in place from the mapped pack, checking it on the way.
+	const AssetPack::Entry *entry = pack != nullptr ? pack->find(path, AssetPack::TEXTURE) : nullptr;
+	if (entry != nullptr) {
+		try {
+			image.cooked = assetCook::viewTexture(pack->payload(*entry), entry->size);
+			if (image.cooked.format != assetCook::CookedTexture::BC1 or compressionSupported) {
+				image.pack  = pack;
+				image.entry = entry;
+				return image;
+			}
+			image.warning = "S3TC textures are not supported. Loading " + path + " instead.";
+		}
+		catch (const std::runtime_error& error) {
+			image.warning = std::string(error.what()) + " Loading " + path + " instead.";
+		}
+	}
+
+	// Read the cooked copy in place from the cache, if cooked from the same image file with the
+	// same settings.
+	std::unique_ptr<utility::MappedFile> file;
+	try {
+		file.reset(new utility::MappedFile(path));
+	}
+	catch (const std::runtime_error&) {
+		throw std::runtime_error("Failed to locate image " + path + ".");
+	}
+	std::uint64_t hash      = assetCook::sourceHash(file->data(), file->size(), AssetPack::TEXTURE,
+	                                                compressionSupported);
+	std::string   cachePath = path + CACHE_SUFFIX;
+	if (std::ifstream(cachePath)) {
+		try {
+			std::shared_ptr<const AssetPack> cache  = std::make_shared<const AssetPack>(cachePath);
+			const AssetPack::Entry           *cached = cache->find(path, AssetPack::TEXTURE);
+			if (cached != nullptr and cached->sourceHash == hash) {
+				image.cooked = assetCook::viewTexture(cache->payload(*cached), cached->size);
+				image.pack   = cache.get();
+				image.entry  = cached;
+				image.cache  = std::move(cache);
+				return image;
+			}
+		}
+		catch (const std::runtime_error&) {
+			// Cook the image file again over the unusable cache.
+		}
+	}
+
+	// Decode the image file straight from its mapping, then cook it.
+	int                                           width, height;
+	std::unique_ptr<unsigned char, PixelsDeleter> pixels(SOIL_load_image_from_memory(
+			reinterpret_cast<const unsigned char *>(file->data()), static_cast<int>(file->size()),
+			&width, &height, nullptr, SOIL_LOAD_RGB));
+	if (pixels == nullptr) {
+		throw std::runtime_error("Failed to decode image " + path + ".");
+	}
+	file.reset();
+	image::Image source;
+	source.width    = static_cast<std::uint32_t>(width);
+	source.height   = static_cast<std::uint32_t>(height);
+	source.channels = 3;
+	source.pixels.assign(pixels.get(), pixels.get() + 3 * source.width * source.height);
+	pixels.reset();
+
+	// Cache the cooked copy. The image is still usable if the cache cannot be written.
+	std::vector<AssetPack::Item> items(1);
+	items[0].name       = path;
+	items[0].type       = AssetPack::TEXTURE;
+	items[0].sourceHash = hash;
+	items[0].payload    = assetCook::serialize(assetCook::cookTexture(source,
+	                                                                  compressionSupported));
+	try {
+		AssetPack::write(cachePath, items);
+	}
+	catch (const std::runtime_error& error) {
+		image.warning += (image.warning.empty() ? "" : " ") + std::string(error.what()) +
+		                 " Cooking " + path + " again on the next launch.";
+	}
+	image.payload = std::move(items[0].payload);
+	image.cooked  = assetCook::viewTexture(image.payload.data(), image.payload.size());
+	return image;
+}
+
+std::size_t imageBytes(const DecodedImage& image) {
+	std::size_t bytes = 0;
+	for (const assetCook::ArrayView<std::uint8_t>& level : image.cooked.levels) {
+		bytes += level.size;
+	}
+	return bytes;
+}
+
+GLint uploadImage(GLenum target, DecodedImage& image) {
+	PROFILE_SCOPE("texture::uploadImage");
+
+	if (not image.warning.empty()) {
+		std::cerr << "Warning: " << image.warning << std::endl;
+	}
+
+	// The rows of the levels are tightly packed.
+	std::vector<ImageLevel> levels = imageLevels(image);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (std::size_t i = 0; i < levels.size(); ++i) {
+		specifyLevel(target, static_cast<GLint>(i), levels[i], levels[i].data);
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	std::vector<std::uint8_t>().swap(image.payload);
+	if (image.entry != nullptr) {
+		image.pack->release(*image.entry);
+	}
+	return static_cast<GLint>(levels.size());
+}
+
+GLint queueImage(GLuint texture, GLenum target, const std::shared_ptr<DecodedImage>& image,
+                 UploadService& uploads) {
+	PROFILE_SCOPE("texture::queueImage");
+
+	if (not image->warning.empty()) {
+		std::cerr << "Warning: " << image->warning << std::endl;
+	}
+
+	// Allocate every level now, so that the texture is complete, and fill them in later. Each
+	// upload holds on to the image, and so to its cooked copy; the last one releases its pages.
+	std::vector<ImageLevel> levels = imageLevels(*image);
+	for (std::size_t i = 0; i < levels.size(); ++i) {
+		const ImageLevel& level   = levels[i];
+		GLint             glLevel = static_cast<GLint>(i);
+		specifyLevel(target, glLevel, level, nullptr);
+
+		GLenum format = level.type == 0 ? level.internalFormat : level.format;
+		UploadService::TextureRegion region = { texture, target, glLevel, level.width, level.height,
+		                                        format, level.type };
+		bool last = i + 1 == levels.size();
+		uploads.uploadTexture(region, level.data, level.size, [image, last] {
+			if (last and image->entry != nullptr) {
+				image->pack->release(*image->entry);
+			}
+		});
+	}
+	return static_cast<GLint>(levels.size());
+}
+
+GLint minFilter(GLint nLevels) {
+	return nLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+}
+
+std::size_t loadTexture2D(const char *path, GlTexture& texture, TextureLoader& loader) {
+	PROFILE_SCOPE("texture::loadTexture2D");
+
+	gl::activeTexture(GL_TEXTURE0); //select texture unit 0
+
+	texture = GlTexture::generate();
+	//bind this texture to the currently bound texture unit
+	gl::bindTexture(GL_TEXTURE_2D, texture.id());
+
+	// Set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+
+	// Set texture wrapping to GL_REPEAT (usually basic wrapping method)
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	// Upload the decoded image, then set the texture filtering parameters and the levels to sample.
+	std::size_t bytes;
+	GLint       nLevels = loader.upload(texture.id(), GL_TEXTURE_2D, path, &bytes);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter(nLevels));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, nLevels - 1);
+
+	//unbind for safety
+	gl::bindTexture(GL_TEXTURE_2D, 0);
+	return bytes;
+}
+}
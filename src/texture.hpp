@@ -0,0 +1,114 @@
+/**
+ * @file texture.hpp
+ *
+ * Declares texture loading functions in the "texture" namespace.
+ */
+#ifndef SPACE_COWBOY_TEXTURE_HPP
+#define SPACE_COWBOY_TEXTURE_HPP
+
+#include "core/asset_cook.hpp"
+#include "core/asset_pack.hpp"
+#include "gl_object.hpp"
+#include "upload_service.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+
+class TextureLoader;
+
+namespace texture {
+/** Suffix of the path of the cache file holding an image file's cooked copy. */
+constexpr char CACHE_SUFFIX[] = ".cooked";
+
+/**
+ * Image decoded on the CPU and ready to upload, as a cooked copy with its mip chain: read in place
+ * from an asset pack or from the image file's cache, or cooked just now.
+ */
+struct DecodedImage {
+	/** Asset pack or cache holding the cooked copy, or nullptr if it was cooked just now. */
+	const AssetPack                  *pack;
+	/** Entry of the cooked copy in the pack, or nullptr if it was cooked just now. */
+	const AssetPack::Entry           *entry;
+	/** Cache holding the cooked copy, kept mapped until uploaded, or nullptr. */
+	std::shared_ptr<const AssetPack> cache;
+	/** Cooked copy, if cooked just now. */
+	std::vector<std::uint8_t>        payload;
+	/** Cooked copy, read in place. */
+	assetCook::TextureView           cooked;
+	/** Warning to report when uploading, or empty. */
+	std::string                      warning;
+};
+
+/**
+ * Decodes an image without OpenGL, so that images can be decoded on worker threads. The cooked copy
+ * of the image is used if the asset pack holds one the GPU can use. Otherwise the image file is
+ * cooked with its mip chain, compressed to BC1 if the GPU supports it, and the cooked copy is
+ * cached next to it, in a one-entry pack named after it with CACHE_SUFFIX, so that later launches
+ * read it in place as long as the image file and the cooking settings do not change.
+ *
+ * @param path Path of the image file, which names its cooked copy.
+ * @param pack Asset pack to look the cooked copy up in, or nullptr to use the image file.
+ * @param compressionSupported True if the GPU supports S3TC compressed textures.
+ * @return Decoded image.
+ * @throws std::runtime_error if the image file cannot be loaded.
+ */
+DecodedImage decodeImage(const std::string& path, const AssetPack *pack, bool compressionSupported);
+
+/**
+ * Returns the size of the levels of a decoded image.
+ *
+ * @param image Decoded image.
+ * @return Size of the levels in bytes.
+ */
+std::size_t imageBytes(const DecodedImage& image);
+
+/**
+ * Uploads a decoded image into the bound texture, or into one face of the bound cube map, then
+ * frees its cooked copy or releases its pages.
+ *
+ * @param target Target of the bound texture, or of the cube map face.
+ * @param image Decoded image.
+ * @return Number of mip levels uploaded.
+ */
+GLint uploadImage(GLenum target, DecodedImage& image);
+
+/**
+ * Allocates the levels of a decoded image in the bound texture, or in one face of the bound cube
+ * map, and requests uploading their data through an upload service. The cooked copy is freed, or
+ * its pages released, once the last level is uploaded.
+ *
+ * @param texture Reference ID of the texture.
+ * @param target Target of the bound texture, or of the cube map face.
+ * @param image Decoded image.
+ * @param uploads Upload service carrying out the uploads.
+ * @return Number of mip levels allocated.
+ */
+GLint queueImage(GLuint texture, GLenum target, const std::shared_ptr<DecodedImage>& image,
+                 UploadService& uploads);
+
+/**
+ * Returns the minifying filter of a texture: trilinear if it has a mip chain, linear otherwise.
+ *
+ * @param nLevels Number of mip levels of the texture.
+ * @return Minifying filter.
+ */
+GLint minFilter(GLint nLevels);
+
+/**
+ * Loads an image into a new 2D texture with repeat wrapping and trilinear filtering. The texture is
+ * left unbound.
+ *
+ * @param path Path of the image file.
+ * @param texture Set to the created texture.
+ * @param loader Texture loader decoding and uploading the image.
+ * @return Size of the texture's levels in bytes.
+ * @throws std::runtime_error if the image cannot be loaded.
+ */
+std::size_t loadTexture2D(const char *path, GlTexture& texture, TextureLoader& loader);
+}
+
+#endif
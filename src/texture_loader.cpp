@@ -0,0 +1,131 @@
+/**
+ * @file texture_loader.cpp
+ *
+ * Implementation file for the TextureLoader class.
+ */
+#include "texture_loader.hpp"
+
+#include "core/profiler.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace {
+/** Largest number of worker threads, whatever the number of cores. */
+constexpr unsigned int MAX_WORKERS = 8;
+}
+
+// Constructors.
+TextureLoader::TextureLoader(const AssetPack *pack, UploadService *uploads) :
+		mPack(pack),
+		mUploads(uploads),
+		mCompressionSupported(GLEW_EXT_texture_compression_s3tc),
+		mMaxWorkers(std::min(MAX_WORKERS, std::max(1u, std::thread::hardware_concurrency()))),
+		mActiveWorkers(0) { }
+
+// Destructors.
+TextureLoader::~TextureLoader() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mQueue.clear();
+	}
+	for (std::thread& worker : mWorkers) {
+		worker.join();
+	}
+}
+
+// Mutator functions.
+void TextureLoader::request(const std::string& path) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	enqueue(path);
+}
+
+// OpenGL modifier functions.
+GLint TextureLoader::upload(GLuint texture, GLenum target, const std::string& path,
+                            std::size_t *bytes) {
+	PROFILE_SCOPE("TextureLoader::upload");
+
+	// Take the decoded image out of its job, rethrowing any error from decoding it.
+	texture::DecodedImage image;
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		Job& job = enqueue(path);
+		mDecoded.wait(lock, [&job] { return job.done; });
+		std::exception_ptr error = job.error;
+		image = std::move(job.image);
+		mJobs.erase(path);
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+	if (bytes != nullptr) {
+		*bytes = texture::imageBytes(image);
+	}
+	if (mUploads != nullptr) {
+		return texture::queueImage(texture, target,
+		                           std::make_shared<texture::DecodedImage>(std::move(image)),
+		                           *mUploads);
+	}
+	return texture::uploadImage(target, image);
+}
+
+// Helper functions.
+TextureLoader::Job& TextureLoader::enqueue(const std::string& path) {
+	std::map<std::string, Job>::iterator found = mJobs.find(path);
+	if (found != mJobs.end()) {
+		return found->second;
+	}
+
+	Job& job = mJobs[path];
+	job.path = path;
+	job.done = false;
+	mQueue.push_back(&job);
+	if (mActiveWorkers < mMaxWorkers) {
+		joinFinishedWorkers();
+		++mActiveWorkers;
+		mWorkers.emplace_back(&TextureLoader::work, this);
+	}
+	return job;
+}
+
+void TextureLoader::work() {
+	PROFILE_THREAD_NAME("Texture decoder");
+
+	// Decode outside the lock. A queued job is only erased once done, so it outlives decoding.
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (not mQueue.empty()) {
+		Job *job = mQueue.front();
+		mQueue.pop_front();
+		lock.unlock();
+
+		texture::DecodedImage image;
+		std::exception_ptr    error;
+		try {
+			image = texture::decodeImage(job->path, mPack, mCompressionSupported);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+
+		lock.lock();
+		job->image = std::move(image);
+		job->error = error;
+		job->done  = true;
+		mDecoded.notify_all();
+	}
+	--mActiveWorkers;
+	mFinishedWorkers.push_back(std::this_thread::get_id());
+}
+
+void TextureLoader::joinFinishedWorkers() {
+	// A thread's ID is not reused before it is joined, so it identifies the worker.
+	for (std::thread::id id : mFinishedWorkers) {
+		std::vector<std::thread>::iterator worker =
+				std::find_if(mWorkers.begin(), mWorkers.end(),
+				             [id](const std::thread& thread) { return thread.get_id() == id; });
+		worker->join();
+		mWorkers.erase(worker);
+	}
+	mFinishedWorkers.clear();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file texture_loader.hpp
+ *
+ * Interface file for the TextureLoader class.
+ */
+#ifndef SPACE_COWBOY_TEXTURE_LOADER_HPP
+#define SPACE_COWBOY_TEXTURE_LOADER_HPP
+
+#include "core/asset_pack.hpp"
+#include "texture.hpp"
+#include "upload_service.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <GL/glew.h>
+
+/**
+ * Decodes textures on worker threads and uploads them on the OpenGL thread. Textures are requested
+ * ahead of time so that they all decode concurrently, while the OpenGL thread carries on creating
+ * the objects that need them; uploading a texture waits for its decoding only if it has not
+ * finished yet. Workers are started as textures are requested, up to one per core, and exit once
+ * no texture is left to decode; the workers that exited are joined whenever another is started.
+ * Given an upload service, the loader only allocates the textures and leaves copying their data to
+ * the service. A TextureLoader should only be constructed after OpenGL has initialized, and only be
+ * used from the OpenGL thread.
+ */
+class TextureLoader {
+public:
+	// Constructors.
+	/**
+	 * Creates a texture loader.
+	 *
+	 * @param pack Asset pack to load the cooked textures from, or nullptr to load their source
+	 *             files.
+	 * @param uploads Upload service copying the textures' data, or nullptr to upload it at once.
+	 *                Must outlive the loader.
+	 */
+	explicit TextureLoader(const AssetPack *pack = nullptr, UploadService *uploads = nullptr);
+
+	/**
+	 * Copy constructor is disabled as the loader owns its worker threads.
+	 */
+	TextureLoader(const TextureLoader&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as the loader owns its worker threads.
+	 */
+	void operator=(const TextureLoader&) = delete;
+
+	// Destructors.
+	/**
+	 * Drops the textures left to decode and waits for the workers to exit.
+	 */
+	~TextureLoader();
+
+	// Mutator functions.
+	/**
+	 * Starts decoding a texture on a worker thread, unless it is already requested.
+	 *
+	 * @param path Path of the image file.
+	 */
+	void request(const std::string& path);
+
+	// OpenGL modifier functions.
+	/**
+	 * Uploads a texture into the bound texture, or into one face of the bound cube map, requesting
+	 * it first if needed and waiting for its decoding to finish. With an upload service, the levels
+	 * are allocated and their data is copied by the service later.
+	 *
+	 * @param texture Reference ID of the bound texture.
+	 * @param target Target of the bound texture, or of the cube map face.
+	 * @param path Path of the image file.
+	 * @param bytes Set to the size of the uploaded levels in bytes, unless nullptr.
+	 * @return Number of mip levels uploaded.
+	 * @throws std::runtime_error if the image cannot be loaded.
+	 */
+	GLint upload(GLuint texture, GLenum target, const std::string& path,
+	             std::size_t *bytes = nullptr);
+
+private:
+	/** Texture requested for decoding. */
+	struct Job {
+		/** Path of the image file. */
+		std::string           path;
+		/** Decoded image, once done. */
+		texture::DecodedImage image;
+		/** Exception thrown while decoding, if any. */
+		std::exception_ptr    error;
+		/** True once decoded. */
+		bool                  done;
+	};
+
+	// Helper functions.
+	/**
+	 * Queues a texture for decoding if not already requested, and starts a worker if fewer than
+	 * the maximum are running. The mutex must be held.
+	 *
+	 * @return Job of the texture.
+	 */
+	Job& enqueue(const std::string& path);
+
+	/**
+	 * Decodes the queued textures until none is left. Run by each worker thread.
+	 */
+	void work();
+
+	/**
+	 * Joins the workers that exited and forgets them, so that the threads started over a session
+	 * do not pile up. The mutex must be held.
+	 */
+	void joinFinishedWorkers();
+
+	// Data members.
+	/** Asset pack to load the cooked textures from, or nullptr. */
+	const AssetPack              *mPack;
+	/** Upload service copying the textures' data, or nullptr. */
+	UploadService                *mUploads;
+	/** True if the GPU supports S3TC compressed textures. */
+	bool                         mCompressionSupported;
+	/** Largest number of workers running at once. */
+	unsigned int                 mMaxWorkers;
+	/** Guards the jobs, the queue and the workers. */
+	std::mutex                   mMutex;
+	/** Notified whenever a texture is decoded. */
+	std::condition_variable      mDecoded;
+	/** Jobs of the textures requested and not yet uploaded, by path. */
+	std::map<std::string, Job>   mJobs;
+	/** Jobs left to decode, in request order. */
+	std::deque<Job *>            mQueue;
+	/** Number of workers running. */
+	unsigned int                 mActiveWorkers;
+	/** Worker threads started and not joined yet, running or not. */
+	std::vector<std::thread>     mWorkers;
+	/** IDs of the workers that exited and are not joined yet. */
+	std::vector<std::thread::id> mFinishedWorkers;
+};
+
+#endif
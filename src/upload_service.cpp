@@ -0,0 +1,251 @@
+/**
+ * @file upload_service.cpp
+ *
+ * Implementation file for the UploadService class.
+ */
+#include "upload_service.hpp"
+
+#include "gl_calls.hpp"
+#include "core/profiler.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+// Redeclare constant static data members.
+constexpr GLsizeiptr UploadService::RING_SIZE;
+constexpr GLsizeiptr UploadService::FRAME_BUDGET;
+
+namespace {
+/** Alignment of the data staged in the ring, in bytes. */
+constexpr GLintptr STAGING_ALIGNMENT = 16;
+/** Nanoseconds to wait for a fence before checking it again. */
+constexpr GLuint64 FENCE_TIMEOUT     = 1000000;
+
+/**
+ * Returns the target a texture is bound to from the target of one of its levels or faces.
+ */
+GLenum bindingTarget(GLenum target) {
+	if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X and target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) {
+		return GL_TEXTURE_CUBE_MAP;
+	}
+	return target;
+}
+}
+
+// Constructors.
+UploadService::UploadService() :
+		mMapped(nullptr),
+		mHead(0),
+		mUsed(0) {
+	if (GLEW_VERSION_4_4 or GLEW_ARB_buffer_storage) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		mRing = GlBuffer::generate();
+		glBindBuffer(GL_COPY_READ_BUFFER, mRing.id());
+		glBufferStorage(GL_COPY_READ_BUFFER, RING_SIZE, nullptr, flags);
+		mMapped = static_cast<char *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, RING_SIZE, flags));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	}
+}
+
+// Destructors.
+UploadService::~UploadService() {
+	for (Batch& batch : mBatches) {
+		glDeleteSync(batch.fence);
+	}
+	if (mRing) {
+		glBindBuffer(GL_COPY_READ_BUFFER, mRing.id());
+		glUnmapBuffer(GL_COPY_READ_BUFFER);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	}
+}
+
+// Mutator functions.
+void UploadService::allocateBuffer(GLuint buffer, GLsizeiptr size, GLenum usage) {
+	Request request = { ALLOCATE_BUFFER, buffer, 0, usage, TextureRegion(), nullptr, size,
+	                    Callback() };
+	mQueue.push(std::move(request));
+}
+
+void UploadService::uploadBuffer(GLuint buffer, GLintptr offset, const void *data, GLsizeiptr size,
+                                 Callback done) {
+	Request request = { BUFFER, buffer, offset, 0, TextureRegion(), data, size, std::move(done) };
+	mQueue.push(std::move(request));
+}
+
+void UploadService::uploadTexture(const TextureRegion& region, const void *data, GLsizeiptr size,
+                                  Callback done) {
+	Request request = { TEXTURE, 0, 0, 0, region, data, size, std::move(done) };
+	mQueue.push(std::move(request));
+}
+
+// OpenGL modifier functions.
+void UploadService::process() {
+	PROFILE_SCOPE("UploadService::process");
+
+	retire(false);
+	mQueue.popAll(mPending);
+	schedule(FRAME_BUDGET);
+}
+
+void UploadService::finish() {
+	PROFILE_SCOPE("UploadService::finish");
+
+	// Callbacks may request more uploads, so take them from the queue until none is left.
+	mQueue.popAll(mPending);
+	while (not mPending.empty() or not mBatches.empty()) {
+		schedule(RING_SIZE);
+		retire(true);
+		mQueue.popAll(mPending);
+	}
+}
+
+// Helper functions.
+void UploadService::schedule(GLsizeiptr budget) {
+	Batch                 batch = { nullptr, 0, std::vector<Callback>() };
+	std::vector<Callback> completed;
+	GLsizeiptr            nBytes = 0;
+
+	// The staged data is read from the ring, as a buffer and as pixels. Texture rows are tightly
+	// packed.
+	glBindBuffer(GL_COPY_READ_BUFFER, mRing.id());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	while (not mPending.empty()) {
+		Request& request = mPending.front();
+		if (request.kind == ALLOCATE_BUFFER) {
+			glBindBuffer(GL_COPY_WRITE_BUFFER, request.buffer);
+			glBufferData(GL_COPY_WRITE_BUFFER, request.size, nullptr, request.usage);
+			mPending.pop_front();
+			continue;
+		}
+
+		// Leave the rest for later once over budget or out of ring space, keeping the order.
+		if (nBytes > 0 and nBytes + request.size > budget) {
+			break;
+		}
+
+		// Uploads wait for ring space while batches are in flight; one that does not fit even in the
+		// drained ring is uploaded straight from CPU memory instead.
+		GLintptr offset = 0;
+		bool     staged = mMapped != nullptr and request.size <= RING_SIZE;
+		if (staged and not reserve(request.size, offset, batch)) {
+			if (mUsed > 0) {
+				break;
+			}
+			staged = false;
+		}
+		if (staged) {
+			std::memcpy(mMapped + offset, request.data, static_cast<std::size_t>(request.size));
+			copy(request, true, offset);
+			batch.callbacks.push_back(std::move(request.done));
+		}
+		else {
+			copy(request, false, 0);
+			completed.push_back(std::move(request.done));
+		}
+		nBytes += request.size;
+		mPending.pop_front();
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// Fence the copies from the ring. The copies from CPU memory are done once issued.
+	if (batch.bytes > 0) {
+		batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		mBatches.push_back(std::move(batch));
+	}
+	for (Callback& done : completed) {
+		if (done) {
+			done();
+		}
+	}
+}
+
+void UploadService::retire(bool wait) {
+	while (not mBatches.empty()) {
+		Batch& batch  = mBatches.front();
+		GLenum status = glClientWaitSync(batch.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+		                                 wait ? FENCE_TIMEOUT : 0);
+		if (status == GL_TIMEOUT_EXPIRED) {
+			if (wait) {
+				continue;
+			}
+			break;
+		}
+		if (status == GL_WAIT_FAILED) {
+			// The fence can't tell whether the GPU still reads the batch's part of the ring, so wait
+			// for all commands to complete before freeing it.
+			glFinish();
+		}
+
+		// Free the batch's part of the ring before running its callbacks, which may request more
+		// uploads.
+		glDeleteSync(batch.fence);
+		mUsed -= batch.bytes;
+		std::vector<Callback> callbacks = std::move(batch.callbacks);
+		mBatches.pop_front();
+
+		// Rewind the drained ring, so that the next uploads get all of it without wrapping.
+		if (mBatches.empty()) {
+			mHead = 0;
+		}
+		wait = false;
+		for (Callback& done : callbacks) {
+			if (done) {
+				done();
+			}
+		}
+	}
+}
+
+bool UploadService::reserve(GLsizeiptr size, GLintptr& offset, Batch& batch) {
+	// The free space runs from the head to the oldest batch in flight, wrapping around the end of
+	// the ring. Space skipped to align or to wrap is used by the batch until it completes.
+	GLintptr   start   = (mHead + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+	GLsizeiptr padding = start - mHead;
+	if (start + size > RING_SIZE) {
+		start   = 0;
+		padding = RING_SIZE - mHead;
+	}
+	if (mUsed + padding + size > RING_SIZE) {
+		return false;
+	}
+	mUsed       += padding + size;
+	batch.bytes += padding + size;
+	mHead        = start + size;
+	offset       = start;
+	return true;
+}
+
+void UploadService::copy(const Request& request, bool staged, GLintptr stagingOffset) const {
+	renderStats::current().bytesUploaded += static_cast<std::uint64_t>(request.size);
+	if (request.kind == BUFFER) {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, request.buffer);
+		if (staged) {
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagingOffset,
+			                    request.offset, request.size);
+		}
+		else {
+			glBufferSubData(GL_COPY_WRITE_BUFFER, request.offset, request.size, request.data);
+		}
+		return;
+	}
+
+	// Staged pixels are read from the ring bound as the pixel unpack buffer, at their offset.
+	const TextureRegion& region = request.region;
+	const void           *pixels = staged ? reinterpret_cast<const void *>(stagingOffset) :
+	                               request.data;
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staged ? mRing.id() : 0);
+	gl::bindTexture(bindingTarget(region.target), region.texture);
+	if (region.type == 0) {
+		glCompressedTexSubImage2D(region.target, region.level, 0, 0, region.width, region.height,
+		                          region.format, static_cast<GLsizei>(request.size), pixels);
+	}
+	else {
+		glTexSubImage2D(region.target, region.level, 0, 0, region.width, region.height,
+		                region.format, region.type, pixels);
+	}
+	gl::bindTexture(bindingTarget(region.target), 0);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file upload_service.hpp
+ *
+ * Interface file for the UploadService class.
+ */
+#ifndef SPACE_COWBOY_UPLOAD_SERVICE_HPP
+#define SPACE_COWBOY_UPLOAD_SERVICE_HPP
+
+#include "core/mpsc_queue.hpp"
+#include "gl_object.hpp"
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include <GL/glew.h>
+
+/**
+ * Uploads buffer and texture data to the GPU without stalling the frame. Uploads are requested
+ * from any thread through a lock-free queue and carried out on the OpenGL thread by process(), once
+ * per frame, up to FRAME_BUDGET bytes. When buffer storage is supported (OpenGL 4.4 or
+ * ARB_buffer_storage) the data is copied into a persistently mapped staging ring buffer, and the
+ * GPU copies it from there into its destination; each frame's copies are fenced, and their part of
+ * the ring is reused and their completion callbacks run once the GPU has passed the fence. Uploads
+ * that do not fit in the ring's free space wait for a later frame rather than for the GPU.
+ * The ring is rewound to its start whenever it drains. Otherwise, and for uploads that do not fit
+ * even in the drained ring, the data is uploaded straight from CPU memory.
+ *
+ * Destinations are written in request order, so a buffer may be reallocated and filled again while
+ * earlier uploads into it are still queued. An UploadService should only be constructed after
+ * OpenGL has initialized.
+ */
+class UploadService {
+public:
+	/** Function called on the OpenGL thread once an upload has reached its destination. */
+	typedef std::function<void()> Callback;
+
+	/** Level of a texture, or of one face of a cube map, to upload into. */
+	struct TextureRegion {
+		/** Reference ID of the texture. */
+		GLuint  texture;
+		/** GL_TEXTURE_2D, or the target of the cube map face. */
+		GLenum  target;
+		/** Mip level. */
+		GLint   level;
+		/** Width of the level in pixels. */
+		GLsizei width;
+		/** Height of the level in pixels. */
+		GLsizei height;
+		/** Pixel format of the data, or the internal format of compressed data. */
+		GLenum  format;
+		/** Type of the pixel components, or 0 if the data is compressed. */
+		GLenum  type;
+	};
+
+	// Constants.
+	/** Size of the staging ring buffer in bytes. */
+	static constexpr GLsizeiptr RING_SIZE    = 16 << 20;
+	/** Number of bytes process() uploads at most per frame, unless a single upload is larger. */
+	static constexpr GLsizeiptr FRAME_BUDGET = 4 << 20;
+
+	// Constructors.
+	/**
+	 * Creates the staging ring buffer, if buffer storage is supported.
+	 */
+	UploadService();
+
+	/**
+	 * Copy constructor is disabled as OpenGL does not permit the shallow copying of buffer objects.
+	 */
+	UploadService(const UploadService&) = delete;
+
+	/**
+	 * Copy assignment operator is disabled as OpenGL does not permit the shallow copying of buffer
+	 * objects.
+	 */
+	void operator=(const UploadService&) = delete;
+
+	// Destructors.
+	/**
+	 * Destroys the staging ring buffer and its fences. Uploads not yet completed are dropped
+	 * without running their callbacks.
+	 */
+	~UploadService();
+
+	// Mutator functions.
+	/**
+	 * Requests (re)allocating the storage of a buffer, discarding its contents. Safe to call from
+	 * any thread.
+	 *
+	 * @param buffer Reference ID of the buffer.
+	 * @param size Size of the storage in bytes.
+	 * @param usage Usage hint of the storage.
+	 */
+	void allocateBuffer(GLuint buffer, GLsizeiptr size, GLenum usage);
+
+	/**
+	 * Requests uploading data into a buffer. Safe to call from any thread.
+	 *
+	 * @param buffer Reference ID of the buffer, allocated by the time the upload is carried out.
+	 * @param offset Offset of the data in the buffer.
+	 * @param data Data to upload, which must stay valid until the callback is called.
+	 * @param size Size of the data in bytes.
+	 * @param done Function called once the data is in the buffer, if any.
+	 */
+	void uploadBuffer(GLuint buffer, GLintptr offset, const void *data, GLsizeiptr size,
+	                  Callback done = Callback());
+
+	/**
+	 * Requests uploading tightly packed data into a level of a texture. Safe to call from any
+	 * thread.
+	 *
+	 * @param region Level to upload into, allocated by the time the upload is carried out.
+	 * @param data Data to upload, which must stay valid until the callback is called.
+	 * @param size Size of the data in bytes.
+	 * @param done Function called once the data is in the texture, if any.
+	 */
+	void uploadTexture(const TextureRegion& region, const void *data, GLsizeiptr size,
+	                   Callback done = Callback());
+
+	// OpenGL modifier functions.
+	/**
+	 * Runs the callbacks of the uploads the GPU has completed, then carries out the uploads
+	 * requested since, up to the frame budget and the ring's free space. Never waits for the GPU.
+	 * Should be called once per frame, before drawing.
+	 */
+	void process();
+
+	/**
+	 * Carries out every upload requested so far and waits for the GPU to complete them, running
+	 * their callbacks. Meant for loading, before the first frame.
+	 */
+	void finish();
+
+private:
+	/** Kinds of requests. */
+	enum Kind {
+		ALLOCATE_BUFFER,
+		BUFFER,
+		TEXTURE
+	};
+
+	/** Requested upload. */
+	struct Request {
+		/** Kind of request. */
+		Kind          kind;
+		/** Reference ID of the destination buffer. */
+		GLuint        buffer;
+		/** Offset of the data in the destination buffer. */
+		GLintptr      offset;
+		/** Usage hint of an allocation. */
+		GLenum        usage;
+		/** Destination texture level. */
+		TextureRegion region;
+		/** Data to upload. */
+		const void    *data;
+		/** Size of the data, or of the allocation, in bytes. */
+		GLsizeiptr    size;
+		/** Function called once done. */
+		Callback      done;
+	};
+
+	/** Uploads copied from one part of the ring, fenced together. */
+	struct Batch {
+		/** Fence after the copies. */
+		GLsync                fence;
+		/** Bytes of the ring used, including alignment and wrapping padding. */
+		GLsizeiptr            bytes;
+		/** Callbacks of the uploads. */
+		std::vector<Callback> callbacks;
+	};
+
+	// Helper functions.
+	/**
+	 * Carries out the requested uploads, in order, up to a number of bytes and the ring's free
+	 * space.
+	 *
+	 * @param budget Largest number of bytes to upload, unless a single upload is larger.
+	 */
+	void schedule(GLsizeiptr budget);
+
+	/**
+	 * Retires the batches the GPU has completed, running their callbacks.
+	 *
+	 * @param wait True to wait for the oldest batch to complete.
+	 */
+	void retire(bool wait);
+
+	/**
+	 * Reserves space in the ring, wrapping around to its start if needed.
+	 *
+	 * @param size Size to reserve in bytes.
+	 * @param offset Offset of the reserved space.
+	 * @param batch Batch the space is used by.
+	 * @return False if the ring does not have enough free space.
+	 */
+	bool reserve(GLsizeiptr size, GLintptr& offset, Batch& batch);
+
+	/**
+	 * Copies an upload's data into its destination, from the ring or straight from CPU memory.
+	 *
+	 * @param request Upload to carry out.
+	 * @param staged True if the data is staged in the ring.
+	 * @param stagingOffset Offset of the data in the ring, if staged.
+	 */
+	void copy(const Request& request, bool staged, GLintptr stagingOffset) const;
+
+	// Data members.
+	/** Uploads requested from any thread. */
+	MpscQueue<Request>  mQueue;
+	/** Uploads taken from the queue and not carried out yet, in request order. */
+	std::deque<Request> mPending;
+	/** Batches the GPU may not have completed, oldest first. */
+	std::deque<Batch>   mBatches;
+
+	/** Staging ring buffer, or empty if buffer storage is not supported. */
+	GlBuffer   mRing;
+	/** Persistently mapped contents of the ring, or null if buffer storage is not supported. */
+	char       *mMapped;
+	/** Offset the next reservation starts from. */
+	GLintptr   mHead;
+	/** Bytes of the ring used by the batches in flight. */
+	GLsizeiptr mUsed;
+};
+
+#endif
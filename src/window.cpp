@@ -20,7 +20,7 @@ float Window::sOldMousePitch = 0.0f;
 float  Window::sMouseYaw        = -90.0f;
 float  Window::sMousePitch      = 0.0f;
 
-bool    Window::keysPressed[1024];
+bool    Window::keysPressed[InputRecorder::N_KEY_CODES];
 GLfloat Window::currentVelocity = 0.0f;
 bool    Window::firstMouse      = true;
 glm::vec3 Window::oldCameraFront = { 0.0f, 0.0f, 0.0f };
@@ -29,6 +29,10 @@ bool Window::collision = false;
 
 glm::vec3 Window::bounce = glm::vec3(0.0f);
 
+bool Window::sOverlayVisible = false;
+
+InputRecorder *Window::sPInputRecorder = nullptr;
+
 // Constructors.
 Window::Window() :
 		mWindow(nullptr) { }
@@ -49,10 +53,10 @@ Window::Window(int width, int height, const std::string& title) {
 	glfwSetInputMode(mWindow, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
 	// Set callback functions.
-	glfwSetCursorPosCallback(mWindow, cursorCallback);
-	glfwSetKeyCallback(mWindow, keyCallback);
-	glfwSetScrollCallback(mWindow, scrollCallback);
-	glfwSetMouseButtonCallback(mWindow, mouse_button_callback);
+	glfwSetCursorPosCallback(mWindow, onCursor);
+	glfwSetKeyCallback(mWindow, onKey);
+	glfwSetScrollCallback(mWindow, onScroll);
+	glfwSetMouseButtonCallback(mWindow, onMouseButton);
 
 }
 
@@ -82,7 +86,19 @@ int Window::height() const {
 	return height;
 }
 
+bool Window::overlayVisible() const {
+	return sOverlayVisible;
+}
+
 // Mutator functions.
+void Window::setTitle(const std::string& title) {
+	glfwSetWindowTitle(mWindow, title.c_str());
+}
+
+void Window::setInputRecorder(InputRecorder *pRecorder) {
+	sPInputRecorder = pRecorder;
+}
+
 void Window::setCamera(Camera *pCamera) {
 	sPCamera = pCamera;
 	sPInitialCamera = *sPCamera;
@@ -111,6 +127,27 @@ void Window::pollEvents() const {
 	glfwPollEvents();
 }
 
+void Window::replayEvents(const std::vector<InputRecorder::Event>& events) const {
+	for (const InputRecorder::Event& event : events) {
+		switch (event.type) {
+			case InputRecorder::KEY:
+				keyCallback(mWindow, event.code, 0, event.action, event.mods);
+				break;
+			case InputRecorder::CURSOR:
+				cursorCallback(mWindow, event.x, event.y);
+				break;
+			case InputRecorder::MOUSE_BUTTON:
+				mouse_button_callback(mWindow, event.code, event.action, event.mods);
+				break;
+			case InputRecorder::SCROLL:
+				scrollCallback(mWindow, event.x, event.y);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
 void Window::setBgColour(GLfloat r, GLfloat g, GLfloat b, GLfloat a) const {
 	glClearColor(r, g, b, a);
 }
@@ -198,11 +235,14 @@ void Window::cursorCallback(GLFWwindow *, double xpos, double ypos) {
 
 
 void Window::keyCallback(GLFWwindow *window, int key, int, int action, int) {
-	if (action == GLFW_PRESS) {
-		keysPressed[key] = true;
-	}
-	if (action == GLFW_RELEASE) {
-		keysPressed[key] = false;
+	// Unknown keys have a negative code and are not tracked.
+	if (key >= 0 and key < InputRecorder::N_KEY_CODES) {
+		if (action == GLFW_PRESS) {
+			keysPressed[key] = true;
+		}
+		if (action == GLFW_RELEASE) {
+			keysPressed[key] = false;
+		}
 	}
 
 	// If ESC is pressed, close window.
@@ -250,6 +290,18 @@ void Window::keyCallback(GLFWwindow *window, int key, int, int action, int) {
 	moveCamera();
 }
 
+void Window::debugKeyCallback(int key, int action) {
+	// If F3 is pressed, toggle the performance overlay.
+	if (key == GLFW_KEY_F3 and action == GLFW_PRESS) {
+		sOverlayVisible = not sOverlayVisible;
+	}
+
+	// If F9 is pressed, capture a CPU profile of the next frames.
+	if (key == GLFW_KEY_F9 and action == GLFW_PRESS) {
+		PROFILE_CAPTURE(profiler::DEFAULT_CAPTURE_FRAMES, profiler::DEFAULT_TRACE_PATH);
+	}
+}
+
 void Window::scrollCallback(GLFWwindow *, double, double) {
 	// Nothing for now. May add a FOV changer
 }
@@ -277,7 +329,7 @@ void Window::mouse_button_callback(GLFWwindow *window, int button, int action, i
 }
 
 void Window::updateDeltaTime() {
-	GLfloat currentFrame = static_cast<float> (glfwGetTime());
+	GLfloat currentFrame = static_cast<float> (simClock::now());
 	deltaTime = currentFrame - lastFrame;
 	lastFrame = currentFrame;
 }
@@ -358,3 +410,56 @@ void Window::moveCamera() {
 	}
 }
 
+void Window::onCursor(GLFWwindow *window, double xpos, double ypos) {
+	if (sPInputRecorder) {
+		if (sPInputRecorder->replaying()) {
+			return;
+		}
+		sPInputRecorder->record({ InputRecorder::CURSOR, 0, 0, 0, xpos, ypos });
+	}
+	cursorCallback(window, xpos, ypos);
+}
+
+void Window::onKey(GLFWwindow *window, int key, int scancode, int action, int mods) {
+	// The overlay and profiler keys do not affect the simulation, so they are handled live and
+	// never recorded, even while a recording is replayed.
+	if (key == GLFW_KEY_F3 or key == GLFW_KEY_F9) {
+		debugKeyCallback(key, action);
+		return;
+	}
+	if (sPInputRecorder) {
+		if (sPInputRecorder->replaying()) {
+			// Still allow the replay to be stopped.
+			if (key == GLFW_KEY_ESCAPE) {
+				glfwSetWindowShouldClose(window, GL_TRUE);
+			}
+			return;
+		}
+		// Keys without a code do nothing, so they are left out of the recording, which only
+		// holds valid key codes.
+		if (key >= 0 and key < InputRecorder::N_KEY_CODES) {
+			sPInputRecorder->record({ InputRecorder::KEY, key, action, mods, 0.0, 0.0 });
+		}
+	}
+	keyCallback(window, key, scancode, action, mods);
+}
+
+void Window::onScroll(GLFWwindow *window, double xoffset, double yoffset) {
+	if (sPInputRecorder) {
+		if (sPInputRecorder->replaying()) {
+			return;
+		}
+		sPInputRecorder->record({ InputRecorder::SCROLL, 0, 0, 0, xoffset, yoffset });
+	}
+	scrollCallback(window, xoffset, yoffset);
+}
+
+void Window::onMouseButton(GLFWwindow *window, int button, int action, int mods) {
+	if (sPInputRecorder) {
+		if (sPInputRecorder->replaying()) {
+			return;
+		}
+		sPInputRecorder->record({ InputRecorder::MOUSE_BUTTON, button, action, mods, 0.0, 0.0 });
+	}
+	mouse_button_callback(window, button, action, mods);
+}
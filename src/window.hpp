@@ -6,11 +6,15 @@
 #ifndef SPACE_COWBOY_WINDOW_HPP
 #define SPACE_COWBOY_WINDOW_HPP
 
-#include "camera.hpp"
+#include "core/camera.hpp"
+#include "core/input_recorder.hpp"
+#include "core/profiler.hpp"
+#include "core/sim_clock.hpp"
 
 #include <array>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
@@ -75,6 +79,11 @@ public:
 	*/
 	int height() const;
 
+	/**
+	* Returns true iff the performance overlay should be shown. Toggled with F3.
+	*/
+	bool overlayVisible() const;
+
 	// Mutator functions.
 	/**
 	* Sets the camera that the window will control.
@@ -83,6 +92,22 @@ public:
 	*/
 	void setCamera(Camera *pCamera);
 
+	/**
+	* Sets the title of the window.
+	*
+	* @param title New title of the window.
+	*/
+	void setTitle(const std::string& title);
+
+	/**
+	* Sets the input recorder. Live input is recorded when it is recording and ignored, apart from
+	* ESC, when it is replaying. The overlay and profiler keys, F3 and F9, are never recorded and
+	* always handled live.
+	*
+	* @param pRecorder Pointer to the input recorder, or nullptr.
+	*/
+	void setInputRecorder(InputRecorder *pRecorder);
+
 	// OpenGL modifier functions.
 	/**
 	* Clears the screen, replacing the pixels with the window background colour.
@@ -111,6 +136,13 @@ public:
 	*/
 	void pollEvents() const;
 
+	/**
+	* Handles recorded input events as if they had just been polled.
+	*
+	* @param events Input events to handle, in order.
+	*/
+	void replayEvents(const std::vector<InputRecorder::Event>& events) const;
+
 	/**
 	* Sets the window background colour in RGBA colour space.
 	*
@@ -190,9 +222,8 @@ private:
 	/** y coordinate of last cursor. */
 	static float sLastCursorYPos;
 
-	/** Array that keeps track of which keys are pressed*/
-	static bool      keysPressed[1024];  // No need to initialize since static bool arrays are
-										 // false by default.
+	/** Array that keeps track of which keys are pressed, false by default as it is static. */
+	static bool      keysPressed[InputRecorder::N_KEY_CODES];
 					
 	static float	sOldMouseYaw;
 
@@ -216,6 +247,12 @@ private:
 
 	static glm::vec3 bounce;
 
+	/** True iff the performance overlay is shown. */
+	static bool sOverlayVisible;
+
+	/** Pointer to the input recorder, or nullptr if input is neither recorded nor replayed. */
+	static InputRecorder *sPInputRecorder;
+
 	// Callback constants.
 	/** Size of points when rendering points. */
 	static constexpr float POINT_SIZE = 3.0f;
@@ -265,6 +302,18 @@ private:
 	*/
 	static void keyCallback(GLFWwindow *window, int key, int, int action, int);
 
+	/**
+	* Called when a debug key is pressed or released. Touches no simulation state, so that debug
+	* keys need not be recorded.
+	*
+	* If F3 is pressed, the performance overlay is toggled. If F9 is pressed, a CPU profile of the
+	* next frames is captured.
+	*
+	* @param key Key that was pressed or released.
+	* @param action Action on key that was performed.
+	*/
+	static void debugKeyCallback(int key, int action);
+
 	/**
 	* Called when user scrolls with either a mouse wheel or touchpad gesture.
 	*
@@ -275,6 +324,20 @@ private:
 	static void scrollCallback(GLFWwindow *, double, double);
 
 	static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+
+	// GLFW callbacks. These pass live input to the recorder before handling it with the callbacks
+	// above, or drop it while a recording is replayed.
+	/** Called by GLFW when the cursor moves. */
+	static void onCursor(GLFWwindow *window, double xpos, double ypos);
+
+	/** Called by GLFW when a key is pressed or released. */
+	static void onKey(GLFWwindow *window, int key, int scancode, int action, int mods);
+
+	/** Called by GLFW when the user scrolls. */
+	static void onScroll(GLFWwindow *window, double xoffset, double yoffset);
+
+	/** Called by GLFW when a mouse button is pressed or released. */
+	static void onMouseButton(GLFWwindow *window, int button, int action, int mods);
 };
 
 #endif
@@ -0,0 +1,210 @@
+/**
+ * @file sc_cook.cpp
+ *
+ * Contains the entry point of the asset cooker, which cooks the models and textures the game loads
+ * into an asset pack. The game then loads the cooked assets instead of parsing OBJ files and
+ * decoding images on every launch. Only sources that changed since the last run are cooked again.
+ * Must be run from the project root so that the sources are found.
+ */
+#include "core/asset_cook.hpp"
+#include "core/asset_pack.hpp"
+#include "core/image.hpp"
+#include "core/mesh_optimize.hpp"
+#include "core/objloader.hpp"
+#include "core/utility.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <SOIL/SOIL.h>
+
+namespace {
+/** Models the game loads, named by the paths of their OBJ files. */
+const std::vector<std::string> MODELS = { "assets/dark_fighter_6/dark_fighter_6.obj",
+                                          "assets/Deadpool/DeadPool.obj" };
+
+/** Textures the game loads, named by the paths of their image files. */
+const std::vector<std::string> TEXTURES = { "textures/sun/Textures/Agni-Baume-land.jpg",
+                                            "assets/purplenebula_rt.png",
+                                            "assets/purplenebula_lf.png",
+                                            "assets/purplenebula_up.png",
+                                            "assets/purplenebula_dn.png",
+                                            "assets/purplenebula_bk.png",
+                                            "assets/purplenebula_ft.png",
+                                            "assets/dark_fighter_6/dark_fighter_6_color.png",
+                                            "assets/Deadpool/deadpool_tex01_bm.png" };
+
+/** Size of the vertex cache the average cache miss ratio of cooked models is reported for. */
+constexpr std::size_t REPORTED_CACHE_SIZE = 16;
+
+/**
+ * Hashes a source file together with the settings it is cooked with.
+ *
+ * @throws std::runtime_error if the file cannot be read.
+ */
+std::uint64_t sourceHash(const std::string& path, AssetPack::Type type, std::uint32_t setting) {
+	utility::MappedFile file(path);
+	return assetCook::sourceHash(file.data(), file.size(), type, setting);
+}
+
+/**
+ * Cooks a model from its OBJ file and reports it.
+ *
+ * @throws std::runtime_error if the model cannot be loaded.
+ */
+std::vector<std::uint8_t> cookModel(const std::string& path) {
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> UVs;
+	if (not loadOBJ(path.c_str(), vertices, normals, UVs) or vertices.empty()) {
+		throw std::runtime_error("Model " + path + " cannot be loaded.");
+	}
+
+	assetCook::CookedModel model = assetCook::cookModel(vertices, normals, UVs,
+	                                                    assetCook::MODEL_LEVELS);
+	std::vector<std::uint32_t> fullDetail(model.indices.begin(),
+	                                      model.indices.begin() + model.levelCounts.front());
+	std::cout << "Cooked " << path << ": " << model.vertices.size() << " vertices, "
+	          << model.levelCounts.front() / 3 << " triangles in " << model.levelCounts.size()
+	          << " levels, ACMR " << averageCacheMissRatio(fullDetail, REPORTED_CACHE_SIZE)
+	          << std::endl;
+	return assetCook::serialize(model);
+}
+
+/**
+ * Cooks a texture from its image file and reports it.
+ *
+ * @throws std::runtime_error if the image cannot be loaded.
+ */
+std::vector<std::uint8_t> cookTexture(const std::string& path, bool compress) {
+	utility::MappedFile file(path);
+	int                 width, height;
+	unsigned char       *pixels = SOIL_load_image_from_memory(
+			reinterpret_cast<const unsigned char *>(file.data()), static_cast<int>(file.size()),
+			&width, &height, nullptr, SOIL_LOAD_RGB);
+	if (pixels == nullptr) {
+		throw std::runtime_error("Failed to locate image " + path + ".");
+	}
+	image::Image source;
+	source.width    = static_cast<std::uint32_t>(width);
+	source.height   = static_cast<std::uint32_t>(height);
+	source.channels = 3;
+	source.pixels.assign(pixels, pixels + 3 * source.width * source.height);
+	SOIL_free_image_data(pixels);
+
+	assetCook::CookedTexture texture = assetCook::cookTexture(source, compress);
+	std::cout << "Cooked " << path << ": " << width << "x" << height << ", "
+	          << texture.levels.size() << " levels, " << (compress ? "BC1" : "RGB8") << std::endl;
+	return assetCook::serialize(texture);
+}
+
+/**
+ * Cooks an asset into an item of the pack, or reuses the item of the previous pack if its source
+ * and settings did not change.
+ *
+ * @return True if the asset was cooked.
+ */
+template <typename Cook>
+bool cookItem(const std::string& path, AssetPack::Type type, std::uint32_t setting,
+              const AssetPack *previousPack, std::vector<AssetPack::Item>& items, Cook cook) {
+	AssetPack::Item item;
+	item.name       = path;
+	item.type       = type;
+	item.sourceHash = sourceHash(path, type, setting);
+
+	const AssetPack::Entry *entry = previousPack == nullptr ? nullptr :
+	                                previousPack->find(path, type);
+	if (entry != nullptr and entry->sourceHash == item.sourceHash) {
+		try {
+			const std::uint8_t *payload = previousPack->payload(*entry);
+			item.payload.assign(payload, payload + entry->size);
+			items.push_back(std::move(item));
+			return false;
+		}
+		catch (const std::runtime_error& error) {
+			std::cerr << "Warning: " << error.what() << " Cooking it again." << std::endl;
+		}
+	}
+	item.payload = cook();
+	items.push_back(std::move(item));
+	return true;
+}
+}
+
+/**
+ * Entry point of the asset cooker.
+ *
+ * Supported command line options:
+ *   --output F           Write the asset pack to F instead of the default pack path.
+ *   --force              Cook every asset, even if its source did not change.
+ *   --uncompressed       Cook textures as RGB8 instead of BC1, for drivers without S3TC support.
+ */
+int main(int argc, char *argv[]) {
+	std::string outputPath = AssetPack::DEFAULT_PATH;
+	bool        force      = false;
+	bool        compress   = true;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--output") == 0 and i + 1 < argc) {
+			outputPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--force") == 0) {
+			force = true;
+		}
+		else if (std::strcmp(argv[i], "--uncompressed") == 0) {
+			compress = false;
+		}
+		else {
+			std::cerr << "Warning: Ignoring unknown option " << argv[i] << "." << std::endl;
+		}
+	}
+
+	try {
+		// Open the previous pack to reuse its assets whose sources did not change.
+		std::unique_ptr<AssetPack> previousPack;
+		if (not force and std::ifstream(outputPath)) {
+			try {
+				previousPack.reset(new AssetPack(outputPath));
+			}
+			catch (const std::runtime_error& error) {
+				std::cerr << "Warning: " << error.what() << " Cooking every asset." << std::endl;
+			}
+		}
+
+		std::vector<AssetPack::Item> items;
+		std::size_t                  nCooked = 0;
+		for (const std::string& path : MODELS) {
+			nCooked += cookItem(path, AssetPack::MODEL, 0, previousPack.get(), items,
+			                    [&path] { return cookModel(path); });
+		}
+		for (const std::string& path : TEXTURES) {
+			nCooked += cookItem(path, AssetPack::TEXTURE, compress, previousPack.get(), items,
+			                    [&path, compress] { return cookTexture(path, compress); });
+		}
+
+		// Leave the pack as it is if nothing changed, and close it before replacing it otherwise.
+		if (previousPack and nCooked == 0 and previousPack->entries().size() == items.size()) {
+			std::cout << outputPath << " is up to date." << std::endl;
+			return 0;
+		}
+		previousPack.reset();
+		AssetPack::write(outputPath, items);
+
+		std::size_t packBytes = 0;
+		for (const AssetPack::Item& item : items) {
+			packBytes += item.payload.size();
+		}
+		std::cout << "Wrote " << outputPath << ": " << items.size() << " assets, " << nCooked
+		          << " cooked, " << packBytes / 1024 << " KiB" << std::endl;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+}